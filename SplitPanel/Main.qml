@@ -12,9 +12,15 @@ import SplitPanel 1.0
 //   应用程序的顶层容器，管理应用生命周期和布局持久化
 // 
 // 核心机制：
-//   1. 启动时：自动从layout.json加载上次保存的布局
+//   1. 启动时：自动从layout.json异步加载上次保存的布局
 //   2. 运行中：提供工具栏按钮操作布局（添加/保存/加载/重置）
-//   3. 退出时：自动保存当前布局到layout.json
+//   3. 退出时：自动异步保存当前布局到layout.json（不阻塞窗口关闭）
+//   4. 分离窗口：每个 splitManager.windowIds 对应一个 Window，各自在独立的渲染线程中绘制，
+//      所有窗口共用 sharedViewPool，面板在窗口间移动时内容保持不变
+//
+// 说明：
+//   文件读写和JSON编解码都在工作线程进行，结果通过
+//   layoutSaved / layoutLoaded 信号返回
 // 
 // 组成：
 //   - SplitManager：数据层，管理所有面板和布局
@@ -34,6 +40,9 @@ Window {
     property var statusTextRef: null
     property var statusTimerRef: null
     
+    // 启动时的异步加载是否尚未完成（完成后才决定是否创建默认布局）
+    property bool startupLoadPending: true
+    
     // ========================================================================
     // 辅助函数：布局管理
     // ========================================================================
@@ -43,9 +52,12 @@ Window {
         splitManager.addPanel(
             "welcome_panel",
             "欢迎面板",
-            "SplitPanelContent.qml"
+            "content"
         )
         
+        // 默认布局不是用户操作，不进入撤销历史
+        splitManager.clearHistory()
+        
         Logger.info("Main", "Initial layout created", {
             "panelCount": splitManager.panelCount
         })
@@ -57,12 +69,12 @@ Window {
     
     // 处理添加面板请求
     function handleAddPanel() {
-        var panelId = "panel_" + Date.now()  // 生成唯一ID
+        var panelId = splitManager.generatePanelId()  // 生成唯一ID
         
         var success = splitManager.addPanel(
             panelId,
             "新面板",
-            "SplitPanelContent.qml"
+            "content"
         )
         
         if (success) {
@@ -76,12 +88,44 @@ Window {
         }
     }
     
-    // 处理保存布局请求
+    // 处理保存布局请求（结果在 onLayoutSaved 中处理）
     function handleSaveLayout() {
-        var defaultPath = splitManager.getDefaultLayoutPath()
-        if (splitManager.saveLayoutToFile(defaultPath)) {
+        splitManager.saveLayoutToFileAsync(splitManager.getDefaultLayoutPath())
+    }
+    
+    // 处理加载布局请求（结果在 onLayoutLoaded 中处理）
+    function handleLoadLayout() {
+        splitManager.loadLayoutFromFileAsync(splitManager.getDefaultLayoutPath())
+    }
+    
+    // 把当前布局保存为预设（自动命名）
+    function handleSavePreset() {
+        var index = layoutStore.count + 1
+        while (layoutStore.contains("预设 " + index)) {
+            index++
+        }
+        var name = "预设 " + index
+        if (layoutStore.save(name, splitManager)) {
+            showStatus("已保存预设: " + name, true)
+        } else {
+            showStatus("保存预设失败", false)
+        }
+    }
+    
+    // 应用预设（只解码选中的预设）
+    function handleLoadPreset(name) {
+        if (layoutStore.load(name, splitManager)) {
+            showStatus("已应用预设: " + name, true)
+        } else {
+            showStatus("应用预设失败", false)
+        }
+    }
+    
+    // 异步保存完成
+    function handleLayoutSaved(path, success) {
+        if (success) {
             Logger.info("Main", "Layout saved successfully", {
-                "path": defaultPath,
+                "path": path,
                 "panelCount": splitManager.panelCount
             })
             showStatus("布局已保存: " + splitManager.panelCount + " 个面板", true)
@@ -91,12 +135,26 @@ Window {
         }
     }
     
-    // 处理加载布局请求
-    function handleLoadLayout() {
-        var defaultPath = splitManager.getDefaultLayoutPath()
-        if (splitManager.loadLayoutFromFile(defaultPath)) {
+    // 异步加载完成（启动加载失败时创建默认布局）
+    function handleLayoutLoaded(path, success) {
+        if (root.startupLoadPending) {
+            root.startupLoadPending = false
+            // 启动加载完成后才开启自动保存：已加载的布局视为已保存，随后创建的默认布局会被自动写入
+            splitManager.autosaveEnabled = true
+            if (success) {
+                Logger.info("Main", "Layout loaded from JSON file", {
+                    "panelCount": splitManager.panelCount
+                })
+            } else {
+                Logger.info("Main", "No saved layout found, creating default layout", {})
+                root.initializeLayout()
+            }
+            return
+        }
+        
+        if (success) {
             Logger.info("Main", "Layout loaded successfully", {
-                "path": defaultPath,
+                "path": path,
                 "panelCount": splitManager.panelCount
             })
             showStatus("布局已加载: " + splitManager.panelCount + " 个面板", true)
@@ -106,6 +164,41 @@ Window {
         }
     }
     
+    // 处理撤销/重做请求
+    function handleUndo() {
+        if (!splitManager.undo()) {
+            Logger.debug("Main", "Nothing to undo", {})
+        }
+    }
+    
+    function handleRedo() {
+        if (!splitManager.redo()) {
+            Logger.debug("Main", "Nothing to redo", {})
+        }
+    }
+    
+    // 按 windowIds 增删窗口（已有窗口保持不动，不会因其它窗口的增删而重建）
+    function syncDetachedWindows() {
+        var ids = splitManager.windowIds
+        for (var i = detachedWindowModel.count - 1; i >= 0; i--) {
+            if (ids.indexOf(detachedWindowModel.get(i).windowId) < 0) {
+                detachedWindowModel.remove(i)
+            }
+        }
+        for (var j = 0; j < ids.length; j++) {
+            var known = false
+            for (var k = 0; k < detachedWindowModel.count; k++) {
+                if (detachedWindowModel.get(k).windowId === ids[j]) {
+                    known = true
+                    break
+                }
+            }
+            if (!known) {
+                detachedWindowModel.append({ "windowId": ids[j] })
+            }
+        }
+    }
+    
     // 处理重置布局请求
     function handleResetLayout() {
         splitManager.clear()
@@ -139,12 +232,17 @@ Window {
         })
     }
     
-    // 处理窗口关闭（自动保存布局）
+    // 处理窗口关闭（立即写入尚未自动保存的修改，不等防抖）
+    // 异步写入，窗口立即关闭；SplitManager 析构时会等待写入完成
     function handleClosing() {
-        var defaultPath = splitManager.getDefaultLayoutPath()
-        if (splitManager.saveLayoutToFile(defaultPath)) {
-            Logger.info("Main", "Layout auto-saved on exit", {
-                "path": defaultPath
+        // 布局文件只保存主窗口：分离窗口中的面板先停靠回来（窗口随之关闭，应用才能退出）
+        splitManager.closeAllWindows()
+        
+        if (root.startupLoadPending) return  // 启动加载尚未完成，自动保存未开启，不会用空布局覆盖文件
+        
+        if (splitManager.flushAutosave()) {
+            Logger.info("Main", "Layout auto-save on exit scheduled", {
+                "path": splitManager.autosavePath
             })
         }
     }
@@ -162,18 +260,28 @@ Window {
                 "minPanelSize": minPanelSize
             })
             
+            // 面板类型必须在加载布局之前注册（旧布局中的 qmlSource 会归入同路径的类型）
+            registerPanelType("content", "SplitPanelContent.qml", "新面板")
+            
             var jsonPath = getDefaultLayoutPath()
             Logger.info("Main", "Layout path: " + jsonPath, {})
             
-            // 尝试加载保存的布局，失败则创建默认布局
-            if (loadLayoutFromFile(jsonPath)) {
-                Logger.info("Main", "Layout loaded from JSON file", {
-                    "panelCount": panelCount
-                })
-            } else {
-                Logger.info("Main", "No saved layout found, creating default layout", {})
-                root.initializeLayout()
-            }
+            // 异步加载保存的布局，失败则在 onLayoutLoaded 中创建默认布局
+            loadLayoutFromFileAsync(jsonPath)
+        }
+    }
+    
+    // 布局预设库（与布局文件放在同一目录）
+    SplitLayoutStore {
+        id: layoutStore
+        
+        Component.onCompleted: {
+            var layoutPath = splitManager.getDefaultLayoutPath()
+            open(layoutPath.substring(0, layoutPath.lastIndexOf("/") + 1) + "layouts.splstore")
+            Logger.info("Main", "Layout presets opened", {
+                "path": filePath,
+                "count": count
+            })
         }
     }
     
@@ -195,6 +303,45 @@ Window {
                 "totalPanels": splitManager.panelCount
             })
         }
+        
+        function onLayoutSaved(path, success) {
+            root.handleLayoutSaved(path, success)
+        }
+        
+        function onLayoutLoaded(path, success) {
+            root.handleLayoutLoaded(path, success)
+        }
+        
+        // 布局文件读完后只预编译其中用到的内容组件，与节点分片创建同时进行
+        function onLayoutContentSourcesRead(path, qmlSources) {
+            PanelContentCache.preload(qmlSources.map(function(source) {
+                return Qt.resolvedUrl(source)
+            }))
+        }
+        
+        // 延后到事件循环：窗口可能正在自己的 onClosing 中关闭，不能在处理函数内销毁它
+        function onWindowsChanged() {
+            Qt.callLater(root.syncDetachedWindows)
+        }
+    }
+    
+    // ========================================================================
+    // 分离窗口
+    // ========================================================================
+    
+    // 所有窗口共用的面板视图池（视图在窗口间移动时只改变视觉父对象）
+    SplitPanelViewPool {
+        id: sharedViewPool
+        manager: splitManager
+    }
+    
+    ListModel {
+        id: detachedWindowModel
+    }
+    
+    Instantiator {
+        model: detachedWindowModel
+        delegate: DetachedWindow {}
     }
     
     // ========================================================================
@@ -216,6 +363,7 @@ Window {
             Layout.fillWidth: true
             Layout.fillHeight: true
             splitManager: splitManager
+            viewPool: sharedViewPool
         }
     }
     
@@ -226,6 +374,39 @@ Window {
     Component.onCompleted: logWindowCompleted()
     onClosing: handleClosing()
     
+    // 撤销/重做快捷键（Ctrl+Z / Ctrl+Shift+Z 或 Ctrl+Y，随平台而定）
+    Shortcut {
+        sequences: [StandardKey.Undo]
+        onActivated: root.handleUndo()
+    }
+    
+    Shortcut {
+        sequences: [StandardKey.Redo]
+        onActivated: root.handleRedo()
+    }
+    
+    // 分离窗口组件（关闭窗口时面板停靠回主窗口）
+    component DetachedWindow: Window {
+        id: detachedWindow
+        
+        required property string windowId
+        
+        width: 640
+        height: 480
+        visible: true
+        title: "停靠系统演示 - " + windowId
+        color: "#1e1e1e"
+        
+        SplitSystemView {
+            anchors.fill: parent
+            splitManager: splitManager
+            rootNode: splitManager.windowRoots[detachedWindow.windowId] || null
+            viewPool: sharedViewPool
+        }
+        
+        onClosing: splitManager.closeWindow(detachedWindow.windowId)
+    }
+    
     // 工具栏组件
     component Toolbar: Rectangle {
         color: "#2b2b2b"
@@ -271,11 +452,55 @@ Window {
                 onClicked: root.handleLoadLayout()
             }
             
+            Button {
+                id: presetButton
+                text: "预设"
+                onClicked: presetMenu.open()
+                
+                Menu {
+                    id: presetMenu
+                    y: presetButton.height
+                    
+                    MenuItem {
+                        text: "保存当前布局为预设"
+                        onTriggered: root.handleSavePreset()
+                    }
+                    
+                    MenuSeparator {}
+                    
+                    // 菜单项只读取预设索引，选中时才解析布局
+                    Instantiator {
+                        model: layoutStore.names
+                        
+                        delegate: MenuItem {
+                            required property string modelData
+                            text: modelData
+                            onTriggered: root.handleLoadPreset(modelData)
+                        }
+                        
+                        onObjectAdded: (index, object) => presetMenu.insertItem(index + 2, object)
+                        onObjectRemoved: (index, object) => presetMenu.removeItem(object)
+                    }
+                }
+            }
+            
             Button {
                 text: "重置布局"
                 onClicked: root.handleResetLayout()
             }
             
+            Button {
+                text: "撤销"
+                enabled: splitManager.canUndo
+                onClicked: root.handleUndo()
+            }
+            
+            Button {
+                text: "重做"
+                enabled: splitManager.canRedo
+                onClicked: root.handleRedo()
+            }
+            
             // 弹性空间
             Item {
                 Layout.fillWidth: true
@@ -5,27 +5,32 @@ import SplitPanel 1.0
 // ============================================================================
 // SplitContainerView.qml - 容器视图组件
 // ============================================================================
-// 
+//
 // 功能：
-//   渲染分割容器，将两个子节点左右或上下分割显示
-//   处理分割手柄的拖动，实时更新分割比例
+//   渲染分割容器，将 N 个子节点沿同一方向左右或上下排列
+//   处理分割手柄的拖动，更新各子节点的比例
 //   递归渲染子容器，形成树状结构
-// 
+//
 // 核心机制：
 //   1. 根据orientation确定分割方向（横向/纵向）
-//   2. 根据splitRatio分配两个子节点的空间比例
-//   3. 监听用户拖动分割手柄，实时更新splitRatio
-//   4. 使用Loader动态加载子节点，避免递归实例化问题
-// 
+//   2. 子节点的首选尺寸和最小尺寸绑定 C++ 求解的 layoutRect / layoutMinimumSize
+//      （SplitLayoutSolver 按 sizes 分配并满足整棵子树的 minSize，最后一个子节点填充剩余空间）；
+//      尚未求解（视口未上报）时退化为按 sizes 比例计算
+//   3. 监听用户拖动分割手柄：拖动期间只更新预览比例（每帧最多一次），
+//      松开时由 SplitManager 一次性提交 sizes 并发送 layoutChanged
+//      祖先容器拖动时，嵌套容器的尺寸变化同样按实时拖动处理
+//   4. 使用 Repeater + Loader 动态加载子节点，避免递归实例化问题
+//
 // 注意：
 //   orientation映射关系（反直觉但正确）：
 //   - ContainerNode.Horizontal → Qt.Vertical （子节点左右排列，分割线竖着）
 //   - ContainerNode.Vertical → Qt.Horizontal （子节点上下排列，分割线横着）
-// 
+//   子节点数量变化时 Repeater 重建全部 Loader；面板视图由视图池复用，不会重新创建
+//
 // 信号：
 //   addPanel(targetId, direction) - 请求添加面板
 //   removePanel(panelId) - 请求删除面板
-// 
+//
 // ============================================================================
 
 SplitView {
@@ -37,6 +42,11 @@ SplitView {
     
     property var container: null  // 容器节点对象
     property var manager: null    // DockingManager实例
+    property var viewPool: null   // 面板视图池（按nodeId复用面板视图）
+    property bool parentResizing: false  // 祖先容器是否正在拖动分割条
+    
+    // 实时拖动：自身或祖先容器的分割条正在拖动
+    readonly property bool liveResize: root.resizing || root.parentResizing
     
     // ========================================================================
     // 信号定义
@@ -58,208 +68,204 @@ SplitView {
     // 计算SplitView方向（需要反转映射）
     function getOrientation() {
         if (!root.container) return Qt.Horizontal
-        return root.container.orientation === ContainerNode.Horizontal 
-            ? Qt.Vertical 
+        return root.container.orientation === ContainerNode.Horizontal
+            ? Qt.Vertical
             : Qt.Horizontal
     }
     
-    // 获取第一个子节点的组件类型
-    function getFirstChildComponent() {
-        if (!root.container || !root.container.firstChild) return null
-        
-        switch (root.container.firstChild.nodeType) {
-            case SplitPanelNode.Panel:
-                return panelComponent
-            case SplitPanelNode.Container:
-                return null  // 使用source加载文件
-            default:
-                return null
-        }
+    // 子节点是否为面板（面板使用组件模板，容器使用source加载文件）
+    function isPanelNode(node) {
+        return !!node && node.nodeType === SplitPanelNode.Panel
     }
     
-    // 获取第一个子节点的文件路径
-    function getFirstChildSource() {
-        if (!root.container || !root.container.firstChild) return ""
-        if (root.container.firstChild.nodeType === SplitPanelNode.Container) {
-            return "SplitContainerView.qml"
-        }
-        return ""
+    // 获取子节点的文件路径
+    function getChildSource(node) {
+        if (!node) return ""
+        if (node.nodeType !== SplitPanelNode.Container) return ""
+        return node.orientation === ContainerNode.Stacked ? "SplitTabStackView.qml" : "SplitContainerView.qml"
     }
     
-    // 获取第二个子节点的组件类型
-    function getSecondChildComponent() {
-        if (!root.container || !root.container.secondChild) return null
-        
-        switch (root.container.secondChild.nodeType) {
-            case SplitPanelNode.Panel:
-                return panelComponent2
-            case SplitPanelNode.Container:
-                return null
-            default:
-                return null
-        }
+    // 第 index 个子节点的比例
+    function childShare(index) {
+        if (!root.container) return 0
+        var sizes = root.container.sizes
+        return index < sizes.length ? sizes[index] : 0
     }
     
-    // 获取第二个子节点的文件路径
-    function getSecondChildSource() {
-        if (!root.container || !root.container.secondChild) return ""
-        if (root.container.secondChild.nodeType === SplitPanelNode.Container) {
-            return "SplitContainerView.qml"
-        }
-        return ""
-    }
-    
-    // 计算首选宽度
-    function calculatePreferredWidth(loader) {
+    // 计算首选宽度（优先使用求解结果，只在未求解时依赖 root.width）
+    function calculatePreferredWidth(node, index) {
+        if (node && node.layoutRect.width > 0) return node.layoutRect.width
         if (!root.container) return 100
-        return getOrientation() === Qt.Horizontal 
-            ? root.width * root.container.splitRatio 
+        return getOrientation() === Qt.Horizontal
+            ? root.width * childShare(index)
             : root.width
     }
     
     // 计算首选高度
-    function calculatePreferredHeight(loader) {
+    function calculatePreferredHeight(node, index) {
+        if (node && node.layoutRect.height > 0) return node.layoutRect.height
         if (!root.container) return 100
-        return getOrientation() === Qt.Vertical 
-            ? root.height * root.container.splitRatio 
+        return getOrientation() === Qt.Vertical
+            ? root.height * childShare(index)
             : root.height
     }
     
+    // 最小尺寸：子树汇总的最小尺寸（嵌套容器不小于其全部面板的 minSize 之和）
+    function calculateMinimumWidth(node) {
+        if (node && node.layoutMinimumSize.width > 0) return node.layoutMinimumSize.width
+        return root.container ? root.container.minSize : 150
+    }
+    
+    function calculateMinimumHeight(node) {
+        if (node && node.layoutMinimumSize.height > 0) return node.layoutMinimumSize.height
+        return root.container ? root.container.minSize : 150
+    }
+    
     // ========================================================================
-    // 辅助函数：分割比例更新
+    // 辅助函数：比例更新
     // ========================================================================
     
-    // 更新分割比例（带5%-95%限制，防止极端值）
-    function updateSplitRatio(newRatio) {
+    // 根据子节点的实际尺寸更新比例（有子节点尺寸为 0 时跳过，防止布局未完成时的极端值）
+    // 实时拖动期间交给 SplitManager 合并，只更新预览比例
+    function updateSizes() {
         if (!root.container) return
-        if (newRatio > 0.05 && newRatio < 0.95) {
-            root.container.splitRatio = newRatio
+        if (childRepeater.count !== root.container.childCount) return
+        
+        var horizontal = getOrientation() === Qt.Horizontal
+        var extents = []
+        var total = 0
+        for (var i = 0; i < childRepeater.count; ++i) {
+            var item = childRepeater.itemAt(i)
+            if (!item) return
+            var extent = horizontal ? item.width : item.height
+            if (extent <= 0) return
+            extents.push(extent)
+            total += extent
         }
-    }
-    
-    // 处理宽度变化（横向分割时）
-    function handleWidthChanged(loader) {
-        if (!root.container) return
-        if (getOrientation() !== Qt.Horizontal) return
-        if (root.width <= 0 || loader.width <= 0) return
+        if (total <= 0) return
         
-        var newRatio = loader.width / root.width
-        updateSplitRatio(newRatio)
+        var sizes = extents.map(function(extent) { return extent / total })
+        if (root.liveResize && root.manager) {
+            root.manager.updateLiveResize(root.container.nodeId, sizes)
+        } else {
+            root.container.sizes = sizes
+        }
     }
     
-    // 处理高度变化（纵向分割时）
-    function handleHeightChanged(loader) {
-        if (!root.container) return
-        if (getOrientation() !== Qt.Vertical) return
-        if (root.height <= 0 || loader.height <= 0) return
-        
-        var newRatio = loader.height / root.height
-        updateSplitRatio(newRatio)
+    // 开始/结束实时拖动
+    function handleLiveResizeChanged() {
+        if (!root.container || !root.manager) return
+        if (root.liveResize) {
+            root.manager.beginLiveResize(root.container.nodeId)
+        } else {
+            root.manager.endLiveResize(root.container.nodeId, true)
+        }
     }
     
     // ========================================================================
     // 辅助函数：加载完成处理
     // ========================================================================
     
-    // 第一个子节点加载完成
-    function handleFirstLoaded(item) {
-        if (!item || !root.container || !root.container.firstChild) return
-        if (root.container.firstChild.nodeType !== SplitPanelNode.Container) return
-        
-        item.container = Qt.binding(function() { 
-            return root.container ? root.container.firstChild : null 
-        })
-        item.manager = Qt.binding(function() { return root.manager })
+    // 性能统计：子节点委托的创建/销毁/加载（统计关闭时只读一次属性）
+    function recordDelegateEvent(event) {
+        if (root.manager && root.manager.profilingEnabled) {
+            root.manager.recordDelegateEvent(event)
+        }
     }
     
-    // 第二个子节点加载完成
-    function handleSecondLoaded(item) {
-        if (!item || !root.container || !root.container.secondChild) return
-        if (root.container.secondChild.nodeType !== SplitPanelNode.Container) return
+    // 子容器加载完成：传递容器节点和共享对象
+    function handleChildLoaded(loader) {
+        recordDelegateEvent(SplitManager.DelegateLoaded)
+        var item = loader.item
+        if (!item || !loader.node) return
+        if (loader.node.nodeType !== SplitPanelNode.Container) return
         
-        item.container = Qt.binding(function() { 
-            return root.container ? root.container.secondChild : null 
-        })
+        item.container = Qt.binding(function() { return loader.node })
         item.manager = Qt.binding(function() { return root.manager })
+        item.viewPool = Qt.binding(function() { return root.viewPool })
+        item.parentResizing = Qt.binding(function() { return root.liveResize })
     }
     
     // ========================================================================
     // 辅助函数：信号处理
     // ========================================================================
     
-    // 处理第一个子节点的添加面板请求
-    function handleAddPanelFromFirst(arg1, arg2) {
-        if (arguments.length === 1) {
+    // 处理子节点的添加面板请求
+    function handleAddPanelFromChild(loader, args) {
+        if (args.length === 1) {
             // 来自PanelView（只有direction参数）
-            if (firstLoader.item && firstLoader.item.panel) {
-                root.addPanel(firstLoader.item.panel.nodeId, arg1)
+            if (loader.item && loader.item.panel) {
+                root.addPanel(loader.item.panel.nodeId, args[0])
             }
         } else {
             // 来自嵌套的ContainerView（有targetId和direction）
-            root.addPanel(arg1, arg2)
-        }
-    }
-    
-    // 处理第二个子节点的添加面板请求
-    function handleAddPanelFromSecond(arg1, arg2) {
-        if (arguments.length === 1) {
-            // 来自PanelView
-            if (secondLoader.item && secondLoader.item.panel) {
-                root.addPanel(secondLoader.item.panel.nodeId, arg1)
-            }
-        } else {
-            // 来自嵌套的ContainerView
-            root.addPanel(arg1, arg2)
+            root.addPanel(args[0], args[1])
         }
     }
     
     // 处理删除面板请求
-    function handleRemovePanel(panelId, source) {
-        Logger.debug("SplitContainerView", "Close requested for " + source + " panel", {
+    function handleRemovePanel(panelId, index) {
+        Logger.debug("SplitContainerView", "Close requested for child " + index, {
             "panelId": panelId
         })
         root.removePanel(panelId)
     }
     
     // ========================================================================
-    // UI组件：第一个子节点加载器
+    // UI组件：子节点加载器
     // ========================================================================
     
-    Loader {
-        id: firstLoader
-        
-        sourceComponent: getFirstChildComponent()
-        source: getFirstChildSource()
+    Repeater {
+        id: childRepeater
         
-        SplitView.preferredWidth: calculatePreferredWidth(firstLoader)
-        SplitView.preferredHeight: calculatePreferredHeight(firstLoader)
-        SplitView.minimumWidth: root.container ? root.container.minSize : 150
-        SplitView.minimumHeight: root.container ? root.container.minSize : 150
+        model: root.container ? root.container.childCount : 0
         
-        onWidthChanged: handleWidthChanged(firstLoader)
-        onHeightChanged: handleHeightChanged(firstLoader)
-        onLoaded: handleFirstLoaded(item)
-    }
-    
-    // Panel组件模板（用于第一个子节点）
-    Component {
-        id: panelComponent
-        SplitPanelView {
-            panel: root.container ? root.container.firstChild : null
-        }
-    }
-    
-    // 监听第一个子节点的信号
-    Connections {
-        target: firstLoader.item
-        enabled: firstLoader.item
-        
-        function onAddPanel(arg1, arg2) {
-            handleAddPanelFromFirst(arg1, arg2)
-        }
-        
-        function onRemovePanel(panelId) {
-            handleRemovePanel(panelId, "first")
+        delegate: Loader {
+            id: childLoader
+            
+            required property int index
+            readonly property var node: root.container ? root.container.childNodes[index] : null
+            readonly property bool isLast: index === childRepeater.count - 1
+            
+            sourceComponent: isPanelNode(childLoader.node) ? panelComponent : null
+            source: getChildSource(childLoader.node)
+            
+            // 最后一个子节点填充剩余空间，其余按比例
+            SplitView.preferredWidth: calculatePreferredWidth(childLoader.node, index)
+            SplitView.preferredHeight: calculatePreferredHeight(childLoader.node, index)
+            SplitView.fillWidth: isLast && getOrientation() === Qt.Horizontal
+            SplitView.fillHeight: isLast && getOrientation() === Qt.Vertical
+            SplitView.minimumWidth: calculateMinimumWidth(childLoader.node)
+            SplitView.minimumHeight: calculateMinimumHeight(childLoader.node)
+            
+            onWidthChanged: if (getOrientation() === Qt.Horizontal) updateSizes()
+            onHeightChanged: if (getOrientation() === Qt.Vertical) updateSizes()
+            onLoaded: handleChildLoaded(childLoader)
+            Component.onCompleted: recordDelegateEvent(SplitManager.DelegateCreated)
+            Component.onDestruction: recordDelegateEvent(SplitManager.DelegateDestroyed)
+            
+            // Panel组件模板
+            Component {
+                id: panelComponent
+                SplitPanelHost {
+                    panel: childLoader.node
+                    viewPool: root.viewPool
+                }
+            }
+            
+            // 监听子节点的信号
+            Connections {
+                target: childLoader.item
+                enabled: childLoader.item
+                
+                function onAddPanel(arg1, arg2) {
+                    handleAddPanelFromChild(childLoader, arguments)
+                }
+                
+                function onRemovePanel(panelId) {
+                    handleRemovePanel(panelId, childLoader.index)
+                }
+            }
         }
     }
     
@@ -269,50 +275,19 @@ SplitView {
     
     handle: SplitHandle {}
     
-    // ========================================================================
-    // UI组件：第二个子节点加载器
-    // ========================================================================
-    
-    Loader {
-        id: secondLoader
-        
-        sourceComponent: getSecondChildComponent()
-        source: getSecondChildSource()
-        
-        SplitView.fillWidth: getOrientation() === Qt.Horizontal
-        SplitView.fillHeight: getOrientation() === Qt.Vertical
-        SplitView.minimumWidth: root.container ? root.container.minSize : 150
-        SplitView.minimumHeight: root.container ? root.container.minSize : 150
-        
-        onLoaded: handleSecondLoaded(item)
-    }
+    onLiveResizeChanged: handleLiveResizeChanged()
     
-    // Panel组件模板（用于第二个子节点）
-    Component {
-        id: panelComponent2
-        SplitPanelView {
-            panel: root.container ? root.container.secondChild : null
+    // 视图在拖动中被销毁（如拖动时删除面板）时结束拖动，放弃未提交的比例
+    Component.onDestruction: {
+        if (root.liveResize && root.container && root.manager) {
+            root.manager.endLiveResize(root.container.nodeId, false)
         }
     }
     
-    // 监听第二个子节点的信号
-    Connections {
-        target: secondLoader.item
-        enabled: secondLoader.item
-        
-        function onAddPanel(arg1, arg2) {
-            handleAddPanelFromSecond(arg1, arg2)
-        }
-        
-        function onRemovePanel(panelId) {
-            handleRemovePanel(panelId, "second")
-        }
-    }
-
     // ========================================================================
     // 可复用组件定义
     // ========================================================================
-
+    
     // 分割手柄组件（可拖动，鼠标悬停时高亮）
     component SplitHandle: Rectangle {
         implicitWidth: root.orientation === Qt.Horizontal ? 4 : parent.width
@@ -328,4 +303,3 @@ SplitView {
         }
     }
 }
-
@@ -13,7 +13,7 @@ import SplitPanel 1.0
  * 
  * 核心功能：
  *   1. 类型判断：检查 node.nodeType
- *   2. 动态加载：Panel → PanelView, Container → ContainerView
+ *   2. 动态加载：Panel → PanelView, Container → ContainerView（Stacked 容器 → TabStackView）
  *   3. 信号转发：将子组件的信号向上传递
  * 
  * 为什么需要这个组件？
@@ -46,6 +46,12 @@ Loader {
      */
     property SplitManager manager: null
     
+    /**
+     * viewPool - 面板视图池
+     * 用途：面板视图按 nodeId 复用，树结构变化时不重新实例化面板内容
+     */
+    property var viewPool: null
+    
     // ========================================================================
     // 信号定义（向上传递）
     // ========================================================================
@@ -87,6 +93,7 @@ Loader {
      *   1. 如果 node 为 null：不加载任何组件
      *   2. 如果 node.nodeType == Panel：加载 PanelView
      *   3. 如果 node.nodeType == Container：加载 ContainerView
+     *      orientation 为 Stacked 时加载 TabStackView（只渲染当前标签）
      * 
      * 自动更新：
      *   node 变化 → sourceComponent 重新求值 → 销毁旧组件 → 创建新组件
@@ -101,7 +108,8 @@ Loader {
             case SplitPanelNode.Panel:
                 return panelComponent      // 面板 → PanelView
             case SplitPanelNode.Container:
-                return containerComponent  // 容器 → ContainerView
+                // 标签页 → TabStackView，分割容器 → ContainerView
+                return node.orientation === ContainerNode.Stacked ? tabStackComponent : containerComponent
             default:
                 return null
         }
@@ -120,15 +128,36 @@ Loader {
      */
     asynchronous: true
     
+    // ========================================================================
+    // 性能统计（manager.profilingEnabled 为 false 时只读一次属性）
+    // ========================================================================
+    
     /**
-     * 组件销毁回调
+     * 组件创建/销毁回调
      * 
      * 注意：
      *   Loader 会自动清理加载的 item
      *   不需要手动调用 destroy()
      */
+    Component.onCompleted: {
+        if (manager && manager.profilingEnabled) {
+            manager.recordDelegateEvent(SplitManager.DelegateCreated)
+        }
+    }
+    
     Component.onDestruction: {
-        // 自动清理，无需手动操作
+        if (manager && manager.profilingEnabled) {
+            manager.recordDelegateEvent(SplitManager.DelegateDestroyed)
+        }
+    }
+    
+    /**
+     * 加载了新的视图组件（首次加载或节点类型变化导致重建）
+     */
+    onLoaded: {
+        if (manager && manager.profilingEnabled) {
+            manager.recordDelegateEvent(SplitManager.DelegateLoaded)
+        }
     }
     
     // ========================================================================
@@ -142,13 +171,15 @@ Loader {
      *   当 node.nodeType == Panel 时，由 Loader 实例化
      * 
      * 绑定：
-     *   panel: root.node - 将节点对象传给 PanelView
+     *   panel: root.node - 将节点对象传给 PanelHost
+     *   viewPool: root.viewPool - 从视图池借用已有的 PanelView
      */
     Component {
         id: panelComponent
         
-        SplitPanelView {
-            panel: root.node  // 绑定面板节点
+        SplitPanelHost {
+            panel: root.node          // 绑定面板节点
+            viewPool: root.viewPool   // 复用已存在的面板视图
         }
     }
     
@@ -166,8 +197,26 @@ Loader {
         id: containerComponent
         
         SplitContainerView {
-            container: root.node  // 绑定容器节点
-            manager: root.manager // 传递管理器
+            container: root.node    // 绑定容器节点
+            manager: root.manager   // 传递管理器
+            viewPool: root.viewPool // 传递视图池
+        }
+    }
+    
+    /**
+     * tabStackComponent - 标签页容器组件模板
+     * 
+     * 用途：
+     *   当容器的 orientation == Stacked 时，由 Loader 实例化
+     *   只为当前标签创建视图，未选中标签的面板视图留在视图池中按休眠策略卸载
+     */
+    Component {
+        id: tabStackComponent
+        
+        SplitTabStackView {
+            container: root.node    // 绑定容器节点
+            manager: root.manager   // 传递管理器
+            viewPool: root.viewPool // 传递视图池
         }
     }
     
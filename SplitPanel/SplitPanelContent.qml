@@ -17,6 +17,10 @@ import QtQuick.Layouts
 //   PanelView加载完成后，会自动设置panelNode属性
 //   本组件可以通过panelNode访问面板的ID、标题等信息
 // 
+// 休眠：
+//   面板休眠前 PanelView 调用 saveState() 保存状态，内容重新创建后调用 restoreState(state)
+//   两个函数都是可选的，本示例保存列表的滚动位置
+// 
 // ============================================================================
 
 Rectangle {
@@ -53,6 +57,22 @@ Rectangle {
         console.log("按钮被点击")
     }
     
+    // ========================================================================
+    // 辅助函数：休眠状态
+    // ========================================================================
+    
+    // 休眠前保存状态（返回值由 SplitManager 暂存）
+    function saveState() {
+        return { "scrollY": listScroll.contentItem.contentY }
+    }
+    
+    // 唤醒后恢复状态
+    function restoreState(state) {
+        if (state && state.scrollY !== undefined) {
+            listScroll.contentItem.contentY = state.scrollY
+        }
+    }
+    
     // ========================================================================
     // UI布局
     // ========================================================================
@@ -85,6 +105,7 @@ Rectangle {
         
         // 可滚动列表
         ScrollView {
+            id: listScroll
             Layout.fillWidth: true
             Layout.fillHeight: true
             
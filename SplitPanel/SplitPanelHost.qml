@@ -0,0 +1,118 @@
+import QtQuick
+import SplitPanel 1.0
+
+// ============================================================================
+// SplitPanelHost.qml - 面板视图宿主
+// ============================================================================
+//
+// 功能：
+//   在节点树中占据面板的位置，实际的 SplitPanelView 从视图池借用
+//   宿主随 Loader 频繁创建/销毁，视图本身则跨树结构变化复用
+//
+// 核心机制：
+//   1. panel 绑定变化时：归还旧视图，借用新视图
+//   2. 销毁时：把视图归还给视图池
+//   3. 没有视图池时退化为直接创建视图（与原行为一致）
+//
+// 信号（与 SplitPanelView 保持一致，上层无需区分）：
+//   addPanel(direction) - 请求在指定方向添加新面板
+//   removePanel(panelId) - 请求删除当前面板
+//
+// ============================================================================
+
+Item {
+    id: root
+
+    // ========================================================================
+    // 属性定义
+    // ========================================================================
+
+    property var panel: null     // 面板节点对象
+    property var viewPool: null  // SplitPanelViewPool实例（可选）
+
+    property var view: null            // 当前挂载的面板视图
+    property string attachedId: ""     // 当前挂载视图对应的面板ID
+
+    // ========================================================================
+    // 信号定义
+    // ========================================================================
+
+    signal addPanel(int direction)
+    signal removePanel(string panelId)
+
+    // ========================================================================
+    // 辅助函数：视图挂载
+    // ========================================================================
+
+    // 挂载当前面板对应的视图
+    function attachView() {
+        if (root.panel && root.attachedId === root.panel.nodeId && root.view) {
+            // 同一个面板，只需同步节点对象
+            if (root.view.panel !== root.panel) {
+                root.view.panel = root.panel
+            }
+            return
+        }
+
+        detachView()
+        if (!root.panel) return
+
+        if (root.viewPool) {
+            root.view = root.viewPool.acquire(root.panel, root)
+        } else {
+            root.view = fallbackComponent.createObject(root, { "panel": root.panel })
+            if (root.view) {
+                root.view.anchors.fill = root
+            }
+        }
+        root.attachedId = root.view ? root.panel.nodeId : ""
+    }
+
+    // 卸下当前视图（有视图池则归还，否则销毁）
+    function detachView() {
+        if (!root.view) return
+
+        if (root.viewPool) {
+            root.viewPool.release(root.attachedId, root)
+        } else {
+            root.view.destroy()
+        }
+        root.view = null
+        root.attachedId = ""
+    }
+
+    // ========================================================================
+    // 生命周期回调
+    // ========================================================================
+
+    onPanelChanged: attachView()
+    Component.onCompleted: attachView()
+    Component.onDestruction: detachView()
+
+    // ========================================================================
+    // 信号转发（视图 → 上层）
+    // ========================================================================
+
+    Connections {
+        target: root.view
+        enabled: root.view
+
+        function onAddPanel(direction) {
+            root.addPanel(direction)
+        }
+
+        function onRemovePanel(panelId) {
+            root.removePanel(panelId)
+        }
+    }
+
+    // ========================================================================
+    // 组件定义
+    // ========================================================================
+
+    Component {
+        id: fallbackComponent
+
+        SplitPanelView {}
+    }
+}
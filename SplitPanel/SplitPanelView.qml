@@ -12,7 +12,8 @@ import SplitPanel 1.0
 // 
 // 组成：
 //   1. 标题栏 - 显示面板标题、图标、操作按钮（添加/关闭）
-//   2. 内容区 - 动态加载QML内容文件
+//   2. 内容区 - 通过 PanelContentCache 异步创建QML内容（可见的大面板优先）
+//      面板休眠（panel.hibernated）时卸载内容，状态交给 SplitManager 暂存，唤醒后恢复
 //   3. 辅助函数 - 处理用户操作、数据获取、生命周期管理
 // 
 // 信号：
@@ -29,6 +30,22 @@ Rectangle {
     // ========================================================================
     
     required property var panel  // 面板数据对象（包含ID、标题、内容路径）
+    property var manager: null   // SplitManager（上报可见性、暂存休眠状态），为空时不参与休眠
+    
+    property var contentObject: null    // 已创建的内容对象
+    property url contentUrl: ""         // 当前内容（或正在创建的内容）的 URL
+    property string contentStatus: ""   // ""=无内容, "loading", "ready", "error"
+    
+    // 是否显示在屏幕上（停放在视图池中或窗口最小化时为 false）
+    readonly property bool shownOnScreen: visible
+                                          && Window.visibility !== Window.Minimized
+                                          && Window.visibility !== Window.Hidden
+    
+    // 是否休眠（内容已卸载）
+    readonly property bool hibernated: !!root.panel && root.panel.hibernated
+    
+    // 内容创建优先级：可见面积越大越先创建，不在屏幕上时为 0
+    readonly property real contentPriority: shownOnScreen ? width * height : 0
     readonly property bool showTitleBar: true  // 是否显示标题栏（开发模式=true）
     
     // ========================================================================
@@ -65,6 +82,20 @@ Rectangle {
         root.removePanel(root.panel.nodeId)
     }
     
+    // 分离到新窗口；已在分离窗口中时停靠回主窗口（节点和内容都不重建）
+    function handleToggleDetach() {
+        if (!root.panel || !root.manager) return
+        var windowId = root.manager.windowOf(root.panel.nodeId)
+        var mainRoot = root.manager.rootNode
+        if (windowId === "") {
+            root.manager.detachNode(root.panel.nodeId)
+        } else if (mainRoot) {
+            root.manager.moveNode(root.panel.nodeId, mainRoot.nodeId, SplitManager.Right)
+        } else {
+            root.manager.closeWindow(windowId)
+        }
+    }
+    
     // ========================================================================
     // 辅助函数：数据获取
     // ========================================================================
@@ -84,6 +115,12 @@ Rectangle {
         return root.panel ? root.panel.qmlSource : ""
     }
     
+    // 获取内容文件的绝对 URL（相对路径按本文件所在目录解析，与 Loader 一致）
+    function getContentUrl() {
+        var source = getContentSource()
+        return source ? Qt.resolvedUrl(source) : ""
+    }
+    
     // 计算内容区顶部位置（根据标题栏显示状态）
     function getContentAnchorTop() {
         return root.showTitleBar ? titleBar.bottom : parent.top
@@ -93,6 +130,59 @@ Rectangle {
     // 辅助函数：内容加载处理
     // ========================================================================
     
+    // 请求创建内容（内容路径变化时替换旧内容）
+    // 视图停放在视图池中时 panel 可能暂时为 null（旧节点已销毁、新节点尚未绑定），
+    // 此时保持原内容不卸载，重新绑定后内容状态不丢失
+    function requestContent() {
+        if (!root.panel || root.hibernated) return
+        
+        var url = getContentUrl()
+        if (String(url) === String(root.contentUrl) && root.contentStatus !== "error") return
+        
+        clearContent()
+        if (String(url) === "") return
+        
+        root.contentUrl = url
+        root.contentStatus = "loading"
+        PanelContentCache.request(contentArea, url, { "panelNode": root.panel }, root.contentPriority)
+    }
+    
+    // 取消未完成的请求并销毁已创建的内容
+    function clearContent() {
+        PanelContentCache.cancel(contentArea)
+        if (root.contentObject) {
+            root.contentObject.destroy()
+            root.contentObject = null
+        }
+        root.contentUrl = ""
+        root.contentStatus = ""
+    }
+    
+    // 休眠：保存内容状态后卸载内容
+    function hibernateContent() {
+        if (root.contentObject && root.manager && typeof root.contentObject.saveState === "function") {
+            root.manager.storePanelState(root.panel.nodeId, root.contentObject.saveState())
+        }
+        clearContent()
+    }
+    
+    // 内容重新创建后恢复休眠前的状态
+    function restoreContentState(item) {
+        if (!root.manager || !root.panel || typeof item.restoreState !== "function") return
+        
+        var state = root.manager.takePanelState(root.panel.nodeId)
+        if (state !== undefined) {
+            item.restoreState(state)
+        }
+    }
+    
+    // 向 SplitManager 上报可见性和尺寸（休眠策略的输入）
+    function reportVisibility() {
+        if (!root.manager || !root.panel) return
+        root.manager.reportPanelVisibility(root.panel.nodeId, root.shownOnScreen,
+                                           contentArea.width, contentArea.height)
+    }
+    
     // 内容加载完成后，将面板对象传递给内容组件
     function handleContentLoaded(item) {
         if (!item || !root.panel) return
@@ -176,7 +266,7 @@ Rectangle {
                 elide: Text.ElideRight
             }
             
-            // 方向按钮组（上下左右）
+            // 方向按钮组（上下左右、标签）
             RowLayout {
                 spacing: 2
                 
@@ -204,6 +294,19 @@ Rectangle {
                     onClicked: handleAddPanel(SplitManager.Right)
                 }
                 
+                DirectionButton {
+                    text: "⊞"
+                    tooltipText: "作为新标签添加面板"
+                    onClicked: handleAddPanel(SplitManager.Center)
+                }
+                
+                DirectionButton {
+                    text: "⧉"
+                    tooltipText: "分离到新窗口 / 停靠回主窗口"
+                    visible: root.manager !== null
+                    onClicked: handleToggleDetach()
+                }
+                
                 // 分隔线
                 Rectangle {
                     Layout.preferredWidth: 1
@@ -222,39 +325,94 @@ Rectangle {
     }
     
     // ========================================================================
-    // UI组件：内容加载器
+    // UI组件：内容区
     // ========================================================================
     
-    Loader {
-        id: contentLoader
+    Item {
+        id: contentArea
         anchors.left: parent.left
         anchors.right: parent.right
         anchors.top: getContentAnchorTop()
         anchors.bottom: parent.bottom
         anchors.margins: 1
         
-        source: getContentSource()  // 动态加载内容文件
-        asynchronous: true  // 异步加载，不阻塞主线程
+        // PanelContentCache 回调：内容创建完成（对象已挂到本 Item 下）
+        function attachContent(item) {
+            root.contentObject = item
+            item.anchors.fill = contentArea
+            root.contentStatus = "ready"
+            handleContentLoaded(item)
+            restoreContentState(item)
+        }
         
-        onLoaded: handleContentLoaded(item)
+        // PanelContentCache 回调：编译或创建失败
+        function contentFailed(message) {
+            root.contentStatus = "error"
+        }
         
         // 加载中提示
         LoadingIndicator {
-            visible: contentLoader.status === Loader.Loading
+            visible: root.contentStatus === "loading"
         }
         
         // 加载失败提示
         ErrorIndicator {
-            visible: contentLoader.status === Loader.Error
+            visible: root.contentStatus === "error"
             errorSource: getContentSource()
         }
+        
+        // 休眠提示
+        HibernatedIndicator {
+            visible: root.hibernated
+        }
+        
+        onWidthChanged: reportVisibility()
+        onHeightChanged: reportVisibility()
+    }
+    
+    // 面板节点被替换时同步给已创建的内容组件，内容路径变化时重新创建
+    onPanelChanged: {
+        requestContent()
+        handleContentLoaded(root.contentObject)
+        reportVisibility()
+    }
+    
+    // 休眠卸载内容，唤醒重新创建
+    onHibernatedChanged: {
+        if (root.hibernated) {
+            hibernateContent()
+        } else {
+            requestContent()
+        }
+    }
+    
+    onShownOnScreenChanged: reportVisibility()
+    
+    Connections {
+        target: root.panel
+        enabled: !!root.panel
+        
+        function onQmlSourceChanged() {
+            requestContent()
+        }
+    }
+    
+    // 尺寸/可见性变化时调整排队中的内容请求
+    onContentPriorityChanged: {
+        if (root.contentStatus === "loading") {
+            PanelContentCache.setPriority(contentArea, root.contentPriority)
+        }
     }
     
     // ========================================================================
     // 生命周期回调
     // ========================================================================
     
-    Component.onCompleted: logPanelCreated()
+    Component.onCompleted: {
+        logPanelCreated()
+        requestContent()
+        reportVisibility()
+    }
     Component.onDestruction: logPanelDestroyed()
     
     // ========================================================================
@@ -332,6 +490,19 @@ Rectangle {
         }
     }
     
+    // 休眠指示器组件
+    component HibernatedIndicator: Rectangle {
+        anchors.fill: parent
+        color: "#1e1e1e"
+        
+        Text {
+            anchors.centerIn: parent
+            text: "已休眠"
+            color: "#666666"
+            font.pixelSize: 12
+        }
+    }
+    
     // 错误指示器组件
     component ErrorIndicator: Rectangle {
         property string errorSource: ""
@@ -0,0 +1,129 @@
+import QtQuick
+import SplitPanel 1.0
+
+// ============================================================================
+// SplitPanelViewPool.qml - 面板视图池（按 nodeId 复用面板视图）
+// ============================================================================
+//
+// 功能：
+//   以 nodeId 为键缓存 SplitPanelView 实例
+//   树结构变化（如 insertPanelAt 把根节点包进新的 ContainerNode）时，
+//   旧的 Loader 子树会被销毁重建，但面板视图及其内容只被"摘下"再"挂上"，
+//   不会重新实例化，编辑器、图表等重型内容的状态得以保留
+//
+// 核心机制：
+//   1. acquire(panel, host)：取出（或首次创建）视图，视觉父对象改为宿主
+//   2. release(nodeId, host)：宿主销毁时把视图停放回本池（隐藏）
+//   3. sweep()：销毁管理器中已不存在的面板对应的停放视图
+//
+//   面板内容的组件缓存和异步创建由 C++ 单例 PanelContentCache 负责
+//
+// 注意：
+//   视图的 Qt 对象父对象始终是本池，宿主只改变视觉父对象（parent），
+//   因此宿主被 Loader 销毁时不会连带销毁视图
+//
+// ============================================================================
+
+Item {
+    id: root
+
+    // ========================================================================
+    // 属性定义
+    // ========================================================================
+
+    property var manager: null  // SplitManager实例（用于判断面板是否仍然存在）
+
+    // nodeId → SplitPanelView（普通 JS 对象，修改内容不触发绑定）
+    property var views: ({})
+
+    // 停放区域不可见，停放中的视图不参与渲染
+    visible: false
+
+    // ========================================================================
+    // 辅助函数：视图借还
+    // ========================================================================
+
+    // 获取面板视图并挂到宿主上（只有池中不存在的面板才会新建视图）
+    function acquire(panel, host) {
+        if (!panel || !host) return null
+
+        var view = root.views[panel.nodeId]
+        if (view) {
+            // 节点对象可能已被替换（如重新加载了同 ID 的面板），重新绑定即可
+            if (view.panel !== panel) {
+                view.panel = panel
+            }
+        } else {
+            view = viewComponent.createObject(root, { "panel": panel })
+            if (!view) {
+                Logger.error("SplitPanelViewPool", "Failed to create panel view", {
+                    "panelId": panel.nodeId
+                })
+                return null
+            }
+            root.views[panel.nodeId] = view
+        }
+
+        view.parent = host
+        view.anchors.fill = host
+        return view
+    }
+
+    // 宿主销毁或换绑时归还视图
+    function release(nodeId, host) {
+        var view = root.views[nodeId]
+        if (!view) return
+
+        // 视图已被新的宿主接管（新宿主先于旧宿主销毁前创建），不能抢回来
+        if (view.parent !== host) return
+
+        view.anchors.fill = undefined
+        view.parent = root
+        Qt.callLater(root.sweep)
+    }
+
+    // 销毁已不在管理器中的停放视图
+    function sweep() {
+        for (var nodeId in root.views) {
+            var view = root.views[nodeId]
+            if (!view) {
+                delete root.views[nodeId]
+                continue
+            }
+            if (view.parent !== root) continue  // 仍在使用中
+            if (root.manager && root.manager.findPanel(nodeId)) continue  // 面板仍存在，等待重新挂载
+
+            delete root.views[nodeId]
+            view.destroy()
+        }
+    }
+
+    // ========================================================================
+    // 信号监听：面板删除、布局重载后清理
+    // ========================================================================
+
+    Connections {
+        target: root.manager
+        enabled: root.manager
+
+        function onPanelRemoved(panelId) {
+            Qt.callLater(root.sweep)
+        }
+
+        function onLayoutChanged() {
+            Qt.callLater(root.sweep)
+        }
+    }
+
+    // ========================================================================
+    // 组件定义
+    // ========================================================================
+
+    Component {
+        id: viewComponent
+
+        SplitPanelView {
+            manager: root.manager
+        }
+    }
+}
@@ -14,9 +14,14 @@ import SplitPanel 1.0
 //   2. 通过NodeRenderer递归渲染整棵节点树
 //   3. 接收子组件的信号（添加/删除面板）并转发给DockingManager
 //   4. 显示空状态提示（无面板时）
+//   5. 分片执行的大操作（异步加载布局、面板内容孵化）持续较久时显示进度，不拦截输入
+//   6. 分离窗口：rootNode 绑定到 splitManager.windowRoots[windowId]，
+//      各窗口传入同一个 viewPool，面板在窗口间移动时视图和内容不重建
+//   7. 上报视口尺寸，各节点的首选尺寸由 SplitManager 的布局求解器计算
 // 
 // 数据流：
 //   SplitManager → rootNode → NodeRenderer → 递归渲染各个Panel和Container
+//   PanelHost ← PanelViewPool（按nodeId复用PanelView，只有新面板才会实例化）
 // 
 // 信号流：
 //   用户操作 → PanelView/ContainerView → NodeRenderer → 本组件 → SplitManager
@@ -32,6 +37,12 @@ Item {
     
     required property SplitManager splitManager  // 停靠管理器实例
     
+    // 渲染的树（默认主窗口的树，分离窗口传入自己的根节点）
+    property SplitPanelNode rootNode: splitManager.rootNode
+    
+    // 面板视图池（默认使用本视图自己的池，多个窗口共用一个池时由外部传入）
+    property var viewPool: panelViewPool
+    
     // ========================================================================
     // 信号定义
     // ========================================================================
@@ -43,11 +54,20 @@ Item {
     // 辅助函数：数据生成
     // ========================================================================
     
-    // 生成唯一面板ID（使用时间戳）
+    // 生成唯一面板ID（由 SplitManager 分配，不与已加载布局中的 ID 冲突）
     function generatePanelId() {
-        return "panel_" + Date.now()
+        return splitManager.generatePanelId()
+    }
+    
+    // 上报视口尺寸：树的几何由 SplitManager 求解，QML 只绑定结果
+    function reportViewport() {
+        if (root.rootNode) {
+            splitManager.setViewportSize(root.rootNode, rootRenderer.width, rootRenderer.height)
+        }
     }
     
+    onRootNodeChanged: reportViewport()
+    
     // ========================================================================
     // 辅助函数：事件处理
     // ========================================================================
@@ -78,7 +98,7 @@ Item {
     
     // 判断是否为空状态（无面板）
     function isEmptyState() {
-        return !splitManager.rootNode
+        return !root.rootNode
     }
     
     // ========================================================================
@@ -97,7 +117,18 @@ Item {
     SplitNodeRenderer {
         id: rootRenderer
         anchors.fill: parent
-        node: splitManager.rootNode  // 绑定根节点，自动监听变化
+        node: root.rootNode          // 绑定根节点，自动监听变化
+        manager: splitManager
+        viewPool: root.viewPool      // 面板视图按nodeId复用
+        
+        // 视口尺寸交给 C++ 求解各节点几何（SplitLayoutSolver）
+        onWidthChanged: root.reportViewport()
+        onHeightChanged: root.reportViewport()
+    }
+    
+    // 默认的面板视图池：树结构重组时保留已有面板视图及其内容
+    SplitPanelViewPool {
+        id: panelViewPool
         manager: splitManager
     }
     
@@ -119,7 +150,69 @@ Item {
     // ========================================================================
     
     EmptyStatePrompt {
-        visible: root.isEmptyState()
+        visible: root.isEmptyState() && !splitManager.loading
+    }
+    
+    // ========================================================================
+    // UI组件：分片执行进度
+    // ========================================================================
+    
+    SliceProgressIndicator {
+        manager: splitManager
+        anchors.horizontalCenter: parent.horizontalCenter
+        anchors.bottom: parent.bottom
+        anchors.bottomMargin: 16
+    }
+    
+    // 进度提示组件（短暂的任务不显示，避免单个面板创建内容时闪烁）
+    component SliceProgressIndicator: Rectangle {
+        id: indicator
+        
+        required property SplitManager manager
+        readonly property bool active: manager.loading || manager.scheduler.busy
+        property bool shown: false
+        
+        visible: shown
+        width: 260
+        height: 48
+        radius: 6
+        color: "#2b2b2b"
+        opacity: 0.92
+        
+        onActiveChanged: {
+            if (active) {
+                showTimer.restart()
+            } else {
+                showTimer.stop()
+                shown = false
+            }
+        }
+        
+        Timer {
+            id: showTimer
+            interval: 300
+            onTriggered: indicator.shown = true
+        }
+        
+        Column {
+            anchors.centerIn: parent
+            spacing: 6
+            
+            Text {
+                text: indicator.manager.loading
+                    ? "正在恢复布局… " + Math.round(indicator.manager.loadProgress * 100) + "%"
+                    : "正在创建面板内容…"
+                color: "white"
+                font.pixelSize: 12
+            }
+            
+            ProgressBar {
+                width: 230
+                value: indicator.manager.loading
+                    ? indicator.manager.loadProgress
+                    : indicator.manager.scheduler.progress
+            }
+        }
     }
     
     // 空状态提示组件
@@ -0,0 +1,250 @@
+import QtQuick
+import QtQuick.Controls
+import SplitPanel 1.0
+
+// ============================================================================
+// SplitTabStackView.qml - 标签页容器视图
+// ============================================================================
+//
+// 功能：
+//   渲染 orientation 为 Stacked 的容器：顶部标签栏 + 当前标签的内容
+//   子节点可以是面板，也可以是分割容器（标签显示为"分组"）
+//
+// 核心机制：
+//   1. 标签栏只读取子节点的标题，不为未选中的标签创建任何视图
+//   2. 只有一个 Loader，始终加载 container.currentIndex 指向的子节点
+//   3. 切换标签时宿主把旧面板视图归还视图池：池中的视图不可见，
+//      按 SplitPanelView 的休眠策略（hibernationDelay）卸载内容，切回时重新加载
+//   4. 点击标签直接修改 container.currentIndex（记录在布局中，不进入撤销历史）
+//
+// 信号（与 SplitContainerView 保持一致）：
+//   addPanel(targetId, direction) - 请求添加面板
+//   removePanel(panelId) - 请求删除面板
+//
+// ============================================================================
+
+Item {
+    id: root
+
+    // ========================================================================
+    // 属性定义
+    // ========================================================================
+
+    property var container: null  // 标签页容器节点
+    property var manager: null    // SplitManager实例
+    property var viewPool: null   // 面板视图池（按nodeId复用面板视图）
+    property bool parentResizing: false  // 祖先容器是否正在拖动分割条（此视图无分割条，只向下传递）
+
+    // 当前标签对应的子节点
+    readonly property var currentNode: root.container && root.container.currentIndex >= 0
+        ? root.container.childNodes[root.container.currentIndex]
+        : null
+
+    // ========================================================================
+    // 信号定义
+    // ========================================================================
+
+    signal addPanel(string targetId, int direction)
+    signal removePanel(string panelId)
+
+    // ========================================================================
+    // 辅助函数
+    // ========================================================================
+
+    // 子节点是否为面板（面板使用组件模板，容器使用source加载文件）
+    function isPanelNode(node) {
+        return !!node && node.nodeType === SplitPanelNode.Panel
+    }
+
+    // 获取子容器的文件路径
+    function getChildSource(node) {
+        if (!node || node.nodeType !== SplitPanelNode.Container) return ""
+        return node.orientation === ContainerNode.Stacked ? "SplitTabStackView.qml" : "SplitContainerView.qml"
+    }
+
+    // 标签标题（子容器显示为"分组"）
+    function tabTitle(node) {
+        if (!node) return ""
+        return isPanelNode(node) ? node.title : "分组"
+    }
+
+    // 切换到第 index 个标签
+    function selectTab(index) {
+        if (root.container && root.container.currentIndex !== index) {
+            root.container.currentIndex = index
+        }
+    }
+
+    // 子容器加载完成：传递容器节点和共享对象
+    function handleContentLoaded() {
+        if (root.manager && root.manager.profilingEnabled) {
+            root.manager.recordDelegateEvent(SplitManager.DelegateLoaded)
+        }
+        var item = contentLoader.item
+        if (!item || !root.currentNode) return
+        if (root.currentNode.nodeType !== SplitPanelNode.Container) return
+
+        item.container = Qt.binding(function() { return root.currentNode })
+        item.manager = Qt.binding(function() { return root.manager })
+        item.viewPool = Qt.binding(function() { return root.viewPool })
+        item.parentResizing = Qt.binding(function() { return root.parentResizing })
+    }
+
+    // 处理当前标签的添加面板请求
+    function handleAddPanelFromContent(args) {
+        if (args.length === 1) {
+            // 来自PanelView（只有direction参数）
+            if (root.currentNode) {
+                root.addPanel(root.currentNode.nodeId, args[0])
+            }
+        } else {
+            // 来自嵌套的容器视图（有targetId和direction）
+            root.addPanel(args[0], args[1])
+        }
+    }
+
+    // ========================================================================
+    // UI组件：标签栏
+    // ========================================================================
+
+    Rectangle {
+        id: tabBar
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.top: parent.top
+        height: 28
+        color: "#252526"
+
+        ListView {
+            id: tabList
+            anchors.fill: parent
+            orientation: ListView.Horizontal
+            clip: true
+            boundsBehavior: Flickable.StopAtBounds
+
+            model: root.container ? root.container.childCount : 0
+
+            delegate: Rectangle {
+                id: tab
+
+                required property int index
+                readonly property var node: root.container ? root.container.childNodes[index] : null
+                readonly property bool current: root.container ? root.container.currentIndex === index : false
+
+                width: Math.min(180, tabLabel.implicitWidth + (tabClose.visible ? 40 : 20))
+                height: tabList.height
+                color: tab.current ? "#1e1e1e" : (tabHover.hovered ? "#2d2d2d" : "transparent")
+
+                // 当前标签的顶部高亮条
+                Rectangle {
+                    anchors.left: parent.left
+                    anchors.right: parent.right
+                    anchors.top: parent.top
+                    height: 2
+                    color: "#58a6ff"
+                    visible: tab.current
+                }
+
+                Text {
+                    id: tabLabel
+                    anchors.left: parent.left
+                    anchors.leftMargin: 10
+                    anchors.right: tabClose.visible ? tabClose.left : parent.right
+                    anchors.rightMargin: tabClose.visible ? 4 : 10
+                    anchors.verticalCenter: parent.verticalCenter
+                    text: root.tabTitle(tab.node)
+                    color: tab.current ? "#e6e6e6" : "#999999"
+                    font.pixelSize: 12
+                    elide: Text.ElideRight
+                }
+
+                HoverHandler {
+                    id: tabHover
+                }
+
+                TapHandler {
+                    onTapped: root.selectTab(tab.index)
+                }
+
+                // 关闭按钮（只有面板标签有）
+                ToolButton {
+                    id: tabClose
+                    anchors.right: parent.right
+                    anchors.rightMargin: 4
+                    anchors.verticalCenter: parent.verticalCenter
+                    width: 18
+                    height: 18
+                    visible: root.isPanelNode(tab.node)
+                    text: "×"
+                    font.pixelSize: 12
+
+                    background: Rectangle {
+                        color: parent.hovered ? "#e74856" : "transparent"
+                        radius: 3
+                    }
+
+                    contentItem: Text {
+                        text: parent.text
+                        font: parent.font
+                        color: "#e6e6e6"
+                        horizontalAlignment: Text.AlignHCenter
+                        verticalAlignment: Text.AlignVCenter
+                    }
+
+                    onClicked: {
+                        if (tab.node) root.removePanel(tab.node.nodeId)
+                    }
+                }
+            }
+        }
+
+        // 底部分隔线
+        Rectangle {
+            anchors.left: parent.left
+            anchors.right: parent.right
+            anchors.bottom: parent.bottom
+            height: 1
+            color: "#3c3c3c"
+        }
+    }
+
+    // ========================================================================
+    // UI组件：当前标签内容（只加载一个子节点）
+    // ========================================================================
+
+    Loader {
+        id: contentLoader
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.top: tabBar.bottom
+        anchors.bottom: parent.bottom
+
+        sourceComponent: root.isPanelNode(root.currentNode) ? panelComponent : null
+        source: root.getChildSource(root.currentNode)
+
+        onLoaded: root.handleContentLoaded()
+
+        // Panel组件模板：切换标签时只改变 panel，宿主负责归还/借用视图
+        Component {
+            id: panelComponent
+            SplitPanelHost {
+                panel: root.currentNode
+                viewPool: root.viewPool
+            }
+        }
+
+        // 监听当前内容的信号
+        Connections {
+            target: contentLoader.item
+            enabled: contentLoader.item
+
+            function onAddPanel(arg1, arg2) {
+                root.handleAddPanelFromContent(arguments)
+            }
+
+            function onRemovePanel(panelId) {
+                root.removePanel(panelId)
+            }
+        }
+    }
+}
@@ -0,0 +1,802 @@
+/**
+ * @file SplitPanelBench.cpp
+ * @brief 布局引擎基准测试（Qt Test QBENCHMARK）
+ *
+ * 覆盖：
+ *   - addPanel / addPanelAt / removePanel（10 ~ 10000 个面板的树）
+ *   - addPanel 的 Balanced 放置策略（查找最大面板需要遍历整棵树）
+ *   - 面板分离到新窗口再停靠回主窗口（detachNode / closeWindow，节点不重建）
+ *   - 标签页：addPanelAt(Center) 加标签、切换 currentIndex、关闭标签
+ *   - updateSplitRatio（模拟 120Hz 拖动分割条）
+ *   - 布局几何求解：窗口缩放（整树重算）和单个面板比例变化后的增量重算
+ *   - saveLayout / loadLayout 及文件往返（JSON / 二进制）
+ *   - 加载时压缩：2.1 格式的二分长链（每个面板外包一层单子节点容器）展平为一个 N 叉容器
+ *   - SplitLayoutStore 打开并列出预设（只读索引）
+ *   - 分片异步加载（loadLayoutAsync：总耗时和最长的一次事件循环）
+ *   - findPanel 按节点深度
+ *   - SplitFlatTree 重建（树修改后第一次整树遍历）
+ *   - SplitTreeModel 增量同步（addPanel / removePanel 后的行插入/删除）
+ *   - Logger 吞吐量（同步/异步，文件日志开/关）
+ *   - SplitProfiler 开销（关闭 / 只统计 / 统计 + trace）
+ *
+ * 输出：
+ *   QBENCHMARK 自带的每次迭代耗时，以及每项额外一行 "ns/op, allocs/op"
+ *   分配次数通过替换全局 operator new 统计（含 Qt 内部分配）
+ *
+ * 运行：
+ *   cmake -DSPLITPANEL_BUILD_BENCHMARKS=ON ..
+ *   cmake --build . --target SplitPanelBench
+ *   ./bin/SplitPanelBench                 # 全部
+ *   ./bin/SplitPanelBench addRemovePanel  # 单项
+ */
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "SplitLayoutStore.hpp"
+#include "SplitManager.hpp"
+#include "SplitTreeModel.hpp"
+#include "Logger.hpp"
+#include "SplitProfiler.hpp"
+
+// ============================================================================
+// 分配计数（替换全局 operator new/delete）
+// ============================================================================
+
+namespace {
+std::atomic<quint64> g_allocationCount{0};
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// ============================================================================
+// 辅助工具
+// ============================================================================
+
+/**
+ * 统计一段 QBENCHMARK 的 ns/op 和 allocs/op
+ * QBENCHMARK 会多次执行循环体（预热/校准），按实际执行次数求平均
+ */
+class OpStats {
+public:
+    void start() {
+        m_ops = 0;
+        m_stopped = false;
+        m_allocations = g_allocationCount.load(std::memory_order_relaxed);
+        m_timer.start();
+    }
+
+    void tick(qint64 ops = 1) { m_ops += ops; }
+
+    /**
+     * 结束计时（之后的清理工作不计入结果）
+     */
+    void stop() {
+        m_elapsed = m_timer.nsecsElapsed();
+        m_allocations = g_allocationCount.load(std::memory_order_relaxed) - m_allocations;
+        m_stopped = true;
+    }
+
+    void report() {
+        if (!m_stopped) stop();
+        if (m_ops == 0) return;
+        qInfo("%s/%s: %.1f ns/op, %.2f allocs/op (%lld ops)",
+              QTest::currentTestFunction(),
+              QTest::currentDataTag() ? QTest::currentDataTag() : "",
+              double(m_elapsed) / double(m_ops),
+              double(m_allocations) / double(m_ops),
+              m_ops);
+    }
+
+private:
+    QElapsedTimer m_timer;
+    quint64 m_allocations = 0;  // start() 时为起始计数，stop() 后为差值
+    qint64 m_elapsed = 0;
+    qint64 m_ops = 0;
+    bool m_stopped = false;
+};
+
+QString panelId(int index)
+{
+    return QStringLiteral("panel_%1").arg(index);
+}
+
+/**
+ * 构建接近平衡的树：第 i 个面板分割第 (i-1)/2 个面板，方向交替
+ * 深度约为 2*log2(N)，避免 addPanel 总是分割最右侧面板形成的长链
+ */
+void buildBalancedTree(SplitManager& manager, int panelCount)
+{
+    manager.addPanel(panelId(0), QStringLiteral("Panel 0"));
+    for (int i = 1; i < panelCount; ++i) {
+        manager.addPanelAt(panelId(i), QStringLiteral("Panel %1").arg(i), QString(),
+                           panelId((i - 1) / 2),
+                           (i % 2) ? SplitManager::Right : SplitManager::Bottom);
+    }
+}
+
+/**
+ * 构建长链：第 i 个面板分割第 i-1 个面板，方向交替，第 i 个面板位于深度 i 附近
+ * （同方向的连续分割会被合并为一个 N 叉容器，方向交替才能得到真正的长链）
+ */
+void buildChainTree(SplitManager& manager, int panelCount)
+{
+    manager.addPanel(panelId(0), QStringLiteral("Panel 0"));
+    for (int i = 1; i < panelCount; ++i) {
+        manager.addPanelAt(panelId(i), QStringLiteral("Panel %1").arg(i), QString(),
+                           panelId(i - 1), (i % 2) ? SplitManager::Right : SplitManager::Bottom);
+    }
+}
+
+/**
+ * 构造 2.1 格式（first/second）的同方向二分长链，每个面板外包一层只有一个子节点的容器
+ * 加载后应压缩为一个有 panelCount 个子节点的容器（自底向上构造，不递归）
+ */
+QVariantMap buildLegacyChainLayout(int panelCount)
+{
+    auto wrapped = [](int index) {
+        const QVariantMap panel{
+            {"type", "panel"},
+            {"id", panelId(index)},
+            {"title", QStringLiteral("Panel %1").arg(index)}
+        };
+        return QVariantMap{
+            {"type", "container"},
+            {"id", QStringLiteral("wrap_%1").arg(index)},
+            {"orientation", "horizontal"},
+            {"first", panel}
+        };
+    };
+
+    QVariantMap node = wrapped(panelCount - 1);
+    for (int i = panelCount - 2; i >= 0; --i) {
+        node = QVariantMap{
+            {"type", "container"},
+            {"id", QStringLiteral("chain_%1").arg(i)},
+            {"orientation", "vertical"},
+            {"splitRatio", 1.0 / (panelCount - i)},
+            {"first", wrapped(i)},
+            {"second", node}
+        };
+    }
+    return QVariantMap{{"version", "2.1"}, {"root", node}};
+}
+
+void addTreeSizeRows()
+{
+    QTest::addColumn<int>("panelCount");
+    for (int count : {10, 100, 1000, 10000}) {
+        QTest::newRow(qPrintable(QString::number(count))) << count;
+    }
+}
+
+/**
+ * Logger 吞吐测试期间丢弃控制台输出（只测格式化和文件写入本身）
+ */
+void discardMessages(QtMsgType, const QMessageLogContext&, const QString&) {}
+
+} // namespace
+
+// ============================================================================
+// 基准测试
+// ============================================================================
+
+class SplitPanelBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // 树结构修改
+    void addRemovePanel_data() { addTreeSizeRows(); }
+    void addRemovePanel();
+    void addPanelAtRemove_data() { addTreeSizeRows(); }
+    void addPanelAtRemove();
+    void addPanelBalanced_data() { addTreeSizeRows(); }
+    void addPanelBalanced();
+    void detachRedockPanel_data() { addTreeSizeRows(); }
+    void detachRedockPanel();
+    void addSwitchTab_data() { addTreeSizeRows(); }
+    void addSwitchTab();
+
+    // 撤销/重做
+    void undoRedoInsert_data() { addTreeSizeRows(); }
+    void undoRedoInsert();
+
+    // 拖动分割条
+    void updateSplitRatioDrag_data() { addTreeSizeRows(); }
+    void updateSplitRatioDrag();
+
+    // 几何求解
+    void solveLayoutResize_data() { addTreeSizeRows(); }
+    void solveLayoutResize();
+    void solveLayoutIncremental_data() { addTreeSizeRows(); }
+    void solveLayoutIncremental();
+
+    // 序列化
+    void saveLayout_data() { addTreeSizeRows(); }
+    void saveLayout();
+    void loadLayout_data() { addTreeSizeRows(); }
+    void loadLayout();
+    void loadLegacyChainLayout_data() { addTreeSizeRows(); }
+    void loadLegacyChainLayout();
+    void applyLayoutDiff_data() { addTreeSizeRows(); }
+    void applyLayoutDiff();
+    void fileRoundTrip_data();
+    void fileRoundTrip();
+    void slicedLoadLayout_data() { addTreeSizeRows(); }
+    void slicedLoadLayout();
+    void layoutStoreOpen_data();
+    void layoutStoreOpen();
+
+    // 查找
+    void findPanelByDepth_data();
+    void findPanelByDepth();
+    void flatTreeBuild_data() { addTreeSizeRows(); }
+    void flatTreeBuild();
+    void treeModelIncremental_data() { addTreeSizeRows(); }
+    void treeModelIncremental();
+
+    // 日志
+    void loggerThroughput_data();
+    void loggerThroughput();
+
+    // 热路径统计
+    void profilerOverhead_data();
+    void profilerOverhead();
+
+private:
+    QTemporaryDir m_tempDir;
+};
+
+void SplitPanelBench::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+
+    // SplitManager 内部的 DEBUG/INFO 日志不计入树操作的耗时
+    Logger::instance()->setLogLevel(Logger::LogLevel::Warning);
+    Logger::instance()->setLogFilePath(m_tempDir.filePath("bench.log"));
+}
+
+void SplitPanelBench::addRemovePanel()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+
+    // 添加后立即删除，保持树的规模不变
+    const QString newId = QStringLiteral("bench_panel");
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.addPanel(newId, QStringLiteral("Bench"));
+        manager.removePanel(newId);
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(manager.panelCount(), panelCount);
+}
+
+void SplitPanelBench::addPanelBalanced()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    manager.setPlacementStrategy(SplitManager::Balanced);
+    for (int i = 0; i < panelCount; ++i) {
+        manager.addPanel(panelId(i), QStringLiteral("Panel %1").arg(i));  // Balanced 策略下建出的是平衡树
+    }
+
+    const QString newId = QStringLiteral("bench_panel");
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.addPanel(newId, QStringLiteral("Bench"));
+        manager.removePanel(newId);
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(manager.panelCount(), panelCount);
+}
+
+void SplitPanelBench::addPanelAtRemove()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+
+    const QString newId = QStringLiteral("bench_panel");
+    const QString targetId = panelId(panelCount / 2);
+    int direction = SplitManager::Left;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.addPanelAt(newId, QStringLiteral("Bench"), QString(), targetId, direction);
+        manager.removePanel(newId);
+        direction = (direction == SplitManager::Bottom) ? SplitManager::Left : direction + 1;
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(manager.panelCount(), panelCount);
+}
+
+void SplitPanelBench::detachRedockPanel()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+
+    const QString nodeId = panelId(panelCount / 2);
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        const QString windowId = manager.detachNode(nodeId);
+        manager.closeWindow(windowId);
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(manager.panelCount(), panelCount);
+    QVERIFY(manager.windowIds().isEmpty());
+}
+
+void SplitPanelBench::addSwitchTab()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+
+    // 先让目标成为标签页，每次迭代：加一个标签（切到新标签）→ 切回第一个 → 关闭新标签
+    const QString targetId = panelId(panelCount / 2);
+    manager.addPanelAt(QStringLiteral("bench_tab0"), QStringLiteral("Tab"), QString(), targetId, SplitManager::Center);
+    ContainerNode* stack = manager.findPanel(targetId)->parentContainer();
+    QVERIFY(stack && stack->orientation() == ContainerNode::Stacked);
+
+    const QString newId = QStringLiteral("bench_tab");
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.addPanelAt(newId, QStringLiteral("Bench"), QString(), targetId, SplitManager::Center);
+        stack->setCurrentIndex(0);
+        manager.removePanel(newId);
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(stack->childCount(), 2);
+    QCOMPARE(manager.panelCount(), panelCount + 1);
+}
+
+void SplitPanelBench::undoRedoInsert()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+
+    // 每次迭代：插入 → 撤销 → 重做 → 撤销，记录和执行都只涉及被修改的容器
+    const QString newId = QStringLiteral("bench_panel");
+    const QString targetId = panelId(panelCount / 2);
+    int direction = SplitManager::Left;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.addPanelAt(newId, QStringLiteral("Bench"), QString(), targetId, direction);
+        manager.undo();
+        manager.redo();
+        manager.undo();
+        direction = (direction == SplitManager::Bottom) ? SplitManager::Left : direction + 1;
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(manager.panelCount(), panelCount);
+}
+
+void SplitPanelBench::updateSplitRatioDrag()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+    QVERIFY(manager.rootNode());
+
+    // 根容器的分割条：每帧一次更新，120 帧往返一次（120Hz 下 1 秒）
+    const QString containerId = manager.rootNode()->nodeId();
+    int frame = 0;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        const double phase = double(frame % 120) / 120.0;
+        manager.updateSplitRatio(containerId, 0.2 + 0.6 * (phase < 0.5 ? phase * 2.0 : 2.0 - phase * 2.0));
+        ++frame;
+        stats.tick();
+    }
+    stats.report();
+}
+
+void SplitPanelBench::solveLayoutResize()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+    QVERIFY(manager.rootNode());
+
+    // 每次迭代窗口宽度变化：所有节点的尺寸都变，整树重算
+    int frame = 0;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.setViewportSize(manager.rootNode(), 1600 + (frame++ % 2), 900);
+        stats.tick();
+    }
+    stats.report();
+    QVERIFY(!manager.rootNode()->layoutRect().isEmpty());
+}
+
+void SplitPanelBench::solveLayoutIncremental()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+    manager.setViewportSize(manager.rootNode(), 1600, 900);
+
+    // 最深处一个容器的比例变化：只重算根到它的路径和它的子树
+    ContainerNode* container = manager.findPanel(panelId(panelCount / 2))->parentContainer();
+    QVERIFY(container);
+    int frame = 0;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        container->setSplitRatio((frame++ % 2) ? 0.4 : 0.6);
+        manager.updateGeometry();
+        stats.tick();
+    }
+    stats.report();
+}
+
+void SplitPanelBench::saveLayout()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        const QVariantMap layout = manager.saveLayout();
+        Q_UNUSED(layout)
+        stats.tick();
+    }
+    stats.report();
+}
+
+void SplitPanelBench::loadLayout()
+{
+    QFETCH(int, panelCount);
+    QVariantMap layout;
+    {
+        SplitManager source;
+        buildBalancedTree(source, panelCount);
+        layout = source.saveLayout();
+    }
+
+    SplitManager manager;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.loadLayout(layout);
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(manager.panelCount(), panelCount);
+}
+
+void SplitPanelBench::loadLegacyChainLayout()
+{
+    QFETCH(int, panelCount);
+    const QVariantMap layout = buildLegacyChainLayout(panelCount);
+
+    SplitManager manager;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.loadLayout(layout);
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(manager.panelCount(), panelCount);
+    const QVariantMap report = manager.lastLoadReport();
+    QCOMPARE(report.value("collapsedContainers").toInt(), panelCount);
+    QCOMPARE(report.value("mergedContainers").toInt(), panelCount - 2);
+}
+
+void SplitPanelBench::applyLayoutDiff()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+
+    // 两个预设只差一个面板：交替应用，每次只有一个容器重新挂接
+    const QVariantMap presetA = manager.saveLayout();
+    manager.addPanelAt(QStringLiteral("bench_panel"), QStringLiteral("Bench"), QString(),
+                       panelId(panelCount / 2), SplitManager::Bottom);
+    const QVariantMap presetB = manager.saveLayout();
+
+    bool toA = true;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.applyLayout(toA ? presetA : presetB);
+        toA = !toA;
+        stats.tick();
+    }
+    stats.report();
+    QVERIFY(manager.panelCount() == panelCount || manager.panelCount() == panelCount + 1);
+}
+
+void SplitPanelBench::fileRoundTrip_data()
+{
+    QTest::addColumn<int>("panelCount");
+    QTest::addColumn<int>("format");
+    for (int count : {10, 100, 1000, 10000}) {
+        QTest::newRow(qPrintable(QString("json/%1").arg(count))) << count << int(SplitManager::JsonFormat);
+        QTest::newRow(qPrintable(QString("binary/%1").arg(count))) << count << int(SplitManager::BinaryFormat);
+    }
+}
+
+void SplitPanelBench::fileRoundTrip()
+{
+    QFETCH(int, panelCount);
+    QFETCH(int, format);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+
+    const QString path = m_tempDir.filePath(QString("roundtrip_%1_%2").arg(format).arg(panelCount));
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.saveLayoutToFile(path, format);
+        manager.loadLayoutFromFile(path);
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(manager.panelCount(), panelCount);
+    qInfo("file size: %lld bytes", QFileInfo(path).size());
+}
+
+void SplitPanelBench::slicedLoadLayout()
+{
+    QFETCH(int, panelCount);
+    const QString path = m_tempDir.filePath(QString("sliced_%1").arg(panelCount));
+    {
+        SplitManager source;
+        buildBalancedTree(source, panelCount);
+        QVERIFY(source.saveLayoutToFile(path, SplitManager::BinaryFormat));
+    }
+
+    // 事件循环每一轮的最长耗时即界面最长的无响应时间（应接近 frameBudget）
+    SplitManager manager;
+    qint64 maxTurnNs = 0;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        QFuture<bool> loaded = manager.loadLayoutAsync(path);
+        while (!loaded.isFinished()) {
+            QElapsedTimer turn;
+            turn.start();
+            QCoreApplication::processEvents();
+            maxTurnNs = qMax(maxTurnNs, turn.nsecsElapsed());
+        }
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(manager.panelCount(), panelCount);
+    qInfo("longest event-loop turn: %.2f ms (frame budget %d ms)",
+          maxTurnNs / 1e6, manager.scheduler()->frameBudget());
+}
+
+void SplitPanelBench::layoutStoreOpen_data()
+{
+    QTest::addColumn<int>("presetCount");
+    for (int count : {10, 100, 1000}) {
+        QTest::newRow(qPrintable(QString::number(count))) << count;
+    }
+}
+
+void SplitPanelBench::layoutStoreOpen()
+{
+    QFETCH(int, presetCount);
+    SplitManager manager;
+    buildBalancedTree(manager, 10);
+
+    // 准备阶段：每次 save 都重写整个文件，预设用 10 个面板的布局，控制准备耗时
+    const QString path = m_tempDir.filePath(QString("presets_%1.splstore").arg(presetCount));
+    {
+        SplitLayoutStore store;
+        store.open(path);
+        for (int i = store.count(); i < presetCount; ++i) {
+            store.save(QStringLiteral("preset_%1").arg(i, 4, 10, QLatin1Char('0')), &manager);
+        }
+    }
+
+    // 打开 + 列出全部元数据，不解析任何布局主体
+    SplitLayoutStore store;
+    QVariantList presets;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        store.open(path);
+        presets = store.presets();
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(presets.size(), presetCount);
+    qInfo("file size: %lld bytes", QFileInfo(path).size());
+}
+
+void SplitPanelBench::findPanelByDepth_data()
+{
+    QTest::addColumn<int>("depth");
+    for (int depth : {1, 10, 100, 1000}) {
+        QTest::newRow(qPrintable(QString("depth%1").arg(depth))) << depth;
+    }
+}
+
+void SplitPanelBench::findPanelByDepth()
+{
+    QFETCH(int, depth);
+    SplitManager manager;
+    buildChainTree(manager, 1000);
+
+    const QString id = panelId(depth - 1);
+    PanelNode* found = nullptr;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        found = manager.findPanel(id);
+        stats.tick();
+    }
+    stats.report();
+    QVERIFY(found);
+}
+
+void SplitPanelBench::flatTreeBuild()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+
+    // 树修改后第一次整树遍历的代价（之后 flatTree() 直接返回缓存）
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        const SplitFlatTree tree(manager.rootNode());
+        stats.tick();
+        QCOMPARE(tree.panelCount(), panelCount);
+    }
+    stats.report();
+}
+
+void SplitPanelBench::treeModelIncremental()
+{
+    QFETCH(int, panelCount);
+    SplitManager manager;
+    buildBalancedTree(manager, panelCount);
+    SplitTreeModel model;
+    model.setManager(&manager);
+
+    // 与 addRemovePanel 相同的操作，外加模型的增量同步（行插入/删除，不重置）
+    int resets = 0;
+    connect(&model, &QAbstractItemModel::modelReset, &model, [&resets]() { ++resets; });
+    const QString newId = QStringLiteral("bench_panel");
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.addPanel(newId, QStringLiteral("Bench"));
+        model.sync();
+        manager.removePanel(newId);
+        model.sync();
+        stats.tick();
+    }
+    stats.report();
+    QCOMPARE(resets, 0);
+}
+
+void SplitPanelBench::loggerThroughput_data()
+{
+    QTest::addColumn<bool>("async");
+    QTest::addColumn<bool>("fileLogging");
+    QTest::newRow("sync/file-off") << false << false;
+    QTest::newRow("sync/file-on") << false << true;
+    QTest::newRow("async/file-off") << true << false;
+    QTest::newRow("async/file-on") << true << true;
+}
+
+void SplitPanelBench::loggerThroughput()
+{
+    QFETCH(bool, async);
+    QFETCH(bool, fileLogging);
+    Logger* logger = Logger::instance();
+
+    logger->setLogLevel(Logger::LogLevel::Info);
+    logger->setFileLoggingEnabled(fileLogging);
+    logger->setAsyncEnabled(async);
+    QtMessageHandler previousHandler = qInstallMessageHandler(discardMessages);
+
+    int sequence = 0;
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        LOG_INFO("Bench", "Panel operation", {{"sequence", sequence}, {"panelId", "bench_panel"}});
+        ++sequence;
+        stats.tick();
+    }
+    stats.stop();
+
+    // 异步模式只计调用方耗时，队列在计时结束后再写完
+    logger->setAsyncEnabled(false);
+    qInstallMessageHandler(previousHandler);
+    stats.report();
+
+    logger->setFileLoggingEnabled(false);
+    logger->setLogLevel(Logger::LogLevel::Warning);
+}
+
+void SplitPanelBench::profilerOverhead_data()
+{
+    QTest::addColumn<bool>("profiling");
+    QTest::addColumn<bool>("trace");
+    QTest::newRow("off") << false << false;
+    QTest::newRow("stats") << true << false;
+    QTest::newRow("stats+trace") << true << true;
+}
+
+void SplitPanelBench::profilerOverhead()
+{
+    QFETCH(bool, profiling);
+    QFETCH(bool, trace);
+    SplitManager manager;
+    buildBalancedTree(manager, 1000);
+
+    SplitProfiler::reset();
+    SplitProfiler::setEnabled(profiling);
+    SplitProfiler::setTraceEnabled(trace);
+
+    // 与 addRemovePanel/1000 相同的操作，差值即为统计开销
+    const QString newId = QStringLiteral("bench_panel");
+    OpStats stats;
+    stats.start();
+    QBENCHMARK {
+        manager.addPanel(newId, QStringLiteral("Bench"));
+        manager.removePanel(newId);
+        stats.tick();
+    }
+    stats.report();
+
+    SplitProfiler::setTraceEnabled(false);
+    SplitProfiler::setEnabled(false);
+    SplitProfiler::reset();
+    QCOMPARE(manager.panelCount(), 1000);
+}
+
+QTEST_GUILESS_MAIN(SplitPanelBench)
+#include "SplitPanelBench.moc"
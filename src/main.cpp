@@ -6,8 +6,11 @@
 #include <QQmlContext>            // QML上下文，用于向QML传递C++对象
 #include <QIcon>                  // 应用程序图标
 #include <QDir>                   // 目录操作
+#include <QJsonDocument>          // 统计信息输出
+#include <QScopeGuard>            // 退出时停止异步日志
 #include "utils/Logger.hpp"       // 日志系统
-#include "models/SplitManager.hpp"  // 停靠管理器
+#include "utils/SplitProfiler.hpp" // 热路径统计
+#include "qml/SplitPanelQml.hpp"    // QML类型注册
 
 /**
  * ============================================================================
@@ -44,6 +47,12 @@ int main(int argc, char *argv[])
     QGuiApplication::setApplicationVersion("1.0.0");
     QGuiApplication::setOrganizationName("SplitPanel");
     
+    // 分离窗口各自在独立的渲染线程中绘制，一个窗口的重绘不阻塞其它窗口
+    // （必须在创建 QGuiApplication 之前设置；环境变量已指定时以其为准，平台不支持时 Qt 自动回退）
+    if (!qEnvironmentVariableIsSet("QSG_RENDER_LOOP")) {
+        qputenv("QSG_RENDER_LOOP", "threaded");
+    }
+    
     QGuiApplication app(argc, argv);
     
     // ========================================
@@ -51,6 +60,10 @@ int main(int argc, char *argv[])
     // ========================================
     Logger::instance()->setLogLevel(Logger::LogLevel::Debug);
     Logger::instance()->setFileLoggingEnabled(true);
+    Logger::instance()->setAsyncEnabled(true);  // 日志由后台线程批量写入，不阻塞GUI线程
+    
+    // 任何退出路径（包括下面加载失败的提前返回）都写完异步队列，不丢失最后的日志
+    const auto stopAsyncLogging = qScopeGuard([] { Logger::instance()->setAsyncEnabled(false); });
     
     QString currentPath = QDir::currentPath();
     QString logPath = Logger::instance()->logFilePath();
@@ -62,23 +75,24 @@ int main(int argc, char *argv[])
     Logger::instance()->info("Application", "Log file path: " + logPath, {});
     Logger::instance()->info("Application", "Architecture: Simplified SplitManager (No ItemModel)", {});
     
+    // 热路径统计：SPLITPANEL_PROFILE=1 开启统计，SPLITPANEL_TRACE=<文件> 同时记录 trace，退出时写出
+    const QString tracePath = qEnvironmentVariable("SPLITPANEL_TRACE");
+    if (!tracePath.isEmpty()) {
+        SplitProfiler::setTraceEnabled(true);
+    } else if (qEnvironmentVariableIntValue("SPLITPANEL_PROFILE") != 0) {
+        SplitProfiler::setEnabled(true);
+    }
+    if (SplitProfiler::isEnabled()) {
+        Logger::instance()->info("Application", "Profiling enabled", {{"trace", tracePath}});
+    }
+    
     // ========================================
     // 3. 注册QML类型
     // ========================================
     Logger::instance()->debug("Application", "Registering QML types...", {});
     
-    // 手动注册C++类型到QML
-    qmlRegisterSingletonType<Logger>("SplitPanel", 1, 0, "Logger", 
-        [](QQmlEngine *engine, QJSEngine *scriptEngine) -> QObject * {
-            Q_UNUSED(engine)
-            Q_UNUSED(scriptEngine)
-            return Logger::instance();
-        });
-    
-    qmlRegisterType<SplitManager>("SplitPanel", 1, 0, "SplitManager");
-    qmlRegisterUncreatableType<SplitPanelNode>("SplitPanel", 1, 0, "SplitPanelNode", "Abstract type");
-    qmlRegisterType<PanelNode>("SplitPanel", 1, 0, "PanelNode");
-    qmlRegisterType<ContainerNode>("SplitPanel", 1, 0, "ContainerNode");
+    // 布局引擎（SplitPanelCore）不含QML注册宏，由QML层统一注册
+    SplitPanelQml::registerTypes("SplitPanel");
     
     Logger::instance()->debug("Application", "QML types registered successfully", {});
     
@@ -130,7 +144,7 @@ int main(int argc, char *argv[])
     
     engine.loadFromModule("SplitPanel", "Main");
     
-
+    
     // ========================================
     // 7. 检查加载结果
     // ========================================
@@ -165,6 +179,17 @@ int main(int argc, char *argv[])
     Logger::instance()->info("Application", "Application exiting with code: " + QString::number(result), {});
     Logger::instance()->info("Application", "========================================", {});
     
+    if (SplitProfiler::isEnabled()) {
+        const QByteArray stats = QJsonDocument::fromVariant(SplitProfiler::stats()).toJson(QJsonDocument::Compact);
+        Logger::instance()->info("Application", "Profiling stats: " + QString::fromUtf8(stats), {});
+        if (!tracePath.isEmpty() && !SplitProfiler::writeTrace(tracePath)) {
+            Logger::instance()->error("Application", "Failed to write trace file: " + tracePath, {});
+        }
+    }
+    
+    // 写完异步队列并停止写入线程，之后（如引擎析构期间）的日志改为同步写入
+    Logger::instance()->setAsyncEnabled(false);
+    
     return result;
 }
 
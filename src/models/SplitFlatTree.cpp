@@ -0,0 +1,182 @@
+/**
+ * @file SplitFlatTree.cpp
+ * @brief 节点树扁平副本实现
+ */
+
+#include "SplitFlatTree.hpp"
+#include <QStringList>
+
+// ============================================================================
+// 构建
+// ============================================================================
+
+void SplitFlatTree::clear()
+{
+    m_nodes.clear();
+    m_sizes.clear();
+    m_strings.clear();
+    m_stringIndex.clear();
+    m_nodeOfString.clear();
+    m_objects.clear();
+    m_panelCount = 0;
+    m_maxDepth = 0;
+}
+
+void SplitFlatTree::build(const SplitPanelNode* root)
+{
+    clear();
+    if (!root) return;
+
+    appendSubtree(root, -1, 0);
+}
+
+void SplitFlatTree::appendSubtree(const SplitPanelNode* node, int parent, int depth)
+{
+    const int index = int(m_nodes.size());
+    m_nodes.append(SplitFlatNode());
+    m_objects.append(const_cast<SplitPanelNode*>(node));
+
+    SplitFlatNode record;
+    record.parent = parent;
+    record.depth = depth;
+    record.id = intern(node->nodeId());
+    record.minSize = node->minSize();
+    record.type = quint8(node->nodeType());
+    m_maxDepth = qMax(m_maxDepth, depth);
+
+    // 外壳查询只在这里进行一次，之后的遍历只读数组
+    if (node->nodeType() == SplitPanelNode::Panel) {
+        const auto* panel = static_cast<const PanelNode*>(node);
+        record.title = intern(panel->title());
+        record.registeredType = SplitPanelTypeRegistry::isRegistered(panel->type());
+        record.content = intern(record.registeredType ? panel->panelType() : panel->qmlSource());
+        ++m_panelCount;
+    } else {
+        const auto* container = static_cast<const ContainerNode*>(node);
+        const QList<qreal> sizes = container->sizes();
+        record.orientation = quint8(container->orientation());
+        record.currentIndex = qMax(0, container->currentIndex());
+        record.childCount = container->childCount();
+        record.firstSize = int(m_sizes.size());
+        for (int i = 0; i < record.childCount; ++i) {
+            m_sizes.append(sizes.value(i));
+        }
+        for (int i = 0; i < record.childCount; ++i) {
+            appendSubtree(container->child(i), index, depth + 1);
+        }
+    }
+
+    record.subtreeEnd = int(m_nodes.size());
+    m_nodes[index] = record;
+    if (m_nodeOfString.size() <= record.id) {
+        m_nodeOfString.resize(record.id + 1, -1);
+    }
+    m_nodeOfString[record.id] = index;
+}
+
+int SplitFlatTree::intern(const QString& str)
+{
+    auto it = m_stringIndex.constFind(str);
+    if (it != m_stringIndex.constEnd()) {
+        return it.value();
+    }
+    const int index = int(m_strings.size());
+    m_strings.append(str);
+    m_stringIndex.insert(str, index);
+    return index;
+}
+
+const QString& SplitFlatTree::emptyString()
+{
+    static const QString empty;
+    return empty;
+}
+
+int SplitFlatTree::indexOf(const QString& id) const
+{
+    const int stringIndex = m_stringIndex.value(id, -1);
+    return (stringIndex >= 0 && stringIndex < m_nodeOfString.size()) ? m_nodeOfString[stringIndex] : -1;
+}
+
+// ============================================================================
+// 整树遍历
+// ============================================================================
+
+QString SplitFlatTree::dump() const
+{
+    QString result;
+    for (int i = 0; i < size(); ++i) {
+        const SplitFlatNode& node = m_nodes[i];
+        const QString indentStr(node.depth * 2, ' ');
+
+        if (node.isPanel()) {
+            result += QString("%1Panel[%2]: %3\n")
+                .arg(indentStr)
+                .arg(id(i))
+                .arg(title(i));
+            continue;
+        }
+
+        QStringList sizes;
+        for (int c = 0; c < node.childCount; ++c) {
+            sizes.append(QString::number(m_sizes[node.firstSize + c]));
+        }
+        result += QString("%1Container[%2]: %3 (sizes: %4)\n")
+            .arg(indentStr)
+            .arg(id(i))
+            .arg(node.orientation == ContainerNode::Horizontal ? "H"
+                 : node.orientation == ContainerNode::Stacked ? "T" : "V")
+            .arg(sizes.join(", "));
+    }
+    return result;
+}
+
+QVariantList SplitFlatTree::panelObjects() const
+{
+    QVariantList panels;
+    panels.reserve(m_panelCount);
+    for (int i = 0; i < size(); ++i) {
+        if (m_nodes[i].isPanel()) {
+            panels.append(QVariant::fromValue(static_cast<PanelNode*>(m_objects[i])));
+        }
+    }
+    return panels;
+}
+
+QVariantMap SplitFlatTree::toVariant(int index) const
+{
+    if (index < 0 || index >= size()) return QVariantMap();
+
+    const SplitFlatNode& node = m_nodes[index];
+    if (node.isPanel()) {
+        QVariantMap map{
+            {"type", "panel"},
+            {"id", id(index)},
+            {"title", title(index)},
+            {"minSize", node.minSize}
+        };
+        map.insert(node.registeredType ? "panelType" : "qmlSource", content(index));
+        return map;
+    }
+
+    QVariantList sizes;
+    QVariantList children;
+    int child = firstChild(index);
+    for (int c = 0; c < node.childCount; ++c, child = nextSibling(child)) {
+        sizes.append(m_sizes[node.firstSize + c]);
+        children.append(toVariant(child));
+    }
+
+    QVariantMap map{
+        {"type", "container"},
+        {"id", id(index)},
+        {"orientation", ContainerNode::orientationName(ContainerNode::Orientation(node.orientation))},
+        {"sizes", sizes},
+        {"minSize", node.minSize},
+        {"children", children}
+    };
+    if (node.orientation == ContainerNode::Stacked) {
+        map.insert("currentIndex", node.currentIndex);
+    }
+    return map;
+}
@@ -0,0 +1,148 @@
+#ifndef SPLIT_FLAT_TREE_HPP
+#define SPLIT_FLAT_TREE_HPP
+
+#include <QHash>
+#include <QString>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+#include "SplitPanelNode.hpp"
+
+/**
+ * 扁平树中的一个节点（纯数据，无虚函数、无 QObject）
+ *
+ * 节点按先序排列：index 的子树占据 [index, subtreeEnd)，
+ * 第一个子节点（如果有）在 index + 1，下一个兄弟节点在 subtreeEnd
+ */
+struct SplitFlatNode {
+    qint32 parent = -1;         // 父节点下标（根为 -1）
+    qint32 subtreeEnd = 0;      // 子树结束下标（不含）
+    qint32 childCount = 0;
+    qint32 depth = 0;
+    qint32 firstSize = 0;       // 容器：在 sizes() 中的起始位置（长度 childCount）
+    qint32 id = -1;             // 字符串表下标
+    qint32 title = -1;          // 面板：标题
+    qint32 content = -1;        // 面板：panelType（已注册类型）或 qmlSource（匿名类型）
+    qint32 currentIndex = 0;    // 标签页容器：当前标签
+    double minSize = 0.0;
+    quint8 type = SplitPanelNode::Panel;
+    quint8 orientation = ContainerNode::Horizontal;
+    bool registeredType = false;    // 面板：content 是 panelType 还是 qmlSource
+
+    bool isPanel() const { return type == SplitPanelNode::Panel; }
+    bool isContainer() const { return type == SplitPanelNode::Container; }
+};
+
+/**
+ * ============================================================================
+ * SplitFlatTree - 节点树的扁平副本（连续数组 + 整数下标 + 字符串表）
+ * ============================================================================
+ *
+ * 作用：
+ *   QObject 节点树（SplitPanelNode）是给 QML 绑定用的外观层；
+ *   统计、调试输出和序列化这类整树只读遍历改为在这份扁平副本上进行：
+ *   节点连续存放、父子关系是整数下标、ID/标题/内容路径只存字符串表下标，
+ *   遍历时没有虚函数调用、qobject_cast 和指针追逐
+ *
+ * 生命周期：
+ *   由 SplitManager::flatTree() 按需构建并缓存，树的可序列化状态
+ *   （结构、比例、方向、当前标签、最小尺寸、标题、面板类型）变化后在下次访问时重建，
+ *   判断依据是根节点的 treeRevision()
+ *
+ * 线程：
+ *   除 object() 外全部是值数据（QVector/QString 隐式共享），
+ *   复制一份后可以交给工作线程编码（saveLayoutAsync）
+ */
+class SplitFlatTree {
+public:
+    SplitFlatTree() = default;
+    explicit SplitFlatTree(const SplitPanelNode* root) { build(root); }
+
+    /**
+     * 从节点树重建（root 为空时得到空树）
+     */
+    void build(const SplitPanelNode* root);
+    void clear();
+
+    bool isEmpty() const { return m_nodes.isEmpty(); }
+    int size() const { return int(m_nodes.size()); }
+    int panelCount() const { return m_panelCount; }
+    int maxDepth() const { return m_maxDepth; }
+
+    const SplitFlatNode& node(int index) const { return m_nodes[index]; }
+    const QVector<SplitFlatNode>& nodes() const { return m_nodes; }
+
+    /**
+     * 全部容器的子节点比例（按容器的 firstSize 取 childCount 个）
+     */
+    const QVector<qreal>& sizes() const { return m_sizes; }
+    qreal childSize(int index, int child) const { return m_sizes[m_nodes[index].firstSize + child]; }
+
+    /**
+     * 字符串表（下标 -1 返回空字符串）
+     */
+    const QString& string(int stringIndex) const {
+        return stringIndex >= 0 ? m_strings[stringIndex] : emptyString();
+    }
+    const QVector<QString>& strings() const { return m_strings; }
+
+    const QString& id(int index) const { return string(m_nodes[index].id); }
+    const QString& title(int index) const { return string(m_nodes[index].title); }
+    const QString& content(int index) const { return string(m_nodes[index].content); }
+
+    /**
+     * 按节点 ID 查下标（不存在返回 -1）
+     */
+    int indexOf(const QString& id) const;
+
+    /**
+     * 第一个子节点 / 下一个兄弟节点（没有时返回 -1）
+     * 遍历子节点：for (int c = firstChild(i); c >= 0; c = nextSibling(c))
+     */
+    int firstChild(int index) const { return m_nodes[index].childCount > 0 ? index + 1 : -1; }
+    int nextSibling(int index) const {
+        const int parent = m_nodes[index].parent;
+        return (parent >= 0 && m_nodes[index].subtreeEnd < m_nodes[parent].subtreeEnd)
+            ? m_nodes[index].subtreeEnd : -1;
+    }
+
+    /**
+     * 对应的 QObject 节点（只在构建所在线程、且树未修改时有效）
+     */
+    SplitPanelNode* object(int index) const { return m_objects[index]; }
+
+    // ========================================================================
+    // 整树遍历（SplitManager 的调试/查询接口使用）
+    // ========================================================================
+
+    /**
+     * 树的文本表示（格式与 SplitManager::dumpTree 相同）
+     */
+    QString dump() const;
+
+    /**
+     * 所有面板节点（先序，QVariant 包装的 PanelNode*）
+     */
+    QVariantList panelObjects() const;
+
+    /**
+     * index 处子树的 QVariantMap（格式与 SplitPanelNode::toVariant 相同）
+     */
+    QVariantMap toVariant(int index = 0) const;
+
+private:
+    static const QString& emptyString();
+    int intern(const QString& str);
+    void appendSubtree(const SplitPanelNode* node, int parent, int depth);
+
+    QVector<SplitFlatNode> m_nodes;
+    QVector<qreal> m_sizes;
+    QVector<QString> m_strings;             // 字符串表（下标 → 字符串）
+    QHash<QString, int> m_stringIndex;      // 字符串 → 下标
+    QVector<qint32> m_nodeOfString;         // 字符串下标 → 以它为 ID 的节点下标（-1 = 不是 ID）
+    QVector<SplitPanelNode*> m_objects;     // 节点下标 → QObject 节点
+    int m_panelCount = 0;
+    int m_maxDepth = 0;
+};
+
+#endif // SPLIT_FLAT_TREE_HPP
@@ -0,0 +1,115 @@
+#include "SplitHistory.hpp"
+#include <utility>
+
+// ============================================================================
+// 记录
+// ============================================================================
+
+void SplitHistory::setLimit(int limit)
+{
+    m_limit = qMax(1, limit);
+    while (m_undo.size() > m_limit) {
+        m_undo.removeFirst();
+    }
+    while (m_redo.size() > m_limit) {
+        m_redo.removeFirst();
+    }
+}
+
+void SplitHistory::record(SplitHistoryCommand command, qint64 now, bool coalesce)
+{
+    const bool withinWindow = coalesce && m_lastRecordTime >= 0
+                              && now - m_lastRecordTime <= CoalesceWindowMs;
+    m_lastRecordTime = coalesce ? now : -1;
+
+    if (m_groupDepth > 0) {
+        if (!coalesceInto(m_group, command)) {
+            m_group.append(std::move(command));
+        }
+        return;
+    }
+
+    m_redo.clear();
+    // 只和单条记录的上一步合并（批量步骤保持原样）
+    if (withinWindow && !m_undo.isEmpty() && m_undo.last().size() == 1
+        && coalesceInto(m_undo.last(), command)) {
+        return;
+    }
+    pushStep(Step{std::move(command)});
+}
+
+void SplitHistory::beginGroup()
+{
+    ++m_groupDepth;
+}
+
+void SplitHistory::endGroup()
+{
+    if (m_groupDepth == 0 || --m_groupDepth > 0) {
+        return;
+    }
+
+    Step group = std::exchange(m_group, Step());
+    if (!group.isEmpty()) {
+        m_redo.clear();
+        pushStep(std::move(group));
+    }
+    m_lastRecordTime = -1;
+}
+
+void SplitHistory::pushStep(Step step)
+{
+    m_undo.append(std::move(step));
+    if (m_undo.size() > m_limit) {
+        m_undo.removeFirst();
+    }
+}
+
+bool SplitHistory::coalesceInto(Step& step, const SplitHistoryCommand& command)
+{
+    if (step.isEmpty() || command.type != SplitHistoryCommand::ResizeContainer) {
+        return false;
+    }
+
+    SplitHistoryCommand& last = step.last();
+    if (last.type != SplitHistoryCommand::ResizeContainer || last.containerId != command.containerId
+        || last.sizesAfter.size() != command.sizesBefore.size()) {
+        return false;
+    }
+
+    // 保留最早的 sizesBefore，只更新 sizesAfter
+    last.sizesAfter = command.sizesAfter;
+    return true;
+}
+
+// ============================================================================
+// 撤销/重做
+// ============================================================================
+
+bool SplitHistory::undo(Step* step)
+{
+    if (m_undo.isEmpty()) return false;
+
+    *step = m_undo.takeLast();
+    m_redo.append(*step);
+    m_lastRecordTime = -1;
+    return true;
+}
+
+bool SplitHistory::redo(Step* step)
+{
+    if (m_redo.isEmpty()) return false;
+
+    *step = m_redo.takeLast();
+    m_undo.append(*step);
+    m_lastRecordTime = -1;
+    return true;
+}
+
+void SplitHistory::clear()
+{
+    m_undo.clear();
+    m_redo.clear();
+    m_group.clear();
+    m_lastRecordTime = -1;
+}
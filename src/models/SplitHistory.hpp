@@ -0,0 +1,142 @@
+#ifndef SPLIT_HISTORY_HPP
+#define SPLIT_HISTORY_HPP
+
+#include <QList>
+#include <QString>
+#include "SplitPanelTypeRegistry.hpp"
+
+/**
+ * 一条撤销记录：只保存被修改的那一处（面板、一个容器、必要时加上它的父容器），
+ * 未受影响的子树按节点 ID 引用，不保存副本
+ *
+ * 各类型使用的字段：
+ *   InsertPanel       - 面板、targetId/direction（重做时原样重放）
+ *                       createdContainerId（包住目标的新容器）或 containerId + sizesBefore（接收面板的已有容器）
+ *   RemovePanel       - 面板、containerId（父容器）+ index + sizesBefore
+ *                       父容器只剩一个子节点被替换时：orientationBefore/containerMinSize、
+ *                       grandParentId/slotIndex/grandParentSizes，兄弟容器被合并时再加 merged*
+ *   ResizeContainer   - containerId + sizesBefore/sizesAfter
+ *   ReorientContainer - containerId + orientationBefore/orientationAfter
+ */
+struct SplitHistoryCommand {
+    enum Type { InsertPanel, RemovePanel, ResizeContainer, ReorientContainer };
+    Type type = ResizeContainer;
+
+    // 面板（InsertPanel / RemovePanel）
+    QString panelId;
+    QString title;
+    SplitPanelType panelType;           // 类型句柄（共享，不复制字符串）
+    double panelMinSize = 0;
+
+    // InsertPanel
+    QString targetId;
+    int direction = 0;
+    QString createdContainerId;         // 为空表示面板插入到已有容器中
+
+    // 被修改的容器
+    QString containerId;
+    QList<qreal> sizesBefore;
+    QList<qreal> sizesAfter;
+    int orientationBefore = 0;
+    int orientationAfter = 0;
+    double containerMinSize = 0;
+    int index = -1;                     // RemovePanel：面板在父容器中的位置
+    QString windowId;                   // RemovePanel：面板所在的分离窗口（为空表示主窗口）
+    bool parentCollapsed = false;       // RemovePanel：父容器被兄弟节点替换后销毁
+
+    // RemovePanel 且 parentCollapsed：父容器原来的位置
+    QString grandParentId;              // 为空表示父容器是根节点
+    int slotIndex = -1;
+    QList<qreal> grandParentSizes;
+
+    // 兄弟节点是与祖父容器同方向的容器、被展开合并时的原状态
+    QString mergedId;
+    int mergedOrientation = 0;
+    double mergedMinSize = 0;
+    QList<qreal> mergedSizes;
+    int mergedChildCount = 0;
+};
+
+/**
+ * ============================================================================
+ * SplitHistory - 撤销/重做栈
+ * ============================================================================
+ *
+ * 作用：
+ *   保存 SplitHistoryCommand 组成的撤销步骤，记录和撤销的开销只与修改本身有关，
+ *   与树的大小无关（不保存整棵树的快照）
+ *
+ * 规则：
+ *   - 一个步骤可包含多条记录（批量修改期间的记录合并为一步，撤销时逆序执行）
+ *   - 同一容器连续的比例调整在 CoalesceWindowMs 内合并为一条（拖动分割条只产生一步）
+ *   - 步骤数超过 limit 时丢弃最早的；新记录会清空重做栈
+ *
+ * 注意：
+ *   只负责存储，记录的执行（修改节点树）由 SplitManager 完成
+ */
+class SplitHistory {
+public:
+    using Step = QList<SplitHistoryCommand>;
+
+    /**
+     * 默认最多保留的步骤数
+     */
+    static constexpr int DefaultLimit = 100;
+
+    /**
+     * 比例调整的合并窗口（毫秒）
+     */
+    static constexpr qint64 CoalesceWindowMs = 500;
+
+    int limit() const { return m_limit; }
+    void setLimit(int limit);
+
+    bool canUndo() const { return !m_undo.isEmpty(); }
+    bool canRedo() const { return !m_redo.isEmpty(); }
+    int undoCount() const { return int(m_undo.size()); }
+    int redoCount() const { return int(m_redo.size()); }
+
+    /**
+     * 添加一条记录
+     * 参数：
+     *   command - 记录
+     *   now - 当前时间（毫秒，用于合并判断）
+     *   coalesce - 是否允许与上一条比例调整合并
+     */
+    void record(SplitHistoryCommand command, qint64 now, bool coalesce = false);
+
+    /**
+     * 开始/结束一个合并步骤（可嵌套，最外层结束时整体入栈）
+     */
+    void beginGroup();
+    void endGroup();
+
+    /**
+     * 取出要撤销/重做的步骤（同时移到另一个栈中）
+     * 返回：栈为空时返回 false
+     */
+    bool undo(Step* step);
+    bool redo(Step* step);
+
+    /**
+     * 清空撤销和重做栈（正在进行的合并步骤也一并丢弃）
+     */
+    void clear();
+
+private:
+    void pushStep(Step step);
+
+    /**
+     * 尝试把比例调整合并到 step 的最后一条记录中
+     */
+    static bool coalesceInto(Step& step, const SplitHistoryCommand& command);
+
+    QList<Step> m_undo;
+    QList<Step> m_redo;
+    Step m_group;                  // 正在进行的合并步骤
+    int m_groupDepth = 0;
+    int m_limit = DefaultLimit;
+    qint64 m_lastRecordTime = -1;  // 上一条可合并记录的时间（-1 = 不可合并）
+};
+
+#endif // SPLIT_HISTORY_HPP
@@ -0,0 +1,23 @@
+/**
+ * @file SplitLayoutCodec.cpp
+ * @brief 布局文件格式识别
+ *
+ * 读写都由 SplitLayoutSerializer 直接在节点树 / 节点描述上完成，这里只按开头字节识别格式
+ */
+
+#include "SplitLayoutCodec.hpp"
+
+// ============================================================================
+// 公开接口
+// ============================================================================
+
+SplitLayoutCodec::Format SplitLayoutCodec::detectFormat(const QByteArray& data)
+{
+    if (data.size() >= 3
+        && static_cast<uchar>(data[0]) == 0xD9
+        && static_cast<uchar>(data[1]) == 0xD9
+        && static_cast<uchar>(data[2]) == 0xF7) {
+        return Binary;
+    }
+    return Json;
+}
@@ -0,0 +1,108 @@
+#ifndef SPLIT_LAYOUT_CODEC_HPP
+#define SPLIT_LAYOUT_CODEC_HPP
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+/**
+ * ============================================================================
+ * SplitLayoutCodec - 布局文件格式
+ * ============================================================================
+ *
+ * 作用：
+ *   定义布局文件的两种格式（常量、字符串表规则、格式识别）
+ *   读写都由 SplitLayoutSerializer 完成：写入直接遍历节点树，读取流式读成节点描述，不经过 QVariantMap
+ *   两种格式，读取时自动识别：
+ *     - JSON：可读、可手工编辑（layout.json）
+ *     - 二进制：CBOR + 字符串表，体积小、解析快（适合服务器同步大量布局）
+ *
+ * 二进制格式（版本 1）：
+ *   tag(55799) [                       ← CBOR 自描述标记，用于格式识别
+ *       1,                             ← 二进制格式版本
+ *       ["type", "id", "panel", ...],  ← 字符串表（所有键 + 重复出现的字符串值）
+ *       { 0: 2, 1: "welcome", ... }    ← 布局主体：键为字符串表下标，
+ *   ]                                     重复字符串值写成 tag(25) 下标
+ *
+ * 说明：
+ *   - 主体格式与 SplitManager::saveLayout 的 QVariantMap 一一对应
+ *   - 整数值的浮点数写成整数，其余浮点数在无损前提下用 float16/float32（读取时都读成数值）
+ *   - 所有方法都是纯函数，可在工作线程中调用
+ */
+class SplitLayoutCodec {
+public:
+    /**
+     * 布局文件格式
+     */
+    enum Format {
+        Json = 0,    // JSON 文本（带缩进）
+        Binary = 1   // CBOR 二进制
+    };
+
+    /**
+     * 识别文件格式
+     * 参数：data - 文件内容（只检查开头几个字节）
+     * 返回：以 CBOR 自描述标记开头时为 Binary，否则为 Json
+     */
+    static Format detectFormat(const QByteArray& data);
+
+    /**
+     * 二进制格式版本号
+     */
+    static constexpr int BinaryFormatVersion = 1;
+    
+    /**
+     * CBOR 自描述标记（RFC 8949），编码后固定为 D9 D9 F7，用于自动识别格式
+     */
+    static constexpr quint64 SelfDescribeTag = 55799;
+    
+    /**
+     * 字符串引用标记（沿用 CBOR stringref 扩展的 tag 25），值为字符串表下标
+     */
+    static constexpr quint64 StringRefTag = 25;
+    
+    /**
+     * 字符串表构建器
+     * 所有 Map 键都进表；字符串值只有出现两次及以上才进表（单次出现写下标反而更长）
+     * 
+     * 用法：
+     *   1. 第一遍遍历：addKey() / countValue()
+     *   2. finalize()
+     *   3. 第二遍遍历：indexOf() 查下标（-1 表示直接写字符串）
+     */
+    class StringTable {
+    public:
+        void addKey(const QString& key) { intern(key); }
+        void countValue(const QString& value) { ++m_valueCounts[value]; }
+        
+        /**
+         * 统计结束：把重复出现的字符串值加入表
+         */
+        void finalize() {
+            for (auto it = m_valueCounts.constBegin(); it != m_valueCounts.constEnd(); ++it) {
+                if (it.value() >= 2) {
+                    intern(it.key());
+                }
+            }
+            m_valueCounts.clear();
+        }
+        
+        int indexOf(const QString& str) const { return m_index.value(str, -1); }
+        const QStringList& strings() const { return m_strings; }
+        
+    private:
+        void intern(const QString& str) {
+            if (!m_index.contains(str)) {
+                m_index.insert(str, m_strings.size());
+                m_strings.append(str);
+            }
+        }
+        
+        QStringList m_strings;              // 下标 → 字符串
+        QHash<QString, int> m_index;        // 字符串 → 下标
+        QHash<QString, int> m_valueCounts;  // 字符串值出现次数（仅统计阶段使用）
+    };
+};
+
+#endif // SPLIT_LAYOUT_CODEC_HPP
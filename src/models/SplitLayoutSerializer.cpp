@@ -0,0 +1,834 @@
+/**
+ * @file SplitLayoutSerializer.cpp
+ * @brief 节点树直接序列化实现
+ */
+
+#include "SplitLayoutSerializer.hpp"
+#include "SplitLayoutCodec.hpp"
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QStringList>
+#include <QtCore/qfloat16.h>
+#include <cmath>
+
+namespace {
+
+// ============================================================================
+// 节点描述（JSON / 二进制读取共用）
+// ============================================================================
+
+/**
+ * 读取过程中收集的节点字段
+ * 二进制格式的键顺序不固定，必须先收集完整再填写描述
+ */
+struct NodeFields {
+    QString type;
+    QString id;
+    QString title;
+    QString panelType;
+    QString qmlSource;
+    QString orientation;
+    bool hasMinSize = false;
+    double minSize = 0.0;
+    bool hasSplitRatio = false;
+    double splitRatio = 0.5;
+    bool hasSizes = false;
+    QList<qreal> sizes;
+    bool hasCurrentIndex = false;
+    int currentIndex = 0;
+    QList<int> children;                  // 2.2：children（描述下标）
+    int first = -1;                       // 2.1 以前：first/second
+    int second = -1;
+};
+
+/**
+ * 先序追加节点描述，并进行两种格式共用的校验
+ *
+ * 用法：进入节点时 begin() 占位（子节点随后追加在它之后），字段读完后 finish() 填写
+ * 校验：ID 为空或重复时读取失败；类型无效的节点连同子树丢弃（与旧版本跳过无效节点一致）
+ */
+class SpecBuilder {
+public:
+    explicit SpecBuilder(SplitLayoutSerializer::LayoutSpec& out) : m_out(out) {}
+
+    int begin() {
+        m_out.nodes.emplace_back();
+        return int(m_out.nodes.size()) - 1;
+    }
+
+    /**
+     * 填写 begin() 占位的描述
+     * 参数：result - 节点下标，节点被丢弃时为 -1
+     * 返回：校验失败时返回 false（error() 给出原因）
+     */
+    bool finish(int index, NodeFields& fields, double defaultMinSize, int* result) {
+        *result = -1;
+        const bool panel = fields.type == "panel";
+        if (!panel && fields.type != "container") {
+            discardFrom(index);
+            ++m_out.skippedNodes;
+            return true;
+        }
+        if (fields.id.isEmpty()) {
+            return fail(QString("Node without id (type=%1)").arg(fields.type));
+        }
+        if (m_out.indexById.contains(fields.id)) {
+            return fail(QString("Duplicate node id: %1").arg(fields.id));
+        }
+
+        SplitLayoutSerializer::NodeSpec& node = m_out.nodes[size_t(index)];
+        node.id = fields.id;
+        node.minSize = fields.hasMinSize ? fields.minSize : defaultMinSize;
+        if (panel) {
+            // 面板的 children/first/second 没有意义：其后追加的都是它的子树
+            discardFrom(index + 1);
+            node.title = fields.title;
+            node.panelType = fields.panelType;
+            node.qmlSource = fields.qmlSource;
+        } else {
+            node.container = true;
+            node.orientation = ContainerNode::orientationFromName(fields.orientation);
+            node.currentIndex = fields.hasCurrentIndex ? fields.currentIndex : 0;
+            if (!fields.children.isEmpty()) {
+                // 无效节点被跳过时长度对不上，setSizes 忽略，保持平分
+                node.children = fields.children;
+                if (fields.hasSizes) node.sizes = fields.sizes;
+            } else {
+                for (int child : {fields.first, fields.second}) {
+                    if (child >= 0) node.children.append(child);
+                }
+                const double ratio = SplitPanelNodeHelpers::validateSplitRatio(
+                    fields.hasSplitRatio ? fields.splitRatio : 0.5);
+                node.sizes = {ratio, 1.0 - ratio};
+            }
+        }
+
+        m_out.indexById.insert(node.id, index);
+        *result = index;
+        return true;
+    }
+
+    const QString& error() const { return m_error; }
+
+private:
+    /**
+     * 丢弃 index 起的描述（先序：都是正在结束的节点的子树）
+     */
+    void discardFrom(int index) {
+        for (int i = index; i < int(m_out.nodes.size()); ++i) {
+            m_out.indexById.remove(m_out.nodes[size_t(i)].id);
+        }
+        m_out.nodes.resize(size_t(index));
+    }
+
+    bool fail(const QString& message) {
+        if (m_error.isEmpty()) m_error = message;
+        return false;
+    }
+
+    SplitLayoutSerializer::LayoutSpec& m_out;
+    QString m_error;
+};
+
+/**
+ * 布局根上 minPanelSize 对节点默认值的影响（与 SplitManager::setMinPanelSize 的约束一致）
+ */
+double effectiveDefaultMinSize(const SplitLayoutSerializer::LayoutSpec& out, double defaultMinSize)
+{
+    return out.hasMinPanelSize ? out.minPanelSize : defaultMinSize;
+}
+
+// ============================================================================
+// JSON / QVariantMap
+// ============================================================================
+
+// 两种 Map 的数组和子对象访问（其余接口 value / contains / toString / toDouble 相同）
+QJsonArray listOf(const QJsonValue& value) { return value.toArray(); }
+QVariantList listOf(const QVariant& value) { return value.toList(); }
+QJsonObject mapOf(const QJsonValue& value) { return value.toObject(); }
+QVariantMap mapOf(const QVariant& value) { return value.toMap(); }
+
+/**
+ * 读取一个节点（递归，QJsonObject 和 QVariantMap 共用）
+ * 参数：result - 节点下标（非对象或类型无效时为 -1）
+ * 返回：校验失败时返回 false
+ */
+template <typename Map>
+bool nodeFromMap(const Map& data, double defaultMinSize, SpecBuilder& builder, int* result)
+{
+    using Value = decltype(data.value(QString()));  // QJsonValue / QVariant
+    const int index = builder.begin();
+
+    NodeFields fields;
+    fields.type = data.value("type").toString();
+    fields.id = data.value("id").toString();
+    fields.title = data.value("title").toString();
+    fields.panelType = data.value("panelType").toString();
+    fields.qmlSource = data.value("qmlSource").toString();
+    fields.orientation = data.value("orientation").toString();
+
+    if (data.contains("minSize")) {
+        fields.hasMinSize = true;
+        fields.minSize = data.value("minSize").toDouble();
+    }
+    if (data.contains("splitRatio")) {
+        fields.hasSplitRatio = true;
+        fields.splitRatio = data.value("splitRatio").toDouble();
+    }
+    if (data.contains("currentIndex")) {
+        fields.hasCurrentIndex = true;
+        fields.currentIndex = data.value("currentIndex").toInt();
+    }
+    if (data.contains("sizes")) {
+        fields.hasSizes = true;
+        for (const Value size : listOf(data.value("sizes"))) {
+            fields.sizes.append(size.toDouble());
+        }
+    }
+
+    if (fields.type == "container") {
+        for (const Value child : listOf(data.value("children"))) {
+            int childIndex = -1;
+            if (!nodeFromMap(mapOf(child), defaultMinSize, builder, &childIndex)) return false;
+            if (childIndex >= 0) fields.children.append(childIndex);
+        }
+        if (data.contains("first")
+            && !nodeFromMap(mapOf(data.value("first")), defaultMinSize, builder, &fields.first)) {
+            return false;
+        }
+        if (data.contains("second")
+            && !nodeFromMap(mapOf(data.value("second")), defaultMinSize, builder, &fields.second)) {
+            return false;
+        }
+    }
+
+    return builder.finish(index, fields, defaultMinSize, result);
+}
+
+/**
+ * 读取整个布局（QJsonObject 和 QVariantMap 共用）
+ */
+template <typename Map>
+bool specFromMap(const Map& layout, double defaultMinSize, SplitLayoutSerializer::LayoutSpec& out,
+                 QString* errorMsg)
+{
+    out.version = layout.value("version").toString();
+
+    if (layout.contains("minPanelSize")) {
+        out.hasMinPanelSize = true;
+        out.minPanelSize = SplitPanelNodeHelpers::validateMinSize(layout.value("minPanelSize").toDouble());
+    }
+
+    if (layout.contains("root")) {
+        out.hasRoot = true;
+        SpecBuilder builder(out);
+        int root = -1;
+        if (!nodeFromMap(mapOf(layout.value("root")), effectiveDefaultMinSize(out, defaultMinSize),
+                         builder, &root)) {
+            if (errorMsg) *errorMsg = builder.error();
+            out.nodes.clear();
+            out.indexById.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// 二进制写入
+// ============================================================================
+
+/**
+ * 扁平树 → CBOR（两遍：先统计字符串表，再流式写出）
+ * 字符串已在 SplitFlatTree 中去重，统计阶段按字符串下标计数，不再逐个哈希
+ */
+class CborTreeWriter {
+public:
+    explicit CborTreeWriter(QByteArray* data) : m_writer(data) {}
+
+    void write(const SplitFlatTree& tree, double minPanelSize) {
+        // 第一遍：字符串表
+        m_table.addKey("version");
+        m_table.addKey("minPanelSize");
+        m_table.countValue(SplitLayoutSerializer::LayoutVersion);
+        if (!tree.isEmpty()) {
+            m_table.addKey("root");
+            collect(tree);
+        }
+        m_table.finalize();
+
+        // 第二遍：tag(55799) [版本, 字符串表, 主体]
+        m_writer.append(QCborTag(SplitLayoutCodec::SelfDescribeTag));
+        m_writer.startArray(3);
+        m_writer.append(qint64(SplitLayoutCodec::BinaryFormatVersion));
+
+        const QStringList& strings = m_table.strings();
+        m_writer.startArray(quint64(strings.size()));
+        for (const QString& str : strings) {
+            m_writer.append(str);
+        }
+        m_writer.endArray();
+
+        m_writer.startMap(tree.isEmpty() ? 2 : 3);
+        writeKey("version");
+        writeString(SplitLayoutSerializer::LayoutVersion);
+        writeKey("minPanelSize");
+        writeNumber(minPanelSize);
+        if (!tree.isEmpty()) {
+            writeKey("root");
+            writeNode(tree, 0);
+        }
+        m_writer.endMap();
+
+        m_writer.endArray();
+    }
+
+private:
+    /**
+     * 统计键和重复出现的值：出现两次以上的值加入字符串表
+     */
+    void collect(const SplitFlatTree& tree) {
+        QVector<int> counts(tree.strings().size(), 0);
+        int panels = 0;
+        int horizontal = 0;
+        int vertical = 0;
+        int stacked = 0;
+
+        m_table.addKey("type");
+        m_table.addKey("id");
+        m_table.addKey("minSize");
+        for (const SplitFlatNode& node : tree.nodes()) {
+            ++counts[node.id];
+            if (node.isPanel()) {
+                ++panels;
+                ++counts[node.title];
+                ++counts[node.content];
+                m_table.addKey("title");
+                m_table.addKey(node.registeredType ? "panelType" : "qmlSource");
+            } else {
+                if (node.orientation == ContainerNode::Stacked) {
+                    ++stacked;
+                    m_table.addKey("currentIndex");
+                } else {
+                    ++(node.orientation == ContainerNode::Horizontal ? horizontal : vertical);
+                }
+                m_table.addKey("orientation");
+                m_table.addKey("sizes");
+                m_table.addKey("children");
+            }
+        }
+
+        const int containers = tree.size() - panels;
+        if (panels >= 2) m_table.addKey("panel");
+        if (containers >= 2) m_table.addKey("container");
+        if (horizontal >= 2) m_table.addKey("horizontal");
+        if (vertical >= 2) m_table.addKey("vertical");
+        if (stacked >= 2) m_table.addKey("stacked");
+        for (int i = 0; i < counts.size(); ++i) {
+            if (counts[i] >= 2) {
+                m_table.addKey(tree.string(i));
+            }
+        }
+    }
+
+    void writeNode(const SplitFlatTree& tree, int index) {
+        const SplitFlatNode& node = tree.node(index);
+        if (node.isPanel()) {
+            m_writer.startMap(5);
+            writeKey("type");
+            writeString("panel");
+            writeKey("id");
+            writeString(tree.id(index));
+            writeKey("title");
+            writeString(tree.title(index));
+            writeKey(node.registeredType ? "panelType" : "qmlSource");
+            writeString(tree.content(index));
+            writeKey("minSize");
+            writeNumber(node.minSize);
+            m_writer.endMap();
+            return;
+        }
+
+        const bool stacked = node.orientation == ContainerNode::Stacked;
+        m_writer.startMap(stacked ? 7 : 6);
+        writeKey("type");
+        writeString("container");
+        writeKey("id");
+        writeString(tree.id(index));
+        writeKey("orientation");
+        writeString(orientationName(node));
+        writeKey("sizes");
+        m_writer.startArray(quint64(node.childCount));
+        for (int i = 0; i < node.childCount; ++i) {
+            writeNumber(tree.childSize(index, i));
+        }
+        m_writer.endArray();
+        writeKey("minSize");
+        writeNumber(node.minSize);
+        if (stacked) {
+            writeKey("currentIndex");
+            m_writer.append(qint64(node.currentIndex));
+        }
+        writeKey("children");
+        m_writer.startArray(quint64(node.childCount));
+        for (int child = tree.firstChild(index); child >= 0; child = tree.nextSibling(child)) {
+            writeNode(tree, child);
+        }
+        m_writer.endArray();
+        m_writer.endMap();
+    }
+
+    void writeKey(const QString& key) {
+        m_writer.append(quint64(m_table.indexOf(key)));
+    }
+
+    void writeString(const QString& str) {
+        const int index = m_table.indexOf(str);
+        if (index >= 0) {
+            m_writer.append(QCborTag(SplitLayoutCodec::StringRefTag));
+            m_writer.append(quint64(index));
+        } else {
+            m_writer.append(str);
+        }
+    }
+
+    /**
+     * 数值编码规则见 SplitLayoutCodec：整数值写整数，其余无损时用 float16/float32
+     */
+    void writeNumber(double value) {
+        if (std::isfinite(value) && value == std::trunc(value) && std::abs(value) < 9007199254740992.0) {
+            m_writer.append(qint64(value));
+            return;
+        }
+        const qfloat16 half(value);
+        if (double(half) == value) {
+            m_writer.append(half);
+            return;
+        }
+        const float single = float(value);
+        if (double(single) == value) {
+            m_writer.append(single);
+            return;
+        }
+        m_writer.append(value);
+    }
+
+    static QString orientationName(const SplitFlatNode& node) {
+        return ContainerNode::orientationName(ContainerNode::Orientation(node.orientation));
+    }
+
+    QCborStreamWriter m_writer;
+    SplitLayoutCodec::StringTable m_table;
+};
+
+// ============================================================================
+// 二进制读取
+// ============================================================================
+
+/**
+ * CBOR → 节点描述（QCborStreamReader 单遍流式读取，不构建 QCborValue / QVariantMap）
+ */
+class CborTreeReader {
+public:
+    CborTreeReader(const QByteArray& data, double defaultMinSize, SplitLayoutSerializer::LayoutSpec& out)
+        : m_reader(data), m_defaultMinSize(defaultMinSize), m_out(out), m_builder(out) {}
+
+    bool read() {
+        if (!m_reader.isTag() || m_reader.toTag() != QCborTag(SplitLayoutCodec::SelfDescribeTag)) {
+            return fail("Malformed binary layout");
+        }
+        m_reader.next();
+        if (!m_reader.isArray() || !m_reader.enterContainer()) {
+            return fail("Malformed binary layout");
+        }
+
+        // 格式版本
+        if (!m_reader.hasNext() || !m_reader.isInteger()) {
+            return fail("Malformed binary layout");
+        }
+        const qint64 version = m_reader.toInteger();
+        m_reader.next();
+        if (version != SplitLayoutCodec::BinaryFormatVersion) {
+            return fail(QString("Unsupported binary layout version: %1").arg(version));
+        }
+
+        // 字符串表
+        if (!m_reader.hasNext() || !m_reader.isArray() || !m_reader.enterContainer()) {
+            return fail("Malformed binary layout");
+        }
+        while (m_reader.hasNext()) {
+            QString str;
+            if (!readText(str)) return false;
+            m_table.append(str);
+        }
+        m_reader.leaveContainer();
+
+        // 布局主体
+        if (!m_reader.hasNext() || !m_reader.isMap() || !m_reader.enterContainer()) {
+            return fail("Malformed binary layout");
+        }
+        while (m_reader.hasNext()) {
+            QString key;
+            if (!readKey(key)) return false;
+
+            if (key == "version") {
+                if (!readString(m_out.version)) return false;
+            } else if (key == "minPanelSize") {
+                if (!readNumber(m_out.minPanelSize)) return false;
+                m_out.minPanelSize = SplitPanelNodeHelpers::validateMinSize(m_out.minPanelSize);
+                m_out.hasMinPanelSize = true;
+            } else if (key == "root") {
+                m_out.hasRoot = true;
+                int root = -1;
+                if (!readNode(&root, effectiveDefaultMinSize(m_out, m_defaultMinSize))) return false;
+            } else {
+                m_reader.next();
+            }
+        }
+        m_reader.leaveContainer();
+        m_reader.leaveContainer();
+
+        if (m_reader.lastError() != QCborError::NoError) {
+            return fail(m_reader.lastError().toString());
+        }
+        return true;
+    }
+
+    const QString& error() const { return m_error; }
+
+private:
+    bool readNode(int* out, double defaultMinSize) {
+        // 非 Map 视为无效节点（与 QVariant::toMap() 得到空 Map 的行为一致）
+        *out = -1;
+        if (!m_reader.isMap()) {
+            m_reader.next();
+            return true;
+        }
+        if (!m_reader.enterContainer()) return fail("Malformed binary layout");
+
+        const int index = m_builder.begin();
+        NodeFields fields;
+        while (m_reader.hasNext()) {
+            QString key;
+            if (!readKey(key)) return false;
+
+            bool ok = true;
+            if (key == "type") {
+                ok = readString(fields.type);
+            } else if (key == "id") {
+                ok = readString(fields.id);
+            } else if (key == "title") {
+                ok = readString(fields.title);
+            } else if (key == "panelType") {
+                ok = readString(fields.panelType);
+            } else if (key == "qmlSource") {
+                ok = readString(fields.qmlSource);
+            } else if (key == "orientation") {
+                ok = readString(fields.orientation);
+            } else if (key == "minSize") {
+                ok = readNumber(fields.minSize);
+                fields.hasMinSize = true;
+            } else if (key == "splitRatio") {
+                ok = readNumber(fields.splitRatio);
+                fields.hasSplitRatio = true;
+            } else if (key == "currentIndex") {
+                double index = 0.0;
+                ok = readNumber(index);
+                fields.currentIndex = int(index);
+                fields.hasCurrentIndex = true;
+            } else if (key == "sizes") {
+                ok = readNumberArray(fields.sizes);
+                fields.hasSizes = true;
+            } else if (key == "children") {
+                ok = readNodeArray(fields.children, defaultMinSize);
+            } else if (key == "first") {
+                ok = readNode(&fields.first, defaultMinSize);
+            } else if (key == "second") {
+                ok = readNode(&fields.second, defaultMinSize);
+            } else {
+                m_reader.next();
+            }
+            if (!ok) return false;
+        }
+        if (!m_reader.leaveContainer()) return fail("Malformed binary layout");
+
+        return m_builder.finish(index, fields, defaultMinSize, out) || fail(m_builder.error());
+    }
+
+    bool readNodeArray(QList<int>& out, double defaultMinSize) {
+        if (!m_reader.isArray() || !m_reader.enterContainer()) return fail("Expected array");
+        while (m_reader.hasNext()) {
+            int node = -1;
+            if (!readNode(&node, defaultMinSize)) return false;
+            if (node >= 0) out.append(node);
+        }
+        if (!m_reader.leaveContainer()) return fail("Malformed binary layout");
+        return true;
+    }
+
+    bool readNumberArray(QList<qreal>& out) {
+        if (!m_reader.isArray() || !m_reader.enterContainer()) return fail("Expected array");
+        while (m_reader.hasNext()) {
+            double value = 0.0;
+            if (!readNumber(value)) return false;
+            out.append(value);
+        }
+        if (!m_reader.leaveContainer()) return fail("Malformed binary layout");
+        return true;
+    }
+
+    bool readKey(QString& out) {
+        if (m_reader.isUnsignedInteger()) {
+            const quint64 index = m_reader.toUnsignedInteger();
+            m_reader.next();
+            return lookup(index, out);
+        }
+        if (m_reader.isString()) {
+            return readText(out);
+        }
+        return fail("Invalid map key");
+    }
+
+    bool readString(QString& out) {
+        if (m_reader.isTag() && m_reader.toTag() == QCborTag(SplitLayoutCodec::StringRefTag)) {
+            m_reader.next();
+            if (!m_reader.isUnsignedInteger()) return fail("Invalid string reference");
+            const quint64 index = m_reader.toUnsignedInteger();
+            m_reader.next();
+            return lookup(index, out);
+        }
+        return readText(out);
+    }
+
+    bool readText(QString& out) {
+        if (!m_reader.isString()) return fail("Expected string");
+
+        out.clear();
+        auto chunk = m_reader.readString();
+        while (chunk.status == QCborStreamReader::Ok) {
+            out += chunk.data;
+            chunk = m_reader.readString();
+        }
+        if (chunk.status == QCborStreamReader::Error) return fail("Malformed string");
+        return true;
+    }
+
+    bool readNumber(double& out) {
+        if (m_reader.isInteger()) {
+            out = double(m_reader.toInteger());
+        } else if (m_reader.isFloat16()) {
+            out = double(m_reader.toFloat16());
+        } else if (m_reader.isFloat()) {
+            out = double(m_reader.toFloat());
+        } else if (m_reader.isDouble()) {
+            out = m_reader.toDouble();
+        } else {
+            return fail("Expected number");
+        }
+        m_reader.next();
+        return true;
+    }
+
+    bool lookup(quint64 index, QString& out) {
+        if (index >= quint64(m_table.size())) {
+            return fail(QString("String table index out of range: %1").arg(index));
+        }
+        out = m_table.at(int(index));
+        return true;
+    }
+
+    bool fail(const QString& message) {
+        if (m_error.isEmpty()) m_error = message;
+        return false;
+    }
+
+    QCborStreamReader m_reader;
+    QStringList m_table;
+    double m_defaultMinSize;
+    SplitLayoutSerializer::LayoutSpec& m_out;
+    SpecBuilder m_builder;
+    QString m_error;
+};
+
+} // namespace
+
+// ============================================================================
+// 版本
+// ============================================================================
+
+bool SplitLayoutSerializer::isSupportedVersion(const QString& version)
+{
+    // 2.0 只有 qmlSource；2.1 起已注册类型的面板改写 panelType；2.2 起容器为 N 叉（children + sizes）
+    return version == LayoutVersion || version == QLatin1String("2.1") || version == QLatin1String("2.0");
+}
+
+// ============================================================================
+// 写入
+// ============================================================================
+
+QJsonObject SplitLayoutSerializer::toJson(const SplitPanelNode* root, double minPanelSize)
+{
+    return toJson(SplitFlatTree(root), minPanelSize);
+}
+
+QJsonObject SplitLayoutSerializer::toJson(const SplitFlatTree& tree, double minPanelSize)
+{
+    QJsonObject layout{
+        {"version", LayoutVersion},
+        {"minPanelSize", minPanelSize}
+    };
+    if (!tree.isEmpty()) {
+        layout["root"] = nodeToJson(tree, 0);
+    }
+    return layout;
+}
+
+QJsonObject SplitLayoutSerializer::nodeToJson(const SplitPanelNode* node)
+{
+    return nodeToJson(SplitFlatTree(node), 0);
+}
+
+QJsonObject SplitLayoutSerializer::nodeToJson(const SplitFlatTree& tree, int index)
+{
+    const SplitFlatNode& node = tree.node(index);
+    if (node.isPanel()) {
+        QJsonObject result{
+            {"type", "panel"},
+            {"id", tree.id(index)},
+            {"title", tree.title(index)},
+            {"minSize", node.minSize}
+        };
+        result[node.registeredType ? "panelType" : "qmlSource"] = tree.content(index);
+        return result;
+    }
+
+    QJsonArray sizes;
+    for (int i = 0; i < node.childCount; ++i) {
+        sizes.append(tree.childSize(index, i));
+    }
+    QJsonArray children;
+    for (int child = tree.firstChild(index); child >= 0; child = tree.nextSibling(child)) {
+        children.append(nodeToJson(tree, child));
+    }
+
+    QJsonObject result{
+        {"type", "container"},
+        {"id", tree.id(index)},
+        {"orientation", ContainerNode::orientationName(ContainerNode::Orientation(node.orientation))},
+        {"sizes", sizes},
+        {"minSize", node.minSize},
+        {"children", children}
+    };
+    if (node.orientation == ContainerNode::Stacked) {
+        result["currentIndex"] = node.currentIndex;
+    }
+    return result;
+}
+
+QByteArray SplitLayoutSerializer::toCbor(const SplitPanelNode* root, double minPanelSize)
+{
+    return toCbor(SplitFlatTree(root), minPanelSize);
+}
+
+QByteArray SplitLayoutSerializer::toCbor(const SplitFlatTree& tree, double minPanelSize)
+{
+    QByteArray data;
+    CborTreeWriter writer(&data);
+    writer.write(tree, minPanelSize);
+    return data;
+}
+
+// ============================================================================
+// 读取
+// ============================================================================
+
+bool SplitLayoutSerializer::readSpec(const QByteArray& data, double defaultMinSize, LayoutSpec& out,
+                                     QString* errorMsg)
+{
+    bool ok = false;
+    if (SplitLayoutCodec::detectFormat(data) == SplitLayoutCodec::Binary) {
+        ok = specFromCbor(data, defaultMinSize, out, errorMsg);
+    } else {
+        QJsonParseError parseError;
+        const QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+        if (parseError.error != QJsonParseError::NoError) {
+            if (errorMsg) *errorMsg = parseError.errorString();
+            return false;
+        }
+        if (!doc.isObject()) {
+            if (errorMsg) *errorMsg = "JSON root is not an object";
+            return false;
+        }
+        ok = specFromJson(doc.object(), defaultMinSize, out, errorMsg);
+    }
+    if (ok && !isSupportedVersion(out.version)) {
+        if (errorMsg) *errorMsg = QString("Incompatible layout version: %1").arg(out.version);
+        return false;
+    }
+    return ok;
+}
+
+bool SplitLayoutSerializer::specFromJson(const QJsonObject& layout, double defaultMinSize, LayoutSpec& out,
+                                         QString* errorMsg)
+{
+    return specFromMap(layout, defaultMinSize, out, errorMsg);
+}
+
+bool SplitLayoutSerializer::specFromVariant(const QVariantMap& layout, double defaultMinSize, LayoutSpec& out,
+                                            QString* errorMsg)
+{
+    return specFromMap(layout, defaultMinSize, out, errorMsg);
+}
+
+bool SplitLayoutSerializer::specFromCbor(const QByteArray& data, double defaultMinSize, LayoutSpec& out,
+                                         QString* errorMsg)
+{
+    CborTreeReader reader(data, defaultMinSize, out);
+    if (!reader.read()) {
+        if (errorMsg) *errorMsg = reader.error();
+        out.nodes.clear();
+        out.indexById.clear();
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// 创建节点
+// ============================================================================
+
+std::unique_ptr<SplitPanelNode> SplitLayoutSerializer::buildNode(const NodeSpec& spec,
+                                                                 std::vector<std::unique_ptr<SplitPanelNode>>& built,
+                                                                 QObject* owner, SplitPanelTypeRegistry& types)
+{
+    if (!spec.container) {
+        auto panel = std::make_unique<PanelNode>(spec.id, spec.title, owner);
+        panel->setType(types.resolve(spec.panelType, spec.qmlSource));
+        panel->setMinSize(spec.minSize);
+        return panel;
+    }
+
+    auto container = std::make_unique<ContainerNode>(spec.id, spec.orientation, owner);
+    container->setMinSize(spec.minSize);
+    for (int child : spec.children) {
+        container->appendChild(std::move(built[size_t(child)]));
+    }
+    container->setSizes(spec.sizes);
+    container->setCurrentIndex(spec.currentIndex);
+    return container;
+}
+
+std::unique_ptr<SplitPanelNode> SplitLayoutSerializer::buildTree(const LayoutSpec& spec, QObject* owner,
+                                                                 SplitPanelTypeRegistry& types)
+{
+    if (spec.nodes.empty()) return nullptr;
+
+    std::vector<std::unique_ptr<SplitPanelNode>> built(spec.nodes.size());
+    for (int i = int(spec.nodes.size()) - 1; i >= 0; --i) {
+        built[size_t(i)] = buildNode(spec.nodes[size_t(i)], built, owner, types);
+    }
+    return std::move(built.front());
+}
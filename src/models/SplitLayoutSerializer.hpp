@@ -0,0 +1,176 @@
+#ifndef SPLIT_LAYOUT_SERIALIZER_HPP
+#define SPLIT_LAYOUT_SERIALIZER_HPP
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QVariantMap>
+#include <memory>
+#include <vector>
+#include "SplitFlatTree.hpp"
+#include "SplitPanelNode.hpp"
+
+/**
+ * ============================================================================
+ * SplitLayoutSerializer - 节点树直接序列化
+ * ============================================================================
+ *
+ * 作用：
+ *   在节点树和文件内容之间直接转换，不经过中间的 QVariantMap
+ *   saveLayout()/loadLayout() 的 QVariantMap 路径保留给 QML 使用，
+ *   文件读写（saveLayoutToFile/loadLayoutFromFile 及异步版本）走这里
+ *
+ * 对比：
+ *   旧路径：节点 → QVariantMap → QJsonDocument → 字节（加载时反向再来一遍）
+ *   新路径：节点 → QJsonObject / QCborStreamWriter → 字节
+ *           字节 → QJsonObject / QCborStreamReader → LayoutSpec → 节点
+ *
+ * 读取分两步：
+ *   1. readSpec：字节流式读成 LayoutSpec（先序的值数组，不创建 QObject，可在工作线程中进行），
+ *      节点校验（ID 为空或重复时整个布局无效，类型无效的节点连同子树跳过）只在这里进行
+ *   2. buildNode / buildTree：在 GUI 线程按描述创建节点；
+ *      同步加载一次建完，异步加载（SplitManager::loadLayoutAsync）每片创建一个
+ *
+ * 格式：
+ *   与 SplitLayoutCodec 定义的格式完全一致
+ *   二进制读取不依赖键顺序（按字母序写键的写入方会把 type 写在子节点之后）
+ *   节点缺少 minSize 时使用布局的 minPanelSize（两种写入方式都把它写在 root 之前）
+ *   面板内容写成 panelType（已注册类型）或 qmlSource（匿名类型），读取时经注册表解析
+ *
+ * 注意：
+ *   创建得到的节点树尚未注册到 SplitManager，由调用方负责注册
+ *   节点内存来自调用方设置的当前节点池（SplitNodePool::Scope），未设置时走全局分配
+ *   读写节点都必须在节点所在线程（GUI 线程）进行；readSpec 和扁平树版本的写入不接触节点
+ */
+class SplitLayoutSerializer {
+public:
+    /**
+     * 布局版本号（saveLayout / loadLayout 共用）
+     * 2.1：已注册类型的面板写 panelType 而不是 qmlSource
+     * 2.2：容器写 children + sizes（N 个子节点），不再写 first/second + splitRatio
+     */
+    static constexpr const char* LayoutVersion = "2.2";
+
+    /**
+     * 是否可以读取该版本的布局（当前版本及 2.0、2.1）
+     */
+    static bool isSupportedVersion(const QString& version);
+
+    /**
+     * 一个节点的描述（只有值，缺省字段已按布局规则补全）
+     */
+    struct NodeSpec {
+        QString id;
+        bool container = false;
+        QString title;
+        QString panelType;
+        QString qmlSource;
+        double minSize = 0.0;
+        ContainerNode::Orientation orientation = ContainerNode::Horizontal;
+        int currentIndex = 0;                   // 标签页容器的当前标签
+        QList<qreal> sizes;                     // 长度与 children 不一致时忽略（平分）
+        QList<int> children;                    // 子节点在 nodes 中的下标（都在本节点之后）
+    };
+
+    /**
+     * 整个布局的描述
+     */
+    struct LayoutSpec {
+        QString version;                        // 布局版本号
+        bool hasMinPanelSize = false;           // 是否包含 minPanelSize
+        double minPanelSize = 0.0;              // 全局最小面板尺寸（已按 validateMinSize 约束）
+        bool hasRoot = false;                   // 是否包含 root（空布局没有）
+        std::vector<NodeSpec> nodes;            // 先序，nodes[0] 为根（root 无效时为空）
+        QHash<QString, int> indexById;          // 节点 ID → nodes 下标
+        int skippedNodes = 0;                   // 因类型无效被跳过的节点（不含其子树）
+    };
+
+    // ========================================================================
+    // 写入
+    // ========================================================================
+
+    /**
+     * 整个布局转为 QJsonObject
+     * 参数：
+     *   root / tree - 根节点（可为空）或其扁平副本（SplitManager 传入缓存的 flatTree()）
+     *   minPanelSize - 全局最小面板尺寸
+     * 注意：节点版本先构建一份 SplitFlatTree，写入过程只遍历扁平数组
+     */
+    static QJsonObject toJson(const SplitPanelNode* root, double minPanelSize);
+    static QJsonObject toJson(const SplitFlatTree& tree, double minPanelSize);
+
+    /**
+     * 单个节点（递归）转为 QJsonObject，格式与 toVariant() 相同
+     */
+    static QJsonObject nodeToJson(const SplitPanelNode* node);
+    static QJsonObject nodeToJson(const SplitFlatTree& tree, int index);
+
+    /**
+     * 整个布局编码为二进制（CBOR + 字符串表），格式与 SplitLayoutCodec::Binary 相同
+     * 扁平树版本只读值数据，可以在工作线程中调用
+     */
+    static QByteArray toCbor(const SplitPanelNode* root, double minPanelSize);
+    static QByteArray toCbor(const SplitFlatTree& tree, double minPanelSize);
+
+    // ========================================================================
+    // 读取
+    // ========================================================================
+
+    /**
+     * 读取布局文件内容（JSON / 二进制自动识别，线程安全）
+     * 参数：
+     *   data - 文件内容
+     *   defaultMinSize - 布局未提供 minPanelSize 时节点的默认最小尺寸
+     *   out - 输出描述
+     *   errorMsg - 可选的错误信息输出
+     * 返回：成功返回 true；格式损坏、版本不兼容、节点 ID 为空或重复时返回 false
+     */
+    static bool readSpec(const QByteArray& data, double defaultMinSize, LayoutSpec& out,
+                         QString* errorMsg = nullptr);
+
+    /**
+     * 从 QJsonObject 读取描述（参数同 readSpec）
+     */
+    static bool specFromJson(const QJsonObject& layout, double defaultMinSize, LayoutSpec& out,
+                             QString* errorMsg = nullptr);
+
+    /**
+     * 从 QVariantMap 读取描述（SplitManager::loadLayout / applyLayout，格式与 saveLayout() 相同，参数同 readSpec）
+     */
+    static bool specFromVariant(const QVariantMap& layout, double defaultMinSize, LayoutSpec& out,
+                                QString* errorMsg = nullptr);
+
+    /**
+     * 从二进制内容读取描述（QCborStreamReader 单遍流式读取，参数同 readSpec）
+     */
+    static bool specFromCbor(const QByteArray& data, double defaultMinSize, LayoutSpec& out,
+                             QString* errorMsg = nullptr);
+
+    // ========================================================================
+    // 创建节点
+    // ========================================================================
+
+    /**
+     * 按描述创建一个节点
+     * 参数：
+     *   spec - 节点描述
+     *   built - 已创建的节点（下标与 LayoutSpec::nodes 一致），容器从中取走自己的子节点
+     *   owner - 节点的 Qt 父对象（挂到容器后由容器接管）
+     *   types - 面板类型注册表（解析 panelType / qmlSource）
+     * 注意：子节点在描述中位于父节点之后，从后往前创建时子节点总是已经建好
+     */
+    static std::unique_ptr<SplitPanelNode> buildNode(const NodeSpec& spec,
+                                                     std::vector<std::unique_ptr<SplitPanelNode>>& built,
+                                                     QObject* owner, SplitPanelTypeRegistry& types);
+
+    /**
+     * 按描述一次创建整棵树
+     * 返回：根节点（描述为空时为 nullptr）
+     */
+    static std::unique_ptr<SplitPanelNode> buildTree(const LayoutSpec& spec, QObject* owner,
+                                                     SplitPanelTypeRegistry& types);
+};
+
+#endif // SPLIT_LAYOUT_SERIALIZER_HPP
@@ -0,0 +1,199 @@
+/**
+ * @file SplitLayoutSolver.cpp
+ * @brief 节点几何求解实现
+ */
+
+#include "SplitLayoutSolver.hpp"
+#include <QVector>
+
+namespace {
+
+/**
+ * 沿排列方向分配 available：先按比例，低于最小尺寸的子节点固定为最小尺寸，
+ * 剩余空间在其余子节点间按比例重新分配，直到没有子节点低于最小尺寸（每轮至少固定一个，最多 n 轮）
+ */
+QVector<double> distribute(const QList<qreal>& sizes, const QVector<double>& minimums, double available)
+{
+    const int count = minimums.size();
+    QVector<double> shares(count, 1.0);
+    if (sizes.size() == count) {
+        double total = 0.0;
+        for (qreal size : sizes) total += qMax(0.0, double(size));
+        if (total > 0.0) {
+            for (int i = 0; i < count; ++i) shares[i] = qMax(0.0, double(sizes[i]));
+        }
+    }
+
+    QVector<double> extents(count, 0.0);
+    double minimumTotal = 0.0;
+    for (double minimum : minimums) minimumTotal += minimum;
+
+    // 放不下全部最小尺寸：按最小尺寸的比例缩小
+    if (available <= minimumTotal) {
+        for (int i = 0; i < count; ++i) {
+            extents[i] = minimumTotal > 0.0 ? minimums[i] * available / minimumTotal : available / count;
+        }
+        return extents;
+    }
+
+    QVector<bool> fixed(count, false);
+    for (;;) {
+        double remaining = available;
+        double shareTotal = 0.0;
+        for (int i = 0; i < count; ++i) {
+            if (fixed[i]) {
+                remaining -= minimums[i];
+            } else {
+                shareTotal += shares[i];
+            }
+        }
+
+        bool clamped = false;
+        for (int i = 0; i < count; ++i) {
+            if (fixed[i]) continue;
+            const double extent = shareTotal > 0.0 ? remaining * shares[i] / shareTotal : 0.0;
+            if (extent < minimums[i]) {
+                fixed[i] = true;
+                extents[i] = minimums[i];
+                clamped = true;
+            } else {
+                extents[i] = extent;
+            }
+        }
+        if (!clamped) return extents;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// 最小尺寸
+// ============================================================================
+
+QSizeF SplitLayoutSolver::minimumSize(SplitPanelNode* node)
+{
+    if (node->m_minimumRevision == node->treeRevision()) {
+        return node->m_layoutMinimum;
+    }
+
+    const double floor = node->minSize();
+    QSizeF minimum(floor, floor);
+    if (node->nodeType() == SplitPanelNode::Container) {
+        auto* container = static_cast<ContainerNode*>(node);
+        const int count = container->childCount();
+        double width = 0.0;
+        double height = 0.0;
+        if (container->orientation() == ContainerNode::Stacked) {
+            for (int i = 0; i < count; ++i) {
+                const QSizeF child = minimumSize(container->child(i));
+                width = qMax(width, child.width());
+                height = qMax(height, child.height());
+            }
+            height += TabBarHeight;
+        } else {
+            // Vertical：子节点左右排列（宽度求和）；Horizontal：上下排列（高度求和）
+            const bool sideBySide = container->orientation() == ContainerNode::Vertical;
+            const double handles = count > 1 ? HandleSize * (count - 1) : 0.0;
+            for (int i = 0; i < count; ++i) {
+                const QSizeF child = minimumSize(container->child(i));
+                if (sideBySide) {
+                    width += child.width();
+                    height = qMax(height, child.height());
+                } else {
+                    width = qMax(width, child.width());
+                    height += child.height();
+                }
+            }
+            if (sideBySide) {
+                width += handles;
+            } else {
+                height += handles;
+            }
+        }
+        minimum = QSizeF(qMax(floor, width), qMax(floor, height));
+    }
+
+    node->m_minimumRevision = node->treeRevision();
+    if (node->m_layoutMinimum != minimum) {
+        node->m_layoutMinimum = minimum;
+        emit node->layoutGeometryChanged();
+    }
+    return minimum;
+}
+
+// ============================================================================
+// 放置
+// ============================================================================
+
+int SplitLayoutSolver::solve(SplitPanelNode* root, const QSizeF& viewport)
+{
+    if (!root || viewport.isEmpty()) return 0;
+    return place(root, QRectF(QPointF(0, 0), viewport));
+}
+
+int SplitLayoutSolver::relayoutChildren(ContainerNode* container)
+{
+    if (!container || !container->m_layoutRevision) return 0;
+    return placeChildren(container);
+}
+
+int SplitLayoutSolver::place(SplitPanelNode* node, const QRectF& rect)
+{
+    const bool resized = node->m_layoutRect.size() != rect.size();
+    setGeometry(node, rect);
+    if (node->nodeType() != SplitPanelNode::Container) {
+        return 0;
+    }
+
+    // 尺寸和子树都没变：子节点的相对矩形也不会变
+    if (!resized && node->m_layoutRevision == node->treeRevision()) {
+        return 0;
+    }
+    return placeChildren(static_cast<ContainerNode*>(node));
+}
+
+int SplitLayoutSolver::placeChildren(ContainerNode* container)
+{
+    container->m_layoutRevision = container->treeRevision();
+    const int count = container->childCount();
+    if (count == 0) return 1;
+
+    const double width = container->m_layoutRect.width();
+    const double height = container->m_layoutRect.height();
+    int placed = 1;
+
+    if (container->orientation() == ContainerNode::Stacked) {
+        const int current = container->currentIndex();
+        const QRectF content(0.0, TabBarHeight, width, qMax(0.0, height - TabBarHeight));
+        placed += place(container->child(current), content);
+        return placed;
+    }
+
+    const bool sideBySide = container->orientation() == ContainerNode::Vertical;
+    QVector<double> minimums(count);
+    for (int i = 0; i < count; ++i) {
+        const QSizeF minimum = minimumSize(container->child(i));
+        minimums[i] = sideBySide ? minimum.width() : minimum.height();
+    }
+
+    const double extent = sideBySide ? width : height;
+    const double available = qMax(0.0, extent - HandleSize * (count - 1));
+    const QVector<double> extents = distribute(container->previewSizes(), minimums, available);
+
+    double position = 0.0;
+    for (int i = 0; i < count; ++i) {
+        const QRectF rect = sideBySide ? QRectF(position, 0.0, extents[i], height)
+                                       : QRectF(0.0, position, width, extents[i]);
+        placed += place(container->child(i), rect);
+        position += extents[i] + HandleSize;
+    }
+    return placed;
+}
+
+void SplitLayoutSolver::setGeometry(SplitPanelNode* node, const QRectF& rect)
+{
+    if (node->m_layoutRect == rect) return;
+    node->m_layoutRect = rect;
+    SPLITPANEL_PROFILE_NODE_SIGNALS(node->nodeId(), 1);
+    emit node->layoutGeometryChanged();
+}
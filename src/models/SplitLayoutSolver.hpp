@@ -0,0 +1,58 @@
+#ifndef SPLIT_LAYOUT_SOLVER_HPP
+#define SPLIT_LAYOUT_SOLVER_HPP
+
+#include <QRectF>
+#include <QSizeF>
+#include "SplitPanelNode.hpp"
+
+/**
+ * ============================================================================
+ * SplitLayoutSolver - 节点几何求解（一次遍历算出每个节点的矩形）
+ * ============================================================================
+ *
+ * 作用：
+ *   给定视口尺寸，按 sizes（拖动中为 previewSizes）算出每个节点在所在容器中的矩形，
+ *   写入 SplitPanelNode::layoutRect()；QML 绑定结果，窗口缩放和拖动时不再逐个 Loader 执行 JS
+ *
+ * 约束：
+ *   - 子树最小尺寸自底向上汇总：面板为 minSize；分割容器沿排列方向求和（含分割条），
+ *     另一方向取最大值；标签页取最大值并加上标签栏高度；容器自身的 minSize 是下限
+ *   - 分配时先按比例，低于最小尺寸的子节点固定为最小尺寸，剩余空间在其余子节点间按比例重新分配；
+ *     视口小于整体最小尺寸时按最小尺寸的比例缩小（QML 侧会裁剪）
+ *   - 标签页只求解当前标签（切换标签会更新 treeRevision，下次求解时补上）
+ *
+ * 增量：
+ *   节点记录上次求解时的 treeRevision 和尺寸，两者都没变的子树整体跳过；
+ *   最小尺寸按 treeRevision 缓存，同样只在子树修改后重新汇总
+ *
+ * 常量与 QML 保持一致：分割条宽度见 SplitContainerView 的 SplitHandle，
+ * 标签栏高度见 SplitTabStackView
+ */
+class SplitLayoutSolver {
+public:
+    static constexpr double HandleSize = 4.0;
+    static constexpr double TabBarHeight = 28.0;
+
+    /**
+     * 求解整棵树（根节点占据 (0, 0) 起的 viewport）
+     * 返回：重新放置了子节点的节点数（没有变化时为 0）
+     */
+    static int solve(SplitPanelNode* root, const QSizeF& viewport);
+
+    /**
+     * 只重新分配一个容器的子节点（实时拖动时 previewSizes 变化，自身矩形不变）
+     */
+    static int relayoutChildren(ContainerNode* container);
+
+    /**
+     * 子树最小尺寸（按 treeRevision 缓存）
+     */
+    static QSizeF minimumSize(SplitPanelNode* node);
+
+private:
+    static int place(SplitPanelNode* node, const QRectF& rect);
+    static int placeChildren(ContainerNode* container);
+    static void setGeometry(SplitPanelNode* node, const QRectF& rect);
+};
+
+#endif // SPLIT_LAYOUT_SOLVER_HPP
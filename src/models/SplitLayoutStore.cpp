@@ -0,0 +1,404 @@
+/**
+ * @file SplitLayoutStore.cpp
+ * @brief 布局预设库实现
+ */
+
+#include "SplitLayoutStore.hpp"
+#include "SplitManager.hpp"
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+#include "../utils/Logger.hpp"
+
+namespace {
+
+constexpr char StoreMagic[4] = {'S', 'P', 'L', 'S'};
+constexpr double ThumbnailScale = 65535.0;
+
+quint16 toThumbnailUnit(double value)
+{
+    return quint16(qBound<qint64>(0, qRound64(value * ThumbnailScale), 65535));
+}
+
+void prepareStream(QDataStream& stream)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+} // namespace
+
+// ============================================================================
+// 构造/析构
+// ============================================================================
+
+SplitLayoutStore::SplitLayoutStore(QObject* parent)
+    : QObject(parent)
+{
+}
+
+SplitLayoutStore::~SplitLayoutStore()
+{
+    unmap();
+}
+
+// ============================================================================
+// 打开/关闭
+// ============================================================================
+
+bool SplitLayoutStore::open(const QString& filePath)
+{
+    unmap();
+    if (m_filePath != filePath) {
+        m_filePath = filePath;
+        emit filePathChanged();
+    }
+
+    const bool ok = readIndex();
+    if (!ok) {
+        LOG_WARNING("SplitLayoutStore", "Invalid layout store, opened as empty", {{"path", m_filePath}});
+        unmap();
+    }
+    emit presetsChanged();
+    return ok;
+}
+
+void SplitLayoutStore::close()
+{
+    unmap();
+    emit presetsChanged();
+}
+
+void SplitLayoutStore::unmap()
+{
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+    m_mapSize = 0;
+    m_file.close();
+    m_entries.clear();
+    m_indexByName.clear();
+}
+
+bool SplitLayoutStore::readIndex()
+{
+    if (m_filePath.isEmpty() || !QFileInfo::exists(m_filePath)) {
+        return true;  // 空库
+    }
+
+    m_file.setFileName(m_filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    m_mapSize = m_file.size();
+    if (m_mapSize == 0) {
+        return true;
+    }
+    m_map = m_file.map(0, m_mapSize);
+    if (!m_map) {
+        return false;
+    }
+
+    // 只读索引；主体在 layoutData() 中按偏移直接取
+    QDataStream in(QByteArray::fromRawData(reinterpret_cast<const char*>(m_map), qsizetype(m_mapSize)));
+    prepareStream(in);
+
+    char magic[sizeof(StoreMagic)];
+    quint32 version = 0;
+    quint32 entryCount = 0;
+    if (in.readRawData(magic, int(sizeof(magic))) != int(sizeof(magic))
+        || std::memcmp(magic, StoreMagic, sizeof(magic)) != 0) {
+        return false;
+    }
+    in >> version >> entryCount;
+    if (in.status() != QDataStream::Ok || version != FormatVersion) {
+        return false;
+    }
+
+    m_entries.reserve(int(qMin<quint32>(entryCount, 4096)));
+    for (quint32 i = 0; i < entryCount; ++i) {
+        Entry entry;
+        quint16 rectCount = 0;
+        in >> entry.name >> entry.offset >> entry.size >> entry.panelCount >> entry.modified >> rectCount;
+        entry.thumbnail.resize(rectCount);
+        for (ThumbnailRect& rect : entry.thumbnail) {
+            quint8 panel = 0;
+            in >> rect.x >> rect.y >> rect.width >> rect.height >> panel;
+            rect.panel = panel != 0;
+        }
+        // 先比较偏移再比较剩余长度：损坏的索引中 offset + size 可能溢出回绕
+        if (in.status() != QDataStream::Ok || entry.offset > quint64(m_mapSize)
+            || entry.size > quint64(m_mapSize) - entry.offset) {
+            return false;
+        }
+        m_entries.append(std::move(entry));
+    }
+
+    rebuildNameIndex();
+    return true;
+}
+
+void SplitLayoutStore::rebuildNameIndex()
+{
+    m_indexByName.clear();
+    m_indexByName.reserve(m_entries.size());
+    for (int i = 0; i < m_entries.size(); ++i) {
+        m_indexByName.insert(m_entries[i].name, i);
+    }
+}
+
+// ============================================================================
+// 查询（只读索引）
+// ============================================================================
+
+QStringList SplitLayoutStore::names() const
+{
+    QStringList result;
+    result.reserve(m_entries.size());
+    for (const Entry& entry : m_entries) {
+        result.append(entry.name);
+    }
+    return result;
+}
+
+QVariantList SplitLayoutStore::presets() const
+{
+    QVariantList result;
+    result.reserve(m_entries.size());
+    for (const Entry& entry : m_entries) {
+        result.append(entryToVariant(entry));
+    }
+    return result;
+}
+
+QVariantMap SplitLayoutStore::preset(const QString& name) const
+{
+    const int index = m_indexByName.value(name, -1);
+    return index >= 0 ? entryToVariant(m_entries[index]) : QVariantMap();
+}
+
+QVariantMap SplitLayoutStore::entryToVariant(const Entry& entry) const
+{
+    QVariantList thumbnail;
+    thumbnail.reserve(entry.thumbnail.size());
+    for (const ThumbnailRect& rect : entry.thumbnail) {
+        thumbnail.append(QVariantMap{
+            {"x", rect.x / ThumbnailScale},
+            {"y", rect.y / ThumbnailScale},
+            {"width", rect.width / ThumbnailScale},
+            {"height", rect.height / ThumbnailScale},
+            {"panel", rect.panel}
+        });
+    }
+
+    return QVariantMap{
+        {"name", entry.name},
+        {"panelCount", entry.panelCount},
+        {"modified", QDateTime::fromMSecsSinceEpoch(entry.modified)},
+        {"thumbnail", thumbnail}
+    };
+}
+
+// ============================================================================
+// 主体（按需解析）
+// ============================================================================
+
+QByteArray SplitLayoutStore::layoutData(const QString& name) const
+{
+    const int index = m_indexByName.value(name, -1);
+    if (index < 0 || !m_map) {
+        return QByteArray();
+    }
+    const Entry& entry = m_entries[index];
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(m_map + entry.offset), qsizetype(entry.size));
+}
+
+bool SplitLayoutStore::load(const QString& name, SplitManager* manager) const
+{
+    if (!manager) return false;
+
+    // 主体直接从映射区流式读取并差量应用（不解码成 QVariantMap）
+    const QByteArray data = layoutData(name);
+    if (data.isEmpty() || !manager->applyLayoutData(data)) {
+        LOG_WARNING("SplitLayoutStore", "Failed to apply preset", {{"name", name}});
+        return false;
+    }
+
+    LOG_INFO("SplitLayoutStore", "Preset applied", {
+        {"name", name},
+        {"panelCount", QString::number(manager->panelCount())}
+    });
+    return true;
+}
+
+// ============================================================================
+// 修改（重写文件）
+// ============================================================================
+
+bool SplitLayoutStore::save(const QString& name, SplitManager* manager)
+{
+    if (!manager || name.isEmpty() || m_filePath.isEmpty()) return false;
+
+    const SplitFlatTree& tree = manager->flatTree();
+    Entry saved;
+    saved.name = name;
+    saved.panelCount = tree.panelCount();
+    saved.modified = QDateTime::currentMSecsSinceEpoch();
+    saved.thumbnail = buildThumbnail(tree);
+    const QByteArray body = SplitLayoutSerializer::toCbor(tree, manager->minPanelSize());
+
+    // 重写前复制现有主体（随后解除映射）
+    QVector<Entry> entries;
+    QVector<QByteArray> bodies;
+    entries.reserve(m_entries.size() + 1);
+    bodies.reserve(m_entries.size() + 1);
+    bool inserted = false;
+    for (const Entry& entry : std::as_const(m_entries)) {
+        if (!inserted && name <= entry.name) {
+            entries.append(saved);
+            bodies.append(body);
+            inserted = true;
+            if (name == entry.name) continue;
+        }
+        entries.append(entry);
+        bodies.append(QByteArray(reinterpret_cast<const char*>(m_map + entry.offset), qsizetype(entry.size)));
+    }
+    if (!inserted) {
+        entries.append(saved);
+        bodies.append(body);
+    }
+
+    return writeStore(std::move(entries), bodies);
+}
+
+bool SplitLayoutStore::remove(const QString& name)
+{
+    const int removed = m_indexByName.value(name, -1);
+    if (removed < 0) return false;
+
+    QVector<Entry> entries;
+    QVector<QByteArray> bodies;
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (i == removed) continue;
+        const Entry& entry = m_entries[i];
+        entries.append(entry);
+        bodies.append(QByteArray(reinterpret_cast<const char*>(m_map + entry.offset), qsizetype(entry.size)));
+    }
+    return writeStore(std::move(entries), bodies);
+}
+
+bool SplitLayoutStore::writeStore(QVector<Entry> entries, const QVector<QByteArray>& bodies)
+{
+    // 偏移是定长字段：先按 0 写一遍得到索引长度，再写实际偏移
+    QByteArray index;
+    for (int pass = 0; pass < 2; ++pass) {
+        quint64 offset = pass == 0 ? 0 : quint64(index.size());
+        index.clear();
+        QDataStream out(&index, QIODevice::WriteOnly);
+        prepareStream(out);
+        out.writeRawData(StoreMagic, int(sizeof(StoreMagic)));
+        out << FormatVersion << quint32(entries.size());
+        for (int i = 0; i < entries.size(); ++i) {
+            Entry& entry = entries[i];
+            entry.offset = offset;
+            entry.size = quint32(bodies[i].size());
+            out << entry.name << entry.offset << entry.size << entry.panelCount << entry.modified
+                << quint16(entry.thumbnail.size());
+            for (const ThumbnailRect& rect : std::as_const(entry.thumbnail)) {
+                out << rect.x << rect.y << rect.width << rect.height << quint8(rect.panel ? 1 : 0);
+            }
+            offset += entry.size;
+        }
+    }
+
+    // 替换文件前解除映射（Windows 上不能替换仍被映射的文件）
+    unmap();
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    QSaveFile file(m_filePath);
+    bool ok = file.open(QIODevice::WriteOnly) && file.write(index) == index.size();
+    for (int i = 0; ok && i < bodies.size(); ++i) {
+        ok = file.write(bodies[i]) == bodies[i].size();
+    }
+    ok = ok && file.commit();
+    if (!ok) {
+        LOG_ERROR("SplitLayoutStore", "Failed to write layout store", {
+            {"path", m_filePath},
+            {"error", file.errorString()}
+        });
+    }
+
+    // 失败时重新打开原文件
+    if (!readIndex()) {
+        unmap();
+    }
+    emit presetsChanged();
+    return ok;
+}
+
+// ============================================================================
+// 缩略图
+// ============================================================================
+
+QVector<SplitLayoutStore::ThumbnailRect> SplitLayoutStore::buildThumbnail(const SplitFlatTree& tree)
+{
+    QVector<ThumbnailRect> rects;
+    if (tree.isEmpty()) return rects;
+
+    struct Item {
+        int index;
+        double x, y, width, height;
+        int depth;
+    };
+    QVector<Item> stack{{0, 0.0, 0.0, 1.0, 1.0, 0}};
+    while (!stack.isEmpty() && rects.size() < MaxThumbnailRects) {
+        const Item item = stack.takeLast();
+        const SplitFlatNode& node = tree.node(item.index);
+        if (node.isPanel() || node.childCount == 0 || item.depth >= ThumbnailDepth) {
+            rects.append(ThumbnailRect{toThumbnailUnit(item.x), toThumbnailUnit(item.y),
+                                       toThumbnailUnit(item.width), toThumbnailUnit(item.height),
+                                       node.isPanel()});
+            continue;
+        }
+
+        // 标签页只画当前标签，占满整个区域
+        if (node.orientation == ContainerNode::Stacked) {
+            int child = tree.firstChild(item.index);
+            for (int c = 0; c < node.currentIndex && tree.nextSibling(child) >= 0; ++c) {
+                child = tree.nextSibling(child);
+            }
+            stack.append({child, item.x, item.y, item.width, item.height, item.depth + 1});
+            continue;
+        }
+
+        // 按比例切分（Vertical 为左右排列，与 SplitLayoutSolver 一致）；子节点逆序入栈，出栈顺序与树一致
+        double total = 0.0;
+        for (int c = 0; c < node.childCount; ++c) {
+            total += tree.childSize(item.index, c);
+        }
+        const bool sideBySide = node.orientation == ContainerNode::Vertical;
+        QVector<Item> children;
+        children.reserve(node.childCount);
+        double position = 0.0;
+        int c = 0;
+        for (int child = tree.firstChild(item.index); child >= 0; child = tree.nextSibling(child), ++c) {
+            const double share = total > 0.0 ? tree.childSize(item.index, c) / total : 1.0 / node.childCount;
+            if (sideBySide) {
+                children.append({child, item.x + position * item.width, item.y,
+                                 share * item.width, item.height, item.depth + 1});
+            } else {
+                children.append({child, item.x, item.y + position * item.height,
+                                 item.width, share * item.height, item.depth + 1});
+            }
+            position += share;
+        }
+        for (int i = children.size() - 1; i >= 0; --i) {
+            stack.append(children[i]);
+        }
+    }
+    return rects;
+}
@@ -0,0 +1,150 @@
+#ifndef SPLIT_LAYOUT_STORE_HPP
+#define SPLIT_LAYOUT_STORE_HPP
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+
+class SplitManager;
+class SplitFlatTree;
+
+/**
+ * ============================================================================
+ * SplitLayoutStore - 布局预设库（单个带索引的文件，内存映射，按需解析）
+ * ============================================================================
+ *
+ * 作用：
+ *   保存大量命名布局（工作区预设）。打开时只读取索引：
+ *   列出预设和元数据（面板数、修改时间、缩略图矩形）不解析任何布局主体，
+ *   选中某个预设时才读取它的主体
+ *
+ * 文件格式（版本 1，QDataStream 小端）：
+ *   头部：  "SPLS" | quint32 版本 | quint32 条目数
+ *   索引：  每条 QString 名称 | quint64 主体偏移 | quint32 主体长度 | qint32 面板数
+ *           | qint64 修改时间（毫秒）| quint16 矩形数 | 每个矩形 quint16 x, y, w, h（÷65535）+ quint8 是否面板
+ *   主体：  各布局依次存放，格式与 saveLayoutToFile(path, BinaryFormat) 相同（CBOR + 字符串表）
+ *
+ * 读取：
+ *   文件通过 QFile::map 映射，layoutData() 直接返回映射区的视图（不复制）
+ *
+ * 写入：
+ *   save/remove 重写整个文件（QSaveFile 原子替换）后重新映射；
+ *   预设库的修改远少于浏览和切换，读路径保持最简单
+ *
+ * 使用：
+ *   SplitLayoutStore { id: layoutStore }
+ *   layoutStore.open(path)
+ *   layoutStore.save("编辑", splitManager)
+ *   layoutStore.load("编辑", splitManager)    // 按差量应用（SplitManager::applyLayoutData）
+ */
+class SplitLayoutStore : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString filePath READ filePath NOTIFY filePathChanged)
+    Q_PROPERTY(int count READ count NOTIFY presetsChanged)
+    Q_PROPERTY(QStringList names READ names NOTIFY presetsChanged)
+
+public:
+    static constexpr quint32 FormatVersion = 1;
+
+    /**
+     * 缩略图：容器最多展开的层数（更深的子树画成一个矩形）和矩形数上限
+     */
+    static constexpr int ThumbnailDepth = 4;
+    static constexpr int MaxThumbnailRects = 64;
+
+    explicit SplitLayoutStore(QObject* parent = nullptr);
+    ~SplitLayoutStore() override;
+
+    /**
+     * 打开预设库（文件不存在时得到空库，第一次 save 时创建）
+     * 返回：文件存在但格式无效时返回 false（此时库为空）
+     */
+    Q_INVOKABLE bool open(const QString& filePath);
+    Q_INVOKABLE void close();
+
+    QString filePath() const { return m_filePath; }
+    int count() const { return int(m_entries.size()); }
+    QStringList names() const;
+
+    Q_INVOKABLE bool contains(const QString& name) const { return m_indexByName.contains(name); }
+
+    /**
+     * 所有预设的元数据（按名称排序，只读索引，不解析主体）
+     * 返回：[{ name, panelCount, modified, thumbnail: [{ x, y, width, height, panel }] }]
+     *       矩形坐标为 0~1 的比例
+     */
+    Q_INVOKABLE QVariantList presets() const;
+    Q_INVOKABLE QVariantMap preset(const QString& name) const;
+
+    /**
+     * 预设主体（二进制布局）
+     * 返回：映射区的视图，不复制；在下一次 save/remove/close 之前有效，需要保留时复制一份
+     */
+    QByteArray layoutData(const QString& name) const;
+
+    /**
+     * 把预设应用到管理器（SplitManager::applyLayoutData，主体直接从映射区流式读取，未变化的面板原样保留）
+     */
+    Q_INVOKABLE bool load(const QString& name, SplitManager* manager) const;
+
+    /**
+     * 把管理器的当前布局保存为预设（同名覆盖）
+     */
+    Q_INVOKABLE bool save(const QString& name, SplitManager* manager);
+
+    Q_INVOKABLE bool remove(const QString& name);
+
+signals:
+    void filePathChanged();
+    void presetsChanged();
+
+private:
+    struct ThumbnailRect {
+        quint16 x = 0;
+        quint16 y = 0;
+        quint16 width = 0;
+        quint16 height = 0;
+        bool panel = true;
+    };
+
+    struct Entry {
+        QString name;
+        quint64 offset = 0;     // 主体在文件中的偏移
+        quint32 size = 0;       // 主体长度
+        qint32 panelCount = 0;
+        qint64 modified = 0;    // 修改时间（毫秒）
+        QVector<ThumbnailRect> thumbnail;
+    };
+
+    /**
+     * 解除映射并清空索引（不发送信号）
+     */
+    void unmap();
+    bool readIndex();
+    void rebuildNameIndex();
+
+    /**
+     * 按 entries 重写文件（bodies 与 entries 一一对应），成功后重新映射
+     */
+    bool writeStore(QVector<Entry> entries, const QVector<QByteArray>& bodies);
+
+    QVariantMap entryToVariant(const Entry& entry) const;
+    static QVector<ThumbnailRect> buildThumbnail(const SplitFlatTree& tree);
+
+    QString m_filePath;
+    QFile m_file;
+    uchar* m_map = nullptr;
+    qint64 m_mapSize = 0;
+    QVector<Entry> m_entries;               // 按名称排序
+    QHash<QString, int> m_indexByName;      // 名称 → m_entries 下标
+};
+
+#endif // SPLIT_LAYOUT_STORE_HPP
@@ -1,7 +1,9 @@
 #include "SplitManager.hpp"
+#include "SplitLayoutSolver.hpp"
 #include "../utils/Logger.hpp"
 #include <QDebug>
 #include <QFile>
+#include <QCryptographicHash>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QStandardPaths>
@@ -9,29 +11,154 @@
 #include <QTimer>
 #include <QCoreApplication>  // 用于获取应用程序目录路径
 #include <QSettings>          // 用于读取INI配置文件
+#include <QSaveFile>          // 原子写入布局文件
+#include <QPromise>
+#include <QThreadPool>
+#include <QSet>
+#include <algorithm>
+#include <unordered_map>
+#include <utility>            // std::exchange
+#include <vector>
+
+namespace {
+
+/**
+ * 在全局线程池中执行任务并返回 QFuture
+ * 只依赖 QtCore（QPromise + QThreadPool），无需引入 QtConcurrent
+ */
+template<typename T, typename Func>
+QFuture<T> runInBackground(Func func)
+{
+    auto promise = std::make_shared<QPromise<T>>();
+    QFuture<T> future = promise->future();
+    promise->start();
+    QThreadPool::globalInstance()->start([promise, func]() {
+        promise->addResult(func());
+        promise->finish();
+    });
+    return future;
+}
+
+/**
+ * 不可见面板的检查间隔（休眠延迟的精度）
+ */
+constexpr int HibernationCheckIntervalMs = 1000;
+
+/**
+ * 面板的撤销记录（只保存重建面板所需的字段）
+ */
+SplitHistoryCommand makePanelRecord(SplitHistoryCommand::Type type, const PanelNode* panel)
+{
+    SplitHistoryCommand record;
+    record.type = type;
+    record.panelId = panel->nodeId();
+    record.title = panel->title();
+    record.panelType = panel->type();
+    record.panelMinSize = panel->minSize();
+    return record;
+}
+
+/**
+ * applyLayout 中新树的一个节点（与文件加载共用节点描述）
+ */
+using LayoutPatchNode = SplitLayoutSerializer::NodeSpec;
+
+/**
+ * 异步读取布局文件的结果（工作线程 → GUI 线程）
+ */
+struct LayoutReadResult {
+    SplitLayoutSerializer::LayoutSpec spec;
+    QString error;
+    bool ok = false;
+};
+
+} // namespace
+
+/**
+ * 分片进行中的异步加载
+ */
+struct SplitManager::SlicedLoad {
+    QString filePath;
+    std::shared_ptr<QPromise<bool>> promise;
+    SplitLayoutSerializer::LayoutSpec spec;
+    std::vector<std::unique_ptr<SplitPanelNode>> built;  // 下标与 spec.nodes 一致，挂到父容器后为空
+    quint64 generation = 0;               // 加载序号（调度器中的任务据此识别自己的加载）
+    int next = -1;                        // 下一个要创建的节点（从后往前：先序中子节点都在父容器之后）
+    int reportedPercent = 0;              // 上次发送 loadProgressChanged 时的进度
+};
 
 SplitManager::SplitManager(QObject* parent)
     : QObject(parent)
+    , m_nodePool(SplitNodePool::create())
 {
+    m_hibernationTimer = new QTimer(this);
+    m_hibernationTimer->setInterval(HibernationCheckIntervalMs);
+    connect(m_hibernationTimer, &QTimer::timeout, this, &SplitManager::checkHiddenPanels);
+    
+    m_liveResizeTimer = new QTimer(this);
+    m_liveResizeTimer->setSingleShot(true);
+    m_liveResizeTimer->setTimerType(Qt::PreciseTimer);
+    m_liveResizeTimer->setInterval(LiveResizeFrameMs);
+    connect(m_liveResizeTimer, &QTimer::timeout, this, &SplitManager::flushLiveResize);
+    
+    // 几何求解：同一轮事件循环内的多次修改只求解一次
+    m_geometryTimer = new QTimer(this);
+    m_geometryTimer->setSingleShot(true);
+    m_geometryTimer->setInterval(0);
+    connect(m_geometryTimer, &QTimer::timeout, this, &SplitManager::updateGeometry);
+    connect(this, &SplitManager::rootNodeChanged, this, &SplitManager::watchGeometryRoots);
+    connect(this, &SplitManager::windowsChanged, this, &SplitManager::watchGeometryRoots);
+    
+    m_autosaveTimer = new QTimer(this);
+    m_autosaveTimer->setSingleShot(true);
+    connect(m_autosaveTimer, &QTimer::timeout, this, &SplitManager::onAutosaveTimer);
+    // 根节点替换（含批量修改提交）和全局最小尺寸变化，节点内部的修改由根节点的 treeRevisionChanged 通知
+    connect(this, &SplitManager::rootNodeChanged, this, [this]() {
+        if (!m_autosaveEnabled) return;
+        watchAutosaveRoot();
+        markAutosaveDirty();
+    });
+    connect(this, &SplitManager::minPanelSizeChanged, this, &SplitManager::markAutosaveDirty);
+    m_clock.start();
+    
     LOG_INFO("SplitManager", "Manager initialized");
 }
 
+SplitManager::~SplitManager()
+{
+    // 退出时（如 Main.qml 的 onClosing 触发的异步保存）必须等文件写完
+    if (!m_lastSave.isFinished()) {
+        m_lastSave.waitForFinished();
+    }
+    
+    // 池在剩余节点（m_root 及 QObject 子对象）析构完后自行销毁
+    m_nodePool->release();
+}
+
 // ============================================================================
 // 核心 API 实现
 // ============================================================================
 
 PanelNode* SplitManager::createPanel(const QString& title, const QString& qmlSource)
 {
-    QString id = generateNodeId();
-    auto panel = new PanelNode(id, title, this);
-    panel->setQmlSource(qmlSource);
+    QString id = generatePanelId();
+    SplitNodePool::Scope poolScope(m_nodePool);
+    const SplitPanelType type = m_panelTypes.resolve(qmlSource);
+    auto panel = new PanelNode(id, panelTitleFor(type, title), this);
+    panel->setType(type);
+    panel->setMinSize(panelMinSizeFor(type));
     return panel;
 }
 
 bool SplitManager::addPanel(const QString& panelId, const QString& title, const QString& qmlSource)
 {
+    if (!isFreeNodeId(panelId)) {
+        return false;
+    }
+    
     // 【原子操作1】创建面板节点
     auto panel = createPanelNode(panelId, title, qmlSource);
+    SplitHistoryCommand record = makePanelRecord(SplitHistoryCommand::InsertPanel, panel.get());
     
     // 【特殊情况】树为空，面板直接成为根节点
     if (!m_root) {
@@ -39,24 +166,34 @@ bool SplitManager::addPanel(const QString& panelId, const QString& title, const
         setAsRoot(std::move(panel));
         
         LOG_INFO("SplitManager", "Panel set as root");
+        recordHistory(std::move(record));
         emitPanelAddedSignals(panelId);
         return true;
     }
     
-    // 【原子操作2】查找最右侧面板
-    SplitPanelNode* rightmost = findRightmostPanel(m_root.get());
-    if (!rightmost) {
-        LOG_ERROR("SplitManager", "Failed to find rightmost panel");
+    // 【原子操作2】按放置策略查找目标面板（默认最右侧）
+    Direction direction = Direction::Right;
+    SplitPanelNode* target = m_placementStrategy == Balanced
+        ? findLargestPanel(&direction)
+        : findRightmostPanel(m_root.get());
+    if (!target) {
+        LOG_ERROR("SplitManager", "Failed to find target panel");
         return false;
     }
     
     // 【原子操作3】注册面板到映射表
     registerPanel(panelId, panel.get());
+    record.targetId = target->nodeId();
+    record.direction = direction;
     
     // 【原子操作4】在目标位置插入面板
-    bool success = insertPanelAt(std::move(panel), rightmost, Direction::Right);
+    bool success = insertPanelAt(std::move(panel), target, direction, &record);
     if (success) {
+        recordHistory(std::move(record));
         emitPanelAddedSignals(panelId);
+    } else {
+        // 插入失败时面板已随智能指针释放，必须同步清理索引
+        unregisterPanel(panelId);
     }
     
     return success;
@@ -65,8 +202,12 @@ bool SplitManager::addPanel(const QString& panelId, const QString& title, const
 bool SplitManager::addPanelAt(const QString& panelId, const QString& title, const QString& qmlSource,
                                   const QString& targetId, int direction)
 {
+    if (!isFreeNodeId(panelId)) {
+        return false;
+    }
+    
     // 【原子操作1】查找目标节点
-    SplitPanelNode* target = findNode(m_root.get(), targetId);
+    SplitPanelNode* target = findNode(targetId);
     if (!target) {
         LOG_ERROR("SplitManager", QString("Target panel not found: %1").arg(targetId));
         return false;
@@ -74,14 +215,20 @@ bool SplitManager::addPanelAt(const QString& panelId, const QString& title, cons
     
     // 【原子操作2】创建面板节点
     auto panel = createPanelNode(panelId, title, qmlSource);
+    SplitHistoryCommand record = makePanelRecord(SplitHistoryCommand::InsertPanel, panel.get());
+    record.targetId = targetId;
+    record.direction = direction;
     
     // 【原子操作3】注册面板到映射表
     registerPanel(panelId, panel.get());
     
     // 【原子操作4】在目标位置插入面板
-    bool success = insertPanelAt(std::move(panel), target, static_cast<Direction>(direction));
+    bool success = insertPanelAt(std::move(panel), target, static_cast<Direction>(direction), &record);
     if (success) {
+        recordHistory(std::move(record));
         emitPanelAddedSignals(panelId);
+    } else {
+        unregisterPanel(panelId);
     }
     
     return success;
@@ -89,6 +236,8 @@ bool SplitManager::addPanelAt(const QString& panelId, const QString& title, cons
 
 bool SplitManager::removePanel(const QString& panelId)
 {
+    SPLITPANEL_PROFILE_SCOPE(RemovePanel);
+    
     // 【原子操作1】重入保护检查
     static QString currentlyRemoving;
     if (currentlyRemoving == panelId) {
@@ -99,10 +248,39 @@ bool SplitManager::removePanel(const QString& panelId)
     
     LOG_DEBUG("SplitManager", QString("Starting panel removal: %1").arg(panelId));
     
+    SplitHistoryCommand record;
+    const bool success = removePanelNode(panelId, true, m_replayingHistory ? nullptr : &record);
+    if (success) {
+        recordHistory(std::move(record));
+    }
+    
+    currentlyRemoving.clear();
+    return success;
+}
+
+int SplitManager::removePanels(const QStringList& panelIds)
+{
+    // 一次批量修改：QML 只更新一次，撤销为一步
+    Transaction transaction(this);
+    int removed = 0;
+    for (const QString& panelId : panelIds) {
+        if (m_panels.contains(panelId) && removePanel(panelId)) {
+            ++removed;
+        }
+    }
+    
+    LOG_INFO("SplitManager", "Panels removed", {
+        {"requested", QString::number(panelIds.size())},
+        {"removed", QString::number(removed)}
+    });
+    return removed;
+}
+
+bool SplitManager::removePanelNode(const QString& panelId, bool normalize, SplitHistoryCommand* record)
+{
     // 【原子操作2】查找并验证面板
     PanelNode* panel = m_panels.value(panelId, nullptr);
     if (!panel) {
-        currentlyRemoving.clear();
         LOG_ERROR("SplitManager", QString("Panel not found: %1").arg(panelId));
         return false;
     }
@@ -110,48 +288,99 @@ bool SplitManager::removePanel(const QString& panelId)
     LOG_DEBUG("SplitManager", QString("Panel title: %1").arg(panel->title()));
     LOG_DEBUG("SplitManager", QString("Current panel count: %1").arg(m_panels.size()));
     
+    if (record) {
+        *record = makePanelRecord(SplitHistoryCommand::RemovePanel, panel);
+        // 面板或被替换的父容器可能是分离窗口的根：撤销时放回同一个窗口
+        record->windowId = windowOf(panelId);
+    }
+    
     // 【原子操作3】从面板映射中注销
     unregisterPanel(panelId);
     
-    // 【特殊情况】面板直接是根节点（唯一面板）
-    if (panel == m_root.get()) {
-        m_root.reset();
+    // 【特殊情况】面板直接是根节点（所在窗口的唯一面板），分离窗口随之关闭
+    if (!getParentContainer(panel)) {
+        QString windowId;
+        if (std::unique_ptr<SplitPanelNode>* slot = rootSlotOf(panel, &windowId)) {
+            slot->reset();
+        }
+        if (!windowId.isEmpty()) {
+            removeEmptyWindows();
+        }
         finalizePanelRemoval(panelId);
-        currentlyRemoving.clear();
         return true;
     }
     
     // 【原子操作4】获取父容器
     auto* parentContainer = getParentContainer(panel);
     if (!parentContainer) {
-        currentlyRemoving.clear();
         LOG_ERROR("SplitManager", "Panel has no valid parent container");
         return false;
     }
     
-    // 【原子操作5】取出兄弟节点
-    auto [sibling, isFirst] = takeSiblingNode(parentContainer, panel);
-    if (!sibling && parentContainer->firstChild() != panel && parentContainer->secondChild() != panel) {
-        currentlyRemoving.clear();
+    const int panelIndex = parentContainer->indexOf(panel);
+    if (panelIndex < 0) {
         LOG_ERROR("SplitManager", "Panel is not a child of its parent container");
         return false;
     }
     
+    if (record) {
+        record->containerId = parentContainer->nodeId();
+        record->index = panelIndex;
+        record->sizesBefore = parentContainer->sizes();
+    }
+    
+    // 【情况1】父容器还有两个以上的子节点：直接移除面板，空间分给其余子节点
+    if (parentContainer->childCount() > 2) {
+        parentContainer->takeChild(panelIndex);
+        finalizePanelRemoval(panelId);
+        return true;
+    }
+    
+    // 父容器将被销毁：记录它自身和它在祖父容器中的位置
+    if (record) {
+        record->parentCollapsed = true;
+        record->orientationBefore = parentContainer->orientation();
+        record->containerMinSize = parentContainer->minSize();
+        if (ContainerNode* grandParent = getParentContainer(parentContainer)) {
+            record->grandParentId = grandParent->nodeId();
+            record->slotIndex = grandParent->indexOf(parentContainer);
+            record->grandParentSizes = grandParent->sizes();
+        }
+    }
+    
+    // 【原子操作5】取出兄弟节点
+    auto [sibling, isFirst] = takeSiblingNode(parentContainer, panel);
+    
     LOG_DEBUG("SplitManager", QString("Panel is %1 child, sibling %2")
         .arg(isFirst ? "first" : "second")
         .arg(sibling ? "found" : "is null"));
     
-    // 【原子操作6】提升兄弟节点到父容器位置
-    if (!promoteSiblingNode(parentContainer, std::move(sibling))) {
-        currentlyRemoving.clear();
+    // 兄弟容器可能被合并到祖父容器中，先记下它的原状态
+    if (record && sibling && sibling->nodeType() == SplitPanelNode::Container) {
+        const auto* siblingContainer = static_cast<const ContainerNode*>(sibling.get());
+        record->mergedId = siblingContainer->nodeId();
+        record->mergedOrientation = siblingContainer->orientation();
+        record->mergedMinSize = siblingContainer->minSize();
+        record->mergedSizes = siblingContainer->sizes();
+        record->mergedChildCount = siblingContainer->childCount();
+    }
+    
+    // 【原子操作6】提升兄弟节点到父容器位置（与祖父容器同方向时展开合并）
+    if (!promoteSiblingNode(parentContainer, std::move(sibling), normalize)) {
         LOG_ERROR("SplitManager", "Failed to promote sibling node");
         return false;
     }
     
+    // 兄弟容器仍在索引中说明没有被合并
+    if (record && !record->mergedId.isEmpty() && m_nodes.contains(record->mergedId)) {
+        record->mergedId.clear();
+        record->mergedSizes.clear();
+        record->mergedChildCount = 0;
+    }
+    
     // 【原子操作7】完成删除：日志、清理、信号
     // 注意：必须在promoteSiblingNode之后才发送信号，因为此时树结构已重组完成
     finalizePanelRemoval(panelId);
-    currentlyRemoving.clear();
     
     return true;
 }
@@ -163,114 +392,1824 @@ PanelNode* SplitManager::findPanel(const QString& panelId)
 
 bool SplitManager::updateSplitRatio(const QString& containerId, double ratio)
 {
-    SplitPanelNode* node = findNode(m_root.get(), containerId);
+    SplitPanelNode* node = findNode(containerId);
     if (!node || node->nodeType() != SplitPanelNode::Container) {
         return false;
     }
     
-    auto* container = qobject_cast<ContainerNode*>(node);
-    if (container) {
-        container->setSplitRatio(ratio);
-        return true;
+    // nodeType 已确认是容器，无需再做 qobject_cast
+    auto* container = static_cast<ContainerNode*>(node);
+    const QList<qreal> before = container->sizes();
+    container->setSplitRatio(ratio);
+    
+    if (container->sizes() != before) {
+        SplitHistoryCommand record;
+        record.type = SplitHistoryCommand::ResizeContainer;
+        record.containerId = containerId;
+        record.sizesBefore = before;
+        record.sizesAfter = container->sizes();
+        recordHistory(std::move(record), true);
+    }
+    return true;
+}
+
+bool SplitManager::updateSizes(const QString& containerId, const QList<qreal>& sizes)
+{
+    SplitPanelNode* node = findNode(containerId);
+    if (!node || node->nodeType() != SplitPanelNode::Container) {
+        return false;
     }
     
-    return false;
+    auto* container = static_cast<ContainerNode*>(node);
+    const QList<qreal> before = container->sizes();
+    if (container->setSizes(sizes)) {
+        SplitHistoryCommand record;
+        record.type = SplitHistoryCommand::ResizeContainer;
+        record.containerId = containerId;
+        record.sizesBefore = before;
+        record.sizesAfter = container->sizes();
+        recordHistory(std::move(record), true);
+    }
+    return true;
+}
+
+// ============================================================================
+// 实时拖动
+// ============================================================================
+
+bool SplitManager::beginLiveResize(const QString& containerId)
+{
+    SplitPanelNode* node = findNode(containerId);
+    if (!node || node->nodeType() != SplitPanelNode::Container) {
+        return false;
+    }
+    
+    static_cast<ContainerNode*>(node)->beginResize();
+    return true;
+}
+
+void SplitManager::updateLiveResize(const QString& containerId, const QList<qreal>& sizes)
+{
+    SplitPanelNode* node = findNode(containerId);
+    if (!node || node->nodeType() != SplitPanelNode::Container) {
+        return;
+    }
+    
+    auto* container = static_cast<ContainerNode*>(node);
+    if (!container->resizing()) {
+        container->setSizes(sizes);
+        return;
+    }
+    
+    // 同一帧内的多次更新只保留最后一次
+    m_liveResizePending.insert(containerId, sizes);
+    if (!m_liveResizeTimer->isActive()) {
+        m_liveResizeTimer->start();
+    }
+}
+
+bool SplitManager::endLiveResize(const QString& containerId, bool commit)
+{
+    const auto pending = m_liveResizePending.constFind(containerId);
+    const bool hasPending = pending != m_liveResizePending.constEnd();
+    const QList<qreal> pendingSizes = hasPending ? pending.value() : QList<qreal>();
+    m_liveResizePending.remove(containerId);
+    
+    SplitPanelNode* node = findNode(containerId);
+    if (!node || node->nodeType() != SplitPanelNode::Container) {
+        return false;
+    }
+    
+    auto* container = static_cast<ContainerNode*>(node);
+    if (hasPending) {
+        container->setPreviewSizes(pendingSizes);
+    }
+    
+    const QList<qreal> before = container->sizes();
+    if (!container->endResize(commit)) {
+        return false;
+    }
+    
+    // 一次拖动只产生一条记录
+    SplitHistoryCommand record;
+    record.type = SplitHistoryCommand::ResizeContainer;
+    record.containerId = containerId;
+    record.sizesBefore = before;
+    record.sizesAfter = container->sizes();
+    recordHistory(std::move(record));
+    
+    notifyLayoutChanged();
+    return true;
+}
+
+void SplitManager::flushLiveResize()
+{
+    const QHash<QString, QList<qreal>> pending = std::exchange(m_liveResizePending, {});
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        SplitPanelNode* node = findNode(it.key());
+        if (node && node->nodeType() == SplitPanelNode::Container) {
+            auto* container = static_cast<ContainerNode*>(node);
+            container->setPreviewSizes(it.value());
+            // 预览比例不改变 treeRevision：直接重新分配这个容器的子节点
+            SplitLayoutSolver::relayoutChildren(container);
+        }
+    }
+}
+
+// ============================================================================
+// 布局几何
+// ============================================================================
+
+void SplitManager::setViewportSize(SplitPanelNode* root, qreal width, qreal height)
+{
+    QString windowId;
+    if (!root || !rootSlotOf(root, &windowId)) {
+        return;
+    }
+    
+    const QSizeF size(width, height);
+    if (m_viewports.value(windowId) == size && root->layoutRect().size() == size) {
+        return;
+    }
+    m_viewports.insert(windowId, size);
+    
+    // 加载或分离时视口未知的树：第一次上报视口时补做最小尺寸检查
+    if (!size.isEmpty() && m_pendingMinSizeChecks.remove(windowId)) {
+        LoadRepair repair;
+        clampInfeasibleMinSizes(root, size, repair);
+        if (windowId.isEmpty()) {
+            m_lastLoadReport["minSizeCheckDeferred"] = false;
+            m_lastLoadReport["clampedMinSizes"] = repair.clampedMinSizes;
+            m_lastLoadReport["minSizeScale"] = repair.minSizeScale;
+        }
+    }
+    
+    SPLITPANEL_PROFILE_SCOPE(SolveLayout);
+    SplitLayoutSolver::solve(root, size);
+}
+
+void SplitManager::updateGeometry()
+{
+    m_geometryTimer->stop();
+    SPLITPANEL_PROFILE_SCOPE(SolveLayout);
+    
+    const auto viewport = m_viewports.constFind(QString());
+    if (m_root && viewport != m_viewports.constEnd()) {
+        SplitLayoutSolver::solve(m_root.get(), viewport.value());
+    }
+    for (const SplitWindow& window : m_windows) {
+        const auto it = m_viewports.constFind(window.id);
+        if (it != m_viewports.constEnd()) {
+            SplitLayoutSolver::solve(window.root.get(), it.value());
+        }
+    }
+}
+
+void SplitManager::watchGeometryRoots()
+{
+    for (const QMetaObject::Connection& connection : std::as_const(m_geometryConnections)) {
+        QObject::disconnect(connection);
+    }
+    m_geometryConnections.clear();
+    
+    auto watch = [this](SplitPanelNode* root) {
+        m_geometryConnections.append(connect(root, &SplitPanelNode::treeRevisionChanged,
+                                             m_geometryTimer, qOverload<>(&QTimer::start)));
+    };
+    if (m_root) watch(m_root.get());
+    for (const SplitWindow& window : m_windows) {
+        watch(window.root.get());
+    }
+    
+    // 已关闭窗口的视口不再需要
+    for (auto it = m_viewports.begin(); it != m_viewports.end(); ) {
+        const bool alive = it.key().isEmpty()
+            || std::any_of(m_windows.cbegin(), m_windows.cend(),
+                           [&](const SplitWindow& window) { return window.id == it.key(); });
+        it = alive ? std::next(it) : m_viewports.erase(it);
+    }
+    for (auto it = m_pendingMinSizeChecks.begin(); it != m_pendingMinSizeChecks.end(); ) {
+        const bool alive = it->isEmpty()
+            || std::any_of(m_windows.cbegin(), m_windows.cend(),
+                           [&](const SplitWindow& window) { return window.id == *it; });
+        it = alive ? std::next(it) : m_pendingMinSizeChecks.erase(it);
+    }
+    m_geometryTimer->start();
 }
 
 void SplitManager::clear()
 {
+    // 重置也取代进行中的异步加载（否则读取完成后会覆盖清空的结果）
+    cancelSlicedLoad();
+    
+    const bool hadWindows = !m_windows.empty();
+    m_windows.clear();
     m_root.reset();
     m_panels.clear();
-    
-    emit rootNodeChanged();
-    emit panelCountChanged();
-    emit layoutChanged();
+    m_nodes.clear();
+    m_panelVisibility.clear();
+    m_panelStates.clear();
+    m_hibernationTimer->stop();
+    m_liveResizePending.clear();
+    m_liveResizeTimer->stop();
+    clearHistory();
+    
+    // 树已全部释放：slab 整体回卷，下一棵树重新从头连续分配
+    m_nodePool->reset();
+    
+    notifyRootNodeChanged();
+    if (hadWindows) {
+        notifyWindowsChanged();
+    }
+    notifyPanelCountChanged();
+    notifyLayoutChanged();
 }
 
 // ============================================================================
-// 布局序列化
+// 面板类型
 // ============================================================================
 
-QVariantMap SplitManager::saveLayout() const
+bool SplitManager::registerPanelType(const QString& key, const QString& qmlSource,
+                                     const QString& defaultTitle, double defaultMinSize)
 {
-    QVariantMap layout;
-    layout["version"] = "2.0";
-    layout["minPanelSize"] = m_minPanelSize;
+    return bool(m_panelTypes.registerType(key, qmlSource, defaultTitle, defaultMinSize));
+}
+
+QStringList SplitManager::registeredPanelTypes() const
+{
+    return m_panelTypes.keys();
+}
+
+QVariantMap SplitManager::panelTypeInfo(const QString& key) const
+{
+    const SplitPanelType type = m_panelTypes.type(key);
+    if (!type) {
+        return {};
+    }
+    return {
+        {"key", type->key},
+        {"qmlSource", type->qmlSource},
+        {"defaultTitle", type->defaultTitle},
+        {"defaultMinSize", type->defaultMinSize}
+    };
+}
+
+// ============================================================================
+// 面板休眠
+// ============================================================================
+
+void SplitManager::setHibernationSizeThreshold(double threshold)
+{
+    if (SplitPanelNodeHelpers::safeSetValue(m_hibernationSizeThreshold, qMax(0.0, threshold))) {
+        emit hibernationPolicyChanged();
+    }
+}
+
+void SplitManager::setHibernationDelay(int delayMs)
+{
+    delayMs = qMax(0, delayMs);
+    if (m_hibernationDelay == delayMs) return;
+    
+    m_hibernationDelay = delayMs;
+    if (m_hibernationDelay == 0) {
+        m_hibernationTimer->stop();
+    } else if (!m_panelVisibility.isEmpty()) {
+        m_hibernationTimer->start();  // 重新检查已经不可见的面板
+    }
+    emit hibernationPolicyChanged();
+}
+
+void SplitManager::reportPanelVisibility(const QString& panelId, bool visible, double width, double height)
+{
+    PanelNode* panel = findPanel(panelId);
+    if (!panel) return;  // 视图池中的视图可能比面板晚一步销毁
+    
+    PanelVisibility& state = m_panelVisibility[panelId];
+    state.visible = visible;
+    state.width = width;
+    state.height = height;
+    if (visible) {
+        state.hiddenSince = -1;
+    } else if (state.hiddenSince < 0) {
+        state.hiddenSince = m_clock.elapsed();
+    }
     
-    if (m_root) {
-        layout["root"] = m_root->toVariant();
+    // 尺寸为 0 表示尚未完成布局，不参与尺寸判断
+    const bool laidOut = width > 0 && height > 0;
+    const double extent = qMin(width, height);
+    
+    if (panel->hibernated()) {
+        const bool largeEnough = m_hibernationSizeThreshold <= 0
+            || (laidOut && extent >= m_hibernationSizeThreshold * WakeHysteresis);
+        if (visible && largeEnough) {
+            wakePanel(panelId);
+        }
+    } else if (visible && laidOut && m_hibernationSizeThreshold > 0 && extent < m_hibernationSizeThreshold) {
+        hibernatePanel(panelId);
+    } else if (!visible && m_hibernationDelay > 0 && !m_hibernationTimer->isActive()) {
+        m_hibernationTimer->start();
     }
+}
+
+bool SplitManager::hibernatePanel(const QString& panelId)
+{
+    PanelNode* panel = findPanel(panelId);
+    if (!panel || panel->hibernated()) return false;
     
-    return layout;
+    panel->setHibernated(true);
+    LOG_DEBUG("SplitManager", "Panel hibernated", {{"panelId", panelId}});
+    return true;
 }
 
-bool SplitManager::loadLayout(const QVariantMap& layout)
+bool SplitManager::wakePanel(const QString& panelId)
 {
-    if (layout.value("version").toString() != "2.0") {
-        LOG_WARNING("SplitManager", "Incompatible layout version");
-        return false;
+    PanelNode* panel = findPanel(panelId);
+    if (!panel || !panel->hibernated()) return false;
+    
+    panel->setHibernated(false);
+    LOG_DEBUG("SplitManager", "Panel woken", {{"panelId", panelId}});
+    return true;
+}
+
+void SplitManager::storePanelState(const QString& panelId, const QVariant& state)
+{
+    if (!findPanel(panelId)) return;
+    m_panelStates.insert(panelId, state);
+}
+
+QVariant SplitManager::takePanelState(const QString& panelId)
+{
+    return m_panelStates.take(panelId);
+}
+
+void SplitManager::checkHiddenPanels()
+{
+    if (m_hibernationDelay <= 0) {
+        m_hibernationTimer->stop();
+        return;
     }
     
-    clear();
+    // 先收集再休眠：休眠信号的处理函数可能同步回报可见性
+    const qint64 now = m_clock.elapsed();
+    QStringList expired;
+    bool waiting = false;
+    for (auto it = m_panelVisibility.cbegin(); it != m_panelVisibility.cend(); ++it) {
+        if (it->hiddenSince < 0) continue;
+        
+        const PanelNode* panel = findPanel(it.key());
+        if (!panel || panel->hibernated()) continue;
+        
+        if (now - it->hiddenSince >= m_hibernationDelay) {
+            expired.append(it.key());
+        } else {
+            waiting = true;
+        }
+    }
+    
+    for (const QString& panelId : std::as_const(expired)) {
+        hibernatePanel(panelId);
+    }
+    if (!waiting) {
+        m_hibernationTimer->stop();
+    }
+}
+
+// ============================================================================
+// 批量修改
+// ============================================================================
+
+void SplitManager::beginBatch()
+{
+    if (m_batchDepth++ > 0) {
+        return;  // 嵌套批量，外层已开启延迟
+    }
     
-    if (layout.contains("minPanelSize")) {
-        setMinPanelSize(layout["minPanelSize"].toDouble());
+    // 批量期间的撤销记录合并为一步
+    m_history.beginGroup();
+    
+    // 现有节点统一进入延迟状态；批量期间新建的节点在 registerNode 中处理
+    for (SplitPanelNode* node : std::as_const(m_nodes)) {
+        node->setSignalsDeferred(true);
+    }
+}
+
+void SplitManager::commitBatch()
+{
+    if (m_batchDepth == 0) {
+        LOG_WARNING("SplitManager", "commitBatch called without matching beginBatch");
+        return;
+    }
+    if (--m_batchDepth > 0) {
+        return;  // 仍在外层批量中
     }
     
-    if (layout.contains("root")) {
-        m_root = loadNodeFromVariant(layout["root"].toMap());
+    const bool couldUndo = canUndo();
+    const bool couldRedo = canRedo();
+    m_history.endGroup();
+    notifyHistoryChanged(couldUndo, couldRedo);
+    
+    PendingSignals pending = std::exchange(m_pendingSignals, PendingSignals{});
+    
+    // 【顺序】先通知根节点变化，QML 若整体重建则不会再对旧视图逐个刷新
+    if (pending.rootNodeChanged) {
         emit rootNodeChanged();
+    }
+    if (pending.windowsChanged) {
+        emit windowsChanged();
+    }
+    
+    // 每个被修改过的节点只补发一次（已销毁的节点不在索引中，自然跳过）
+    // 先拷贝一份指针列表：信号处理函数可能再次修改树
+    const QList<SplitPanelNode*> nodes = m_nodes.values();
+    for (SplitPanelNode* node : nodes) {
+        node->flushDeferredSignals();
+    }
+    
+    if (pending.panelCountChanged) {
         emit panelCountChanged();
+    }
+    emitPanelNotices(pending.removedPanels, pending.addedPanels);
+    if (pending.layoutChanged) {
         emit layoutChanged();
-        return m_root != nullptr;
     }
-    
-    return true;
 }
 
-bool SplitManager::saveLayoutToFile(const QString& filePath) const
+void SplitManager::emitPanelNotices(const QStringList& removedPanels, const QStringList& addedPanels)
 {
-    QVariantMap layout = saveLayout();
-    QJsonDocument doc = QJsonDocument::fromVariant(layout);
-    
-    if (writeJsonToFile(filePath, doc)) {
-        LOG_INFO("SplitManager", "Layout saved to file", {
-            {"path", filePath},
-            {"panelCount", QString::number(m_panels.size())}
-        });
-        return true;
+    const bool queued = !m_panelNotices.isEmpty();
+    if (!queued && removedPanels.size() + addedPanels.size() <= SlicedNoticeThreshold) {
+        for (const QString& panelId : removedPanels) {
+            emit panelRemoved(panelId);
+        }
+        for (const QString& panelId : addedPanels) {
+            emit panelAdded(panelId);
+        }
+        return;
     }
     
-    LOG_ERROR("SplitManager", "Failed to write layout to file", {{"path", filePath}});
-    return false;
+    // 排在尚未发送的通知之后，保持与修改相同的顺序
+    for (const QString& panelId : removedPanels) {
+        m_panelNotices.append(PanelNotice{panelId, false});
+    }
+    for (const QString& panelId : addedPanels) {
+        m_panelNotices.append(PanelNotice{panelId, true});
+    }
+    if (!queued) {
+        scheduler()->post(this, [this]() { return stepPanelNotices(); }, int(m_panelNotices.size()));
+    }
 }
 
-bool SplitManager::loadLayoutFromFile(const QString& filePath)
+bool SplitManager::stepPanelNotices()
 {
-    QJsonDocument doc;
-    QString errorMsg;
-    
-    if (!readJsonFromFile(filePath, doc, &errorMsg)) {
-        LOG_ERROR("SplitManager", "Failed to read layout file", {
-            {"path", filePath},
-            {"error", errorMsg}
-        });
+    if (m_panelNoticeCursor < m_panelNotices.size()) {
+        // 先前进游标：信号处理函数中产生的新通知会追加到队列末尾
+        const PanelNotice notice = m_panelNotices[m_panelNoticeCursor++];
+        if (notice.added) {
+            emit panelAdded(notice.panelId);
+        } else {
+            emit panelRemoved(notice.panelId);
+        }
+    }
+    if (m_panelNoticeCursor < m_panelNotices.size()) {
+        return false;
+    }
+    m_panelNotices.clear();
+    m_panelNoticeCursor = 0;
+    return true;
+}
+
+// ============================================================================
+// 撤销/重做
+// ============================================================================
+
+void SplitManager::setHistoryLimit(int limit)
+{
+    if (m_history.limit() == qMax(1, limit)) return;
+    
+    m_history.setLimit(limit);
+    emit historyChanged();
+}
+
+bool SplitManager::undo()
+{
+    const bool couldUndo = canUndo();
+    const bool couldRedo = canRedo();
+    SplitHistory::Step step;
+    if (!m_history.undo(&step)) {
+        return false;
+    }
+    
+    // 一步中的多条记录逆序撤销，信号合并为一次
+    bool success = true;
+    {
+        Transaction transaction(this);
+        m_replayingHistory = true;
+        for (auto it = step.crbegin(); success && it != step.crend(); ++it) {
+            success = applyHistoryCommand(*it, true);
+        }
+        m_replayingHistory = false;
+    }
+    
+    if (!success) {
+        LOG_WARNING("SplitManager", "Undo record does not match the current tree, history cleared");
+        m_history.clear();
+    }
+    notifyHistoryChanged(couldUndo, couldRedo);
+    return success;
+}
+
+bool SplitManager::redo()
+{
+    const bool couldUndo = canUndo();
+    const bool couldRedo = canRedo();
+    SplitHistory::Step step;
+    if (!m_history.redo(&step)) {
+        return false;
+    }
+    
+    bool success = true;
+    {
+        Transaction transaction(this);
+        m_replayingHistory = true;
+        for (auto it = step.cbegin(); success && it != step.cend(); ++it) {
+            success = applyHistoryCommand(*it, false);
+        }
+        m_replayingHistory = false;
+    }
+    
+    if (!success) {
+        LOG_WARNING("SplitManager", "Redo record does not match the current tree, history cleared");
+        m_history.clear();
+    }
+    notifyHistoryChanged(couldUndo, couldRedo);
+    return success;
+}
+
+void SplitManager::clearHistory()
+{
+    const bool couldUndo = canUndo();
+    const bool couldRedo = canRedo();
+    m_history.clear();
+    notifyHistoryChanged(couldUndo, couldRedo);
+}
+
+bool SplitManager::setContainerOrientation(const QString& containerId, int orientation)
+{
+    ContainerNode* container = findContainer(containerId);
+    if (!container) {
+        return false;
+    }
+    
+    const auto before = container->orientation();
+    const auto after = (orientation == ContainerNode::Horizontal || orientation == ContainerNode::Stacked)
+        ? static_cast<ContainerNode::Orientation>(orientation)
+        : ContainerNode::Vertical;
+    if (before == after) {
+        return true;
+    }
+    
+    container->setOrientation(after);
+    
+    SplitHistoryCommand record;
+    record.type = SplitHistoryCommand::ReorientContainer;
+    record.containerId = containerId;
+    record.orientationBefore = before;
+    record.orientationAfter = after;
+    recordHistory(std::move(record));
+    
+    notifyLayoutChanged();
+    return true;
+}
+
+void SplitManager::recordHistory(SplitHistoryCommand command, bool coalesce)
+{
+    if (m_replayingHistory) {
+        return;
+    }
+    
+    const bool couldUndo = canUndo();
+    const bool couldRedo = canRedo();
+    m_history.record(std::move(command), m_clock.elapsed(), coalesce);
+    notifyHistoryChanged(couldUndo, couldRedo);
+}
+
+bool SplitManager::applyHistoryCommand(const SplitHistoryCommand& command, bool undo)
+{
+    switch (command.type) {
+    case SplitHistoryCommand::InsertPanel:
+        if (!undo) {
+            return reinsertPanel(command);
+        }
+        // 撤销插入：移除面板（不合并，恢复插入前的结构），再恢复接收容器的比例
+        if (!m_panels.contains(command.panelId)
+            || !removePanelNode(command.panelId, false, nullptr)) {
+            return false;
+        }
+        if (!command.sizesBefore.isEmpty()) {
+            ContainerNode* container = findContainer(command.containerId);
+            if (!container || container->childCount() != command.sizesBefore.size()) {
+                return false;
+            }
+            container->setSizes(command.sizesBefore);
+        }
+        return true;
+    
+    case SplitHistoryCommand::RemovePanel:
+        if (undo) {
+            return restoreRemovedPanel(command);
+        }
+        return m_panels.contains(command.panelId) && removePanelNode(command.panelId, true, nullptr);
+    
+    case SplitHistoryCommand::ResizeContainer: {
+        ContainerNode* container = findContainer(command.containerId);
+        const QList<qreal>& sizes = undo ? command.sizesBefore : command.sizesAfter;
+        if (!container || container->childCount() != sizes.size()) {
+            return false;
+        }
+        if (container->setSizes(sizes)) {
+            notifyLayoutChanged();
+        }
+        return true;
+    }
+    
+    case SplitHistoryCommand::ReorientContainer: {
+        ContainerNode* container = findContainer(command.containerId);
+        if (!container) {
+            return false;
+        }
+        container->setOrientation(static_cast<ContainerNode::Orientation>(
+            undo ? command.orientationBefore : command.orientationAfter));
+        notifyLayoutChanged();
+        return true;
+    }
+    }
+    return false;
+}
+
+bool SplitManager::reinsertPanel(const SplitHistoryCommand& command)
+{
+    if (m_panels.contains(command.panelId)) {
+        return false;
+    }
+    
+    // 插入时树为空：面板重新成为根节点
+    if (command.targetId.isEmpty()) {
+        if (m_root) return false;
+        auto panel = restorePanelNode(command);
+        registerPanel(command.panelId, panel.get());
+        setAsRoot(std::move(panel));
+        emitPanelAddedSignals(command.panelId);
+        return true;
+    }
+    
+    SplitPanelNode* target = findNode(command.targetId);
+    if (!target) {
+        return false;
+    }
+    
+    auto panel = restorePanelNode(command);
+    registerPanel(command.panelId, panel.get());
+    
+    SplitHistoryCommand replay = command;
+    if (!insertPanelAt(std::move(panel), target, static_cast<Direction>(command.direction), &replay)) {
+        unregisterPanel(command.panelId);
+        return false;
+    }
+    emitPanelAddedSignals(command.panelId);
+    return true;
+}
+
+bool SplitManager::restoreRemovedPanel(const SplitHistoryCommand& command)
+{
+    if (m_panels.contains(command.panelId)) {
+        return false;
+    }
+    
+    SplitNodePool::Scope poolScope(m_nodePool);
+    auto panel = restorePanelNode(command);
+    PanelNode* restored = panel.get();
+    
+    // 所在窗口的根节点槽位（分离窗口已关闭时为空）
+    auto windowSlot = [this, &command]() -> std::unique_ptr<SplitPanelNode>* {
+        if (command.windowId.isEmpty()) return &m_root;
+        for (SplitWindow& window : m_windows) {
+            if (window.id == command.windowId) return &window.root;
+        }
+        return nullptr;
+    };
+    
+    // 【情况1】面板原来是根节点（主窗口，或随最后一个面板关闭的分离窗口）
+    if (command.containerId.isEmpty()) {
+        if (command.windowId.isEmpty()) {
+            if (m_root) return false;
+            registerPanel(command.panelId, restored);
+            setAsRoot(std::move(panel));
+        } else {
+            if (windowSlot()) return false;
+            registerPanel(command.panelId, restored);
+            m_windows.push_back(SplitWindow{command.windowId, std::move(panel)});
+            notifyWindowsChanged();
+        }
+        emitPanelAddedSignals(command.panelId);
+        return true;
+    }
+    
+    // 【情况2】父容器仍然存在：插回原位置，恢复父容器的比例
+    if (!command.parentCollapsed) {
+        ContainerNode* parent = findContainer(command.containerId);
+        if (!parent || command.index < 0 || command.index > parent->childCount()
+            || parent->childCount() + 1 != command.sizesBefore.size()) {
+            return false;
+        }
+        registerPanel(command.panelId, restored);
+        parent->insertChild(command.index, std::move(panel), qMin(command.index, parent->childCount() - 1));
+        parent->setSizes(command.sizesBefore);
+        emitPanelAddedSignals(command.panelId);
+        return true;
+    }
+    
+    // 【情况3】父容器已被兄弟节点替换：取出兄弟节点（被合并时先重建），再重建父容器
+    ContainerNode* grandParent = nullptr;
+    std::unique_ptr<SplitPanelNode>* rootSlot = nullptr;
+    std::unique_ptr<SplitPanelNode> sibling;
+    if (command.grandParentId.isEmpty()) {
+        // 父容器原来是所在窗口的根：兄弟节点现在是同一个窗口的根
+        rootSlot = windowSlot();
+        if (!rootSlot || !*rootSlot) return false;
+        sibling = std::move(*rootSlot);
+    } else {
+        grandParent = findContainer(command.grandParentId);
+        const int siblingSpan = command.mergedId.isEmpty() ? 1 : command.mergedChildCount;
+        if (!grandParent || command.slotIndex < 0 || siblingSpan <= 0
+            || command.slotIndex + siblingSpan > grandParent->childCount()
+            || grandParent->childCount() - siblingSpan + 1 != command.grandParentSizes.size()) {
+            return false;
+        }
+        
+        if (command.mergedId.isEmpty()) {
+            sibling = grandParent->takeChild(command.slotIndex);
+        } else {
+            auto merged = std::make_unique<ContainerNode>(
+                command.mergedId, static_cast<ContainerNode::Orientation>(command.mergedOrientation), this);
+            merged->setMinSize(command.mergedMinSize);
+            registerNode(merged.get());
+            for (int i = 0; i < siblingSpan; ++i) {
+                merged->appendChild(grandParent->takeChild(command.slotIndex));
+            }
+            merged->setSizes(command.mergedSizes);
+            sibling = std::move(merged);
+        }
+    }
+    
+    auto parent = std::make_unique<ContainerNode>(
+        command.containerId, static_cast<ContainerNode::Orientation>(command.orientationBefore), this);
+    parent->setMinSize(command.containerMinSize);
+    registerNode(parent.get());
+    registerPanel(command.panelId, restored);
+    
+    if (command.index == 0) {
+        parent->appendChild(std::move(panel));
+        parent->appendChild(std::move(sibling));
+    } else {
+        parent->appendChild(std::move(sibling));
+        parent->appendChild(std::move(panel));
+    }
+    parent->setSizes(command.sizesBefore);
+    
+    if (grandParent) {
+        grandParent->insertChild(command.slotIndex, std::move(parent), 0);
+        grandParent->setSizes(command.grandParentSizes);
+    } else {
+        *rootSlot = std::move(parent);
+    }
+    
+    notifyTreeRootChanged(command.windowId);
+    emitPanelAddedSignals(command.panelId);
+    return true;
+}
+
+std::unique_ptr<PanelNode> SplitManager::restorePanelNode(const SplitHistoryCommand& command)
+{
+    SplitNodePool::Scope poolScope(m_nodePool);
+    auto panel = std::make_unique<PanelNode>(command.panelId, command.title, this);
+    panel->setType(command.panelType);
+    panel->setMinSize(command.panelMinSize);
+    return panel;
+}
+
+ContainerNode* SplitManager::findContainer(const QString& id) const
+{
+    SplitPanelNode* node = findNode(id);
+    return (node && node->nodeType() == SplitPanelNode::Container) ? static_cast<ContainerNode*>(node) : nullptr;
+}
+
+void SplitManager::notifyHistoryChanged(bool couldUndo, bool couldRedo)
+{
+    if (couldUndo != canUndo() || couldRedo != canRedo()) {
+        emit historyChanged();
+    }
+}
+
+// ============================================================================
+// 多窗口（分离的面板组）
+// ============================================================================
+
+QStringList SplitManager::windowIds() const
+{
+    QStringList ids;
+    ids.reserve(qsizetype(m_windows.size()));
+    for (const SplitWindow& window : m_windows) {
+        ids.append(window.id);
+    }
+    return ids;
+}
+
+QVariantMap SplitManager::windowRoots() const
+{
+    QVariantMap roots;
+    for (const SplitWindow& window : m_windows) {
+        roots[window.id] = QVariant::fromValue(window.root.get());
+    }
+    return roots;
+}
+
+QString SplitManager::windowOf(const QString& nodeId) const
+{
+    const SplitPanelNode* root = treeRootOf(findNode(nodeId));
+    for (const SplitWindow& window : m_windows) {
+        if (window.root.get() == root) {
+            return window.id;
+        }
+    }
+    return QString();
+}
+
+QString SplitManager::detachNode(const QString& nodeId)
+{
+    SplitPanelNode* node = findNode(nodeId);
+    if (!node) {
+        LOG_ERROR("SplitManager", QString("Node not found: %1").arg(nodeId));
+        return QString();
+    }
+    
+    // 节点已独占一个分离窗口，不必再开新窗口
+    QString currentWindowId;
+    if (!getParentContainer(node) && rootSlotOf(node, &currentWindowId) && !currentWindowId.isEmpty()) {
+        return currentWindowId;
+    }
+    
+    // 取下和挂接合并为一次更新，QML 不会看到子树同时不在任何窗口中
+    Transaction transaction(this);
+    
+    std::unique_ptr<SplitPanelNode> subtree = takeSubtree(node);
+    if (!subtree) {
+        LOG_ERROR("SplitManager", QString("Node is not part of any window: %1").arg(nodeId));
+        return QString();
+    }
+    
+    const QString windowId = QString("window_%1").arg(++m_windowIdCounter);
+    m_windows.push_back(SplitWindow{windowId, std::move(subtree)});
+    m_pendingMinSizeChecks.insert(windowId);  // 新窗口第一次上报视口时检查子树是否放得下
+    normalizeAllTrees();
+    clearHistory();
+    
+    notifyRootNodeChanged();
+    notifyWindowsChanged();
+    notifyLayoutChanged();
+    
+    LOG_INFO("SplitManager", "Node detached to new window", {
+        {"nodeId", nodeId},
+        {"windowId", windowId}
+    });
+    return windowId;
+}
+
+bool SplitManager::moveNode(const QString& nodeId, const QString& targetId, int direction)
+{
+    SplitPanelNode* node = findNode(nodeId);
+    SplitPanelNode* target = findNode(targetId);
+    if (!node || !target || node == target) {
+        LOG_ERROR("SplitManager", "Invalid move", {{"nodeId", nodeId}, {"targetId", targetId}});
+        return false;
+    }
+    
+    // 目标不能在被移动的子树中
+    for (SplitPanelNode* ancestor = target; ancestor; ancestor = getParentContainer(ancestor)) {
+        if (ancestor == node) {
+            LOG_WARNING("SplitManager", "Move target is inside the moved subtree", {
+                {"nodeId", nodeId},
+                {"targetId", targetId}
+            });
+            return false;
+        }
+    }
+    
+    // 目标是只有两个子节点的父容器时，取下节点后它会被兄弟节点替换：改为以兄弟节点为目标
+    ContainerNode* parentContainer = getParentContainer(node);
+    if (parentContainer == target && parentContainer->childCount() == 2) {
+        target = parentContainer->child(parentContainer->indexOf(node) == 0 ? 1 : 0);
+    }
+    
+    Transaction transaction(this);
+    
+    // 取下前记下原位置：插入失败（如方向无效）时子树放回原处，节点不会留在索引中却不在任何树上
+    const SubtreeOrigin origin = originOf(node);
+    std::unique_ptr<SplitPanelNode> subtree = takeSubtree(node);
+    if (!subtree) {
+        LOG_ERROR("SplitManager", QString("Node is not part of any window: %1").arg(nodeId));
+        return false;
+    }
+    
+    if (!insertPanelAt(std::move(subtree), target, static_cast<Direction>(direction))) {
+        const bool restored = restoreSubtree(std::move(subtree), origin);
+        if (!restored) {
+            // 原位置也放不回时放到新窗口：节点仍然可见，索引中的指针仍然有效
+            m_windows.push_back(SplitWindow{QString("window_%1").arg(++m_windowIdCounter), std::move(subtree)});
+        }
+        normalizeAllTrees();
+        notifyRootNodeChanged();
+        notifyWindowsChanged();
+        notifyLayoutChanged();
+        
+        LOG_ERROR("SplitManager", "Failed to move node", {
+            {"nodeId", nodeId},
+            {"targetId", targetId},
+            {"direction", QString::number(direction)},
+            {"restored", restored ? "true" : "false"}
+        });
+        return false;
+    }
+    normalizeAllTrees();
+    clearHistory();
+    
+    notifyRootNodeChanged();
+    notifyWindowsChanged();
+    notifyLayoutChanged();
+    
+    LOG_INFO("SplitManager", "Node moved", {
+        {"nodeId", nodeId},
+        {"targetId", targetId},
+        {"windowId", windowOf(nodeId)}
+    });
+    return true;
+}
+
+bool SplitManager::closeWindow(const QString& windowId)
+{
+    auto it = std::find_if(m_windows.begin(), m_windows.end(),
+                           [&windowId](const SplitWindow& window) { return window.id == windowId; });
+    if (it == m_windows.end()) {
+        LOG_WARNING("SplitManager", QString("Window not found: %1").arg(windowId));
+        return false;
+    }
+    
+    Transaction transaction(this);
+    
+    // 插入成功后才删除窗口：失败时树放回窗口，节点不会丢失
+    std::unique_ptr<SplitPanelNode> subtree = std::move(it->root);
+    if (!m_root) {
+        m_root = std::move(subtree);
+    } else if (!insertPanelAt(std::move(subtree), m_root.get(), Right)) {
+        it->root = std::move(subtree);
+        LOG_ERROR("SplitManager", "Failed to dock window back", {{"windowId", windowId}});
+        return false;
+    }
+    m_windows.erase(it);
+    normalizeAllTrees();
+    clearHistory();
+    
+    notifyRootNodeChanged();
+    notifyWindowsChanged();
+    notifyLayoutChanged();
+    
+    LOG_INFO("SplitManager", "Window docked back", {{"windowId", windowId}});
+    return true;
+}
+
+void SplitManager::closeAllWindows()
+{
+    if (m_windows.empty()) return;
+    
+    Transaction transaction(this);
+    while (!m_windows.empty()) {
+        // 停靠失败的窗口保留，不能反复重试
+        if (!closeWindow(m_windows.front().id)) break;
+    }
+}
+
+std::unique_ptr<SplitPanelNode>* SplitManager::rootSlotOf(const SplitPanelNode* root, QString* windowId)
+{
+    if (windowId) {
+        windowId->clear();
+    }
+    if (!root) return nullptr;
+    
+    if (root == m_root.get()) {
+        return &m_root;
+    }
+    for (SplitWindow& window : m_windows) {
+        if (window.root.get() == root) {
+            if (windowId) {
+                *windowId = window.id;
+            }
+            return &window.root;
+        }
+    }
+    return nullptr;
+}
+
+SplitPanelNode* SplitManager::treeRootOf(SplitPanelNode* node) const
+{
+    while (node && node->parentContainer()) {
+        node = node->parentContainer();
+    }
+    return node;
+}
+
+std::unique_ptr<SplitPanelNode> SplitManager::takeSubtree(SplitPanelNode* node)
+{
+    if (!node) return nullptr;
+    
+    // 【情况1】节点是一棵树的根：整棵树取下
+    ContainerNode* parentContainer = getParentContainer(node);
+    if (!parentContainer) {
+        QString windowId;
+        std::unique_ptr<SplitPanelNode>* slot = rootSlotOf(node, &windowId);
+        if (!slot) return nullptr;
+        
+        std::unique_ptr<SplitPanelNode> taken = std::move(*slot);
+        removeEmptyWindows();
+        notifyTreeRootChanged(windowId);
+        return taken;
+    }
+    
+    const int index = parentContainer->indexOf(node);
+    if (index < 0) return nullptr;
+    
+    // 取下的子树比父容器活得久，不能再作为 Qt 子对象被连带释放
+    std::unique_ptr<SplitPanelNode> taken = parentContainer->takeChild(index);
+    taken->setParent(nullptr);
+    
+    // 【情况2】父容器还有两个以上的子节点：空间已分给其余子节点
+    if (parentContainer->childCount() >= 2) {
+        return taken;
+    }
+    
+    // 【情况3】父容器只剩一个子节点：用它替换父容器（与删除面板相同）
+    std::unique_ptr<SplitPanelNode> sibling = parentContainer->takeChild(0);
+    if (!promoteSiblingNode(parentContainer, std::move(sibling), false)) {
+        LOG_ERROR("SplitManager", "Failed to promote sibling node");
+    }
+    return taken;
+}
+
+SplitManager::SubtreeOrigin SplitManager::originOf(SplitPanelNode* node)
+{
+    SubtreeOrigin origin;
+    ContainerNode* parentContainer = getParentContainer(node);
+    if (!parentContainer) {
+        rootSlotOf(node, &origin.windowId);
+        for (size_t i = 0; i < m_windows.size(); ++i) {
+            if (m_windows[i].id == origin.windowId) {
+                origin.windowIndex = int(i);
+            }
+        }
+        return origin;
+    }
+    
+    origin.parentId = parentContainer->nodeId();
+    origin.orientation = parentContainer->orientation();
+    origin.index = parentContainer->indexOf(node);
+    origin.sizes = parentContainer->sizes();
+    origin.currentIndex = parentContainer->currentIndex();
+    if (parentContainer->childCount() == 2) {
+        origin.parentCollapsed = true;
+        origin.siblingId = parentContainer->child(origin.index == 0 ? 1 : 0)->nodeId();
+    }
+    return origin;
+}
+
+bool SplitManager::restoreSubtree(std::unique_ptr<SplitPanelNode>&& subtree, const SubtreeOrigin& origin)
+{
+    SplitPanelNode* restored = subtree.get();
+    
+    // 【情况1】节点原来是一棵树的根：放回原来的窗口
+    if (origin.parentId.isEmpty()) {
+        if (origin.windowId.isEmpty()) {
+            if (m_root) return false;
+            m_root = std::move(subtree);
+        } else {
+            const int position = qBound(0, origin.windowIndex, int(m_windows.size()));
+            m_windows.insert(m_windows.begin() + position, SplitWindow{origin.windowId, std::move(subtree)});
+        }
+        notifyTreeRootChanged(origin.windowId);
+        return true;
+    }
+    
+    ContainerNode* parent = nullptr;
+    if (!origin.parentCollapsed) {
+        // 【情况2】父容器仍在：插回原来的位置
+        parent = qobject_cast<ContainerNode*>(findNode(origin.parentId));
+        if (!parent || origin.index < 0 || origin.index > parent->childCount()) return false;
+        parent->insertChild(origin.index, std::move(subtree), qMin(origin.index, parent->childCount() - 1));
+    } else {
+        // 【情况3】父容器已被兄弟节点替换：用原来的 ID 重新创建父容器包住兄弟节点
+        SplitPanelNode* sibling = findNode(origin.siblingId);
+        Direction direction = Center;
+        if (origin.orientation == ContainerNode::Vertical) {
+            direction = origin.index == 0 ? Left : Right;
+        } else if (origin.orientation == ContainerNode::Horizontal) {
+            direction = origin.index == 0 ? Top : Bottom;
+        }
+        SplitHistoryCommand record;
+        record.createdContainerId = origin.parentId;
+        if (!sibling || !insertPanelAt(std::move(subtree), sibling, direction, &record)) return false;
+        
+        parent = qobject_cast<ContainerNode*>(findNode(origin.parentId));
+        if (!parent) return true;  // 插进了同方向的已有容器，比例已由插入分配
+        
+        // 标签页总是插在目标之后：原来是第一个标签时挪回前面
+        if (parent->indexOf(restored) != origin.index) {
+            std::unique_ptr<SplitPanelNode> tab = parent->takeChild(parent->indexOf(restored));
+            parent->insertChild(origin.index, std::move(tab), 0);
+        }
+    }
+    parent->setSizes(origin.sizes);
+    parent->setCurrentIndex(origin.currentIndex);
+    return true;
+}
+
+void SplitManager::normalizeAllTrees()
+{
+    normalizeSubtree(m_root.get());
+    for (SplitWindow& window : m_windows) {
+        normalizeSubtree(window.root.get());
+    }
+}
+
+void SplitManager::removeEmptyWindows()
+{
+    const size_t before = m_windows.size();
+    m_windows.erase(std::remove_if(m_windows.begin(), m_windows.end(),
+                                   [](const SplitWindow& window) { return !window.root; }),
+                    m_windows.end());
+    if (m_windows.size() != before) {
+        notifyWindowsChanged();
+    }
+}
+
+// ============================================================================
+// 布局序列化
+// ============================================================================
+
+QVariantMap SplitManager::saveLayout() const
+{
+    QVariantMap layout;
+    layout["version"] = SplitLayoutSerializer::LayoutVersion;
+    layout["minPanelSize"] = m_minPanelSize;
+    
+    if (m_root) {
+        layout["root"] = flatTree().toVariant(0);
+    }
+    
+    return layout;
+}
+
+bool SplitManager::loadLayout(const QVariantMap& layout)
+{
+    SPLITPANEL_PROFILE_SCOPE(LoadLayout);
+    
+    cancelSlicedLoad();
+    
+    if (!SplitLayoutSerializer::isSupportedVersion(layout.value("version").toString())) {
+        LOG_WARNING("SplitManager", "Incompatible layout version");
+        return false;
+    }
+    
+    // 与文件加载共用读取和校验（ID 为空或重复时不修改当前树）
+    SplitLayoutSerializer::LayoutSpec spec;
+    QString error;
+    if (!SplitLayoutSerializer::specFromVariant(layout, m_minPanelSize, spec, &error)) {
+        LOG_WARNING("SplitManager", "Invalid layout, nothing loaded", {{"error", error}});
+        return false;
+    }
+    
+    std::unique_ptr<SplitPanelNode> root;
+    {
+        SplitNodePool::Scope poolScope(m_nodePool);
+        root = SplitLayoutSerializer::buildTree(spec, this, m_panelTypes);
+    }
+    return applyLoadedLayout(spec, std::move(root));
+}
+
+bool SplitManager::saveLayoutToFile(const QString& filePath, int format) const
+{
+    SPLITPANEL_PROFILE_SCOPE(SaveLayoutToFile);
+    
+    if (writeBytesToFile(filePath, serializeLayout(format))) {
+        LOG_INFO("SplitManager", "Layout saved to file", {
+            {"path", filePath},
+            {"format", format == BinaryFormat ? "binary" : "json"},
+            {"panelCount", QString::number(m_panels.size())}
+        });
+        return true;
+    }
+    
+    LOG_ERROR("SplitManager", "Failed to write layout to file", {{"path", filePath}});
+    return false;
+}
+
+bool SplitManager::loadLayoutFromFile(const QString& filePath)
+{
+    cancelSlicedLoad();
+    
+    QByteArray data;
+    QString errorMsg;
+    SplitLayoutSerializer::LayoutSpec spec;
+    
+    if (!readBytesFromFile(filePath, data, &errorMsg)
+        || !SplitLayoutSerializer::readSpec(data, m_minPanelSize, spec, &errorMsg)) {
+        LOG_ERROR("SplitManager", "Failed to read layout file", {
+            {"path", filePath},
+            {"error", errorMsg}
+        });
+        return false;
+    }
+    
+    std::unique_ptr<SplitPanelNode> root;
+    {
+        SplitNodePool::Scope poolScope(m_nodePool);
+        root = SplitLayoutSerializer::buildTree(spec, this, m_panelTypes);
+    }
+    bool success = applyLoadedLayout(spec, std::move(root));
+    
+    if (success) {
+        LOG_INFO("SplitManager", "Layout loaded from file", {
+            {"path", filePath},
+            {"panelCount", QString::number(m_panels.size())}
+        });
+    } else {
+        LOG_ERROR("SplitManager", "Failed to load layout from file", {{"path", filePath}});
+    }
+    
+    return success;
+}
+
+// ============================================================================
+// 布局差量应用
+// ============================================================================
+
+/**
+ * applyLayout 的中间状态
+ */
+struct SplitManager::LayoutPatch {
+    std::vector<LayoutPatchNode> nodes;      // 新树的节点描述（先序，nodes[0] 为根）
+    QHash<QString, int> indexById;           // 节点ID → nodes 下标
+    QSet<QString> reattach;                  // 需要重新挂接子节点的容器（子节点列表变化的和新建的）
+    std::unordered_map<QString, std::unique_ptr<SplitPanelNode>> detached;  // 取下的节点（ID → 所有权）
+    int reused = 0;
+    int created = 0;
+    int removed = 0;
+};
+
+bool SplitManager::applyLayout(const QVariantMap& layout)
+{
+    if (!SplitLayoutSerializer::isSupportedVersion(layout.value("version").toString())) {
+        cancelSlicedLoad();
+        LOG_WARNING("SplitManager", "Incompatible layout version");
+        return false;
+    }
+    
+    SplitLayoutSerializer::LayoutSpec spec;
+    QString error;
+    if (!SplitLayoutSerializer::specFromVariant(layout, m_minPanelSize, spec, &error)) {
+        cancelSlicedLoad();
+        LOG_WARNING("SplitManager", "Invalid layout, nothing applied", {{"error", error}});
+        return false;
+    }
+    return applyLayoutSpec(std::move(spec));
+}
+
+bool SplitManager::applyLayoutData(const QByteArray& data)
+{
+    // 直接从文件内容流式读成描述，不经过 QVariantMap
+    SplitLayoutSerializer::LayoutSpec spec;
+    QString error;
+    if (!SplitLayoutSerializer::readSpec(data, m_minPanelSize, spec, &error)) {
+        cancelSlicedLoad();
+        LOG_WARNING("SplitManager", "Invalid layout, nothing applied", {{"error", error}});
+        return false;
+    }
+    return applyLayoutSpec(std::move(spec));
+}
+
+bool SplitManager::applyLayoutSpec(SplitLayoutSerializer::LayoutSpec spec)
+{
+    SPLITPANEL_PROFILE_SCOPE(ApplyLayout);
+    
+    cancelSlicedLoad();
+    
+    // 【步骤1】新树已完整读成描述，无效时不修改当前树
+    if (!SplitLayoutSerializer::isSupportedVersion(spec.version)) {
+        LOG_WARNING("SplitManager", "Incompatible layout version");
+        return false;
+    }
+    // 差量应用不压缩新树：无效节点和空容器直接拒绝
+    if (spec.skippedNodes > 0) {
+        LOG_WARNING("SplitManager", "Invalid layout, nothing applied", {
+            {"error", QString("%1 node(s) with an invalid type").arg(spec.skippedNodes)}
+        });
+        return false;
+    }
+    for (const LayoutPatchNode& node : spec.nodes) {
+        if (node.container && node.children.isEmpty()) {
+            LOG_WARNING("SplitManager", "Invalid layout, nothing applied", {
+                {"error", QString("Container has no children: %1").arg(node.id)}
+            });
+            return false;
+        }
+    }
+    
+    const double minPanelSize = spec.hasMinPanelSize ? spec.minPanelSize : m_minPanelSize;
+    LayoutPatch patch;
+    patch.nodes = std::move(spec.nodes);
+    patch.indexById = std::move(spec.indexById);
+    
+    Transaction transaction(this);
+    setMinPanelSize(minPanelSize);
+    
+    // 分离窗口的节点也在索引中：先并回主窗口，下面的对比和复用只需处理一棵树
+    closeAllWindows();
+    
+    // 【步骤2】对比节点 ID：新树中没有（或类型变了）的节点销毁，子节点列表变化的容器重新挂接
+    const auto sameType = [&patch](const SplitPanelNode* live, int specIndex) {
+        return (live->nodeType() == SplitPanelNode::Container) == patch.nodes[size_t(specIndex)].container;
+    };
+    
+    QList<SplitPanelNode*> removedNodes;
+    QList<ContainerNode*> detachFrom;
+    for (SplitPanelNode* node : std::as_const(m_nodes)) {
+        const int specIndex = patch.indexById.value(node->nodeId(), -1);
+        if (specIndex < 0 || !sameType(node, specIndex)) {
+            removedNodes.append(node);
+            if (node->nodeType() == SplitPanelNode::Container) {
+                detachFrom.append(static_cast<ContainerNode*>(node));
+            }
+            continue;
+        }
+        if (node->nodeType() != SplitPanelNode::Container) continue;
+        
+        auto* container = static_cast<ContainerNode*>(node);
+        const QList<int>& children = patch.nodes[size_t(specIndex)].children;
+        bool same = container->childCount() == children.size();
+        for (int i = 0; same && i < container->childCount(); ++i) {
+            const SplitPanelNode* child = container->child(i);
+            same = child->nodeId() == patch.nodes[size_t(children[i])].id && sameType(child, children[i]);
+        }
+        if (!same) {
+            detachFrom.append(container);
+            patch.reattach.insert(container->nodeId());
+        }
+    }
+    
+    // 【步骤3】取下受影响的节点（保持各自的子树不变）
+    SplitPanelNode* previousRoot = m_root.get();
+    if (m_root && (patch.nodes.empty() || m_root->nodeId() != patch.nodes.front().id || !sameType(m_root.get(), 0))) {
+        const QString rootId = m_root->nodeId();
+        patch.detached[rootId] = std::move(m_root);
+    }
+    for (ContainerNode* container : std::as_const(detachFrom)) {
+        for (auto& child : container->takeChildren()) {
+            const QString childId = child->nodeId();
+            patch.detached[childId] = std::move(child);
+        }
+    }
+    
+    for (SplitPanelNode* node : std::as_const(removedNodes)) {
+        const QString nodeId = node->nodeId();
+        if (node->nodeType() == SplitPanelNode::Panel) {
+            unregisterPanel(nodeId);
+            notifyPanelRemoved(nodeId);
+        } else {
+            unregisterNode(nodeId);
+        }
+        ++patch.removed;
+    }
+    
+    // 【步骤4】按新树复用或创建节点，只在需要的容器中重新挂接
+    if (!patch.nodes.empty()) {
+        if (std::unique_ptr<SplitPanelNode> root = patchNode(patch, 0)) {
+            m_root = std::move(root);
+        }
+    }
+    
+    // 剩下的都是被移除的节点（容器的子节点已全部取下，不会连带释放复用的节点）
+    patch.detached.clear();
+    
+    normalizeSubtree(m_root.get());
+    clearHistory();
+    
+    if (m_root.get() != previousRoot) {
+        notifyRootNodeChanged();
+    }
+    if (patch.created > 0 || patch.removed > 0) {
+        notifyPanelCountChanged();
+    }
+    notifyLayoutChanged();
+    
+    LOG_INFO("SplitManager", "Layout applied", {
+        {"reused", QString::number(patch.reused)},
+        {"created", QString::number(patch.created)},
+        {"removed", QString::number(patch.removed)}
+    });
+    return true;
+}
+
+std::unique_ptr<SplitPanelNode> SplitManager::patchNode(LayoutPatch& patch, int specIndex)
+{
+    const LayoutPatchNode& spec = patch.nodes[size_t(specIndex)];
+    
+    // 已有节点：仍挂在原位置时返回空，被取下时交回所有权
+    std::unique_ptr<SplitPanelNode> owned;
+    SplitPanelNode* node = findNode(spec.id);
+    if (node) {
+        ++patch.reused;
+        auto it = patch.detached.find(spec.id);
+        if (it != patch.detached.end()) {
+            owned = std::move(it->second);
+            patch.detached.erase(it);
+        }
+    } else {
+        SplitNodePool::Scope poolScope(m_nodePool);
+        if (spec.container) {
+            owned = std::make_unique<ContainerNode>(spec.id, spec.orientation, this);
+            registerNode(owned.get());
+            patch.reattach.insert(spec.id);
+        } else {
+            auto panel = std::make_unique<PanelNode>(spec.id, spec.title, this);
+            registerPanel(spec.id, panel.get());
+            notifyPanelAdded(spec.id);
+            owned = std::move(panel);
+        }
+        node = owned.get();
+        ++patch.created;
+    }
+    
+    // 属性原地更新（没有变化的属性不发送信号）
+    node->setMinSize(spec.minSize);
+    if (!spec.container) {
+        auto* panel = static_cast<PanelNode*>(node);
+        panel->setTitle(spec.title);
+        panel->setType(m_panelTypes.resolve(spec.panelType, spec.qmlSource));
+        return owned;
+    }
+    
+    auto* container = static_cast<ContainerNode*>(node);
+    container->setOrientation(spec.orientation);
+    const bool reattach = patch.reattach.contains(spec.id);
+    for (int childIndex : spec.children) {
+        std::unique_ptr<SplitPanelNode> child = patchNode(patch, childIndex);
+        if (reattach && child) {
+            container->appendChild(std::move(child));
+        }
+    }
+    container->setSizes(spec.sizes);
+    container->setCurrentIndex(spec.currentIndex);
+    return owned;
+}
+
+// ============================================================================
+// 异步布局保存/加载
+// ============================================================================
+
+QFuture<bool> SplitManager::saveLayoutAsync(const QString& filePath, int format)
+{
+    const QString panelCount = QString::number(m_panels.size());
+    
+    return enqueueLayoutWrite(filePath, format, false).then(this, [this, filePath, panelCount](bool success) {
+        if (success) {
+            LOG_INFO("SplitManager", "Layout saved to file asynchronously", {
+                {"path", filePath},
+                {"panelCount", panelCount}
+            });
+        } else {
+            LOG_ERROR("SplitManager", "Failed to write layout to file", {{"path", filePath}});
+        }
+        emit layoutSaved(filePath, success);
+        return success;
+    });
+}
+
+QFuture<bool> SplitManager::enqueueLayoutWrite(const QString& filePath, int format, bool skipUnchanged)
+{
+    // 【GUI 线程】只复制扁平树（值数据，隐式共享），编码和文本化全部放到工作线程
+    const bool binary = (format == BinaryFormat);
+    const SplitFlatTree snapshot = flatTree();
+    const double minPanelSize = m_minPanelSize;
+    const std::shared_ptr<QHash<QString, QByteArray>> writtenHashes = m_writtenHashes;
+    
+    // 上一次保存可能还没写完，排在它后面，保证文件内容是最后一次快照
+    const QFuture<bool> previous = m_lastSave;
+    
+    QFuture<bool> future = runInBackground<bool>(
+        [filePath, snapshot, minPanelSize, binary, skipUnchanged, writtenHashes, previous]() {
+        QFuture<bool> pending = previous;
+        if (!pending.isFinished()) {
+            pending.waitForFinished();
+        }
+        SPLITPANEL_PROFILE_SCOPE(SaveLayoutWrite);
+        const QByteArray data = binary
+            ? SplitLayoutSerializer::toCbor(snapshot, minPanelSize)
+            : QJsonDocument(SplitLayoutSerializer::toJson(snapshot, minPanelSize)).toJson(QJsonDocument::Indented);
+        
+        // 写入按提交顺序串行执行，哈希表同一时刻只有一个工作线程访问
+        const QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+        if (skipUnchanged && writtenHashes->value(filePath) == hash) {
+            return true;
+        }
+        if (!writeBytesToFile(filePath, data)) {
+            writtenHashes->remove(filePath);
+            return false;
+        }
+        writtenHashes->insert(filePath, hash);
+        return true;
+    });
+    m_lastSave = future;
+    return future;
+}
+
+// ============================================================================
+// 自动保存
+// ============================================================================
+
+void SplitManager::setAutosaveEnabled(bool enabled)
+{
+    if (m_autosaveEnabled == enabled) return;
+    
+    m_autosaveEnabled = enabled;
+    if (enabled) {
+        watchAutosaveRoot();
+        markAutosaveClean();
+    } else {
+        // 关闭时丢弃尚未写入的修改（需要时先调用 flushAutosave）
+        QObject::disconnect(m_autosaveRootConnection);
+        m_autosaveTimer->stop();
+        m_autosaveFirstChange = -1;
+    }
+    
+    LOG_INFO("SplitManager", enabled ? "Autosave enabled" : "Autosave disabled", {
+        {"path", autosavePath()}
+    });
+    emit autosaveChanged();
+}
+
+QString SplitManager::autosavePath() const
+{
+    return m_autosavePath.isEmpty() ? getDefaultLayoutPath() : m_autosavePath;
+}
+
+void SplitManager::setAutosavePath(const QString& filePath)
+{
+    if (m_autosavePath == filePath) return;
+    
+    // 新文件不一定是当前布局，下一次自动保存必须写入
+    m_autosavePath = filePath;
+    m_autosavedRoot = nullptr;
+    markAutosaveDirty();
+    emit autosaveChanged();
+}
+
+void SplitManager::setAutosaveDelay(int delayMs)
+{
+    delayMs = qMax(0, delayMs);
+    if (m_autosaveDelay == delayMs) return;
+    
+    m_autosaveDelay = delayMs;
+    emit autosaveChanged();
+}
+
+void SplitManager::setAutosaveMaxLatency(int latencyMs)
+{
+    latencyMs = qMax(0, latencyMs);
+    if (m_autosaveMaxLatency == latencyMs) return;
+    
+    m_autosaveMaxLatency = latencyMs;
+    emit autosaveChanged();
+}
+
+bool SplitManager::flushAutosave()
+{
+    m_autosaveTimer->stop();
+    m_autosaveFirstChange = -1;
+    if (!m_autosaveEnabled || !isAutosaveDirty()) return false;
+    
+    markAutosaveClean();
+    const QString filePath = autosavePath();
+    enqueueLayoutWrite(filePath, JsonFormat, true).then(this, [this, filePath](bool success) {
+        if (!success) {
+            LOG_ERROR("SplitManager", "Autosave failed", {{"path", filePath}});
+            // 下一次修改（或 flushAutosave）重新写入
+            m_autosavedRoot = nullptr;
+        }
+        emit autosaved(filePath, success);
+    });
+    return true;
+}
+
+void SplitManager::onAutosaveTimer()
+{
+    if (m_autosaveFirstChange < 0) return;
+    
+    const qint64 now = m_clock.elapsed();
+    const qint64 idle = now - m_autosaveLastChange;
+    const qint64 age = now - m_autosaveFirstChange;
+    if (idle < m_autosaveDelay && age < m_autosaveMaxLatency) {
+        // 期间又有修改：顺延到空闲满 autosaveDelay 或到达最大延迟
+        m_autosaveTimer->start(int(qMin(m_autosaveDelay - idle, m_autosaveMaxLatency - age)));
+        return;
+    }
+    flushAutosave();
+}
+
+void SplitManager::markAutosaveDirty()
+{
+    if (!m_autosaveEnabled) return;
+    
+    // 只记录时间：拖动、批量修改中每次修改都会调用，不重启定时器
+    const qint64 now = m_clock.elapsed();
+    m_autosaveLastChange = now;
+    if (m_autosaveFirstChange < 0) {
+        m_autosaveFirstChange = now;
+    }
+    if (!m_autosaveTimer->isActive()) {
+        m_autosaveTimer->start(m_autosaveDelay);
+    }
+}
+
+void SplitManager::watchAutosaveRoot()
+{
+    QObject::disconnect(m_autosaveRootConnection);
+    if (m_root) {
+        m_autosaveRootConnection = connect(m_root.get(), &SplitPanelNode::treeRevisionChanged,
+                                           this, &SplitManager::markAutosaveDirty);
+    }
+}
+
+bool SplitManager::isAutosaveDirty() const
+{
+    const SplitPanelNode* root = m_root.get();
+    return root != m_autosavedRoot
+        || (root && root->treeRevision() != m_autosavedRevision)
+        || m_minPanelSize != m_autosavedMinPanelSize;
+}
+
+void SplitManager::markAutosaveClean()
+{
+    m_autosavedRoot = m_root.get();
+    m_autosavedRevision = m_root ? m_root->treeRevision() : 0;
+    m_autosavedMinPanelSize = m_minPanelSize;
+}
+
+QFuture<bool> SplitManager::loadLayoutAsync(const QString& filePath)
+{
+    // 序号在请求时分配：之后的任何加载都会使这次读取的结果作废
+    cancelSlicedLoad();
+    const quint64 generation = m_loadGeneration;
+    
+    auto promise = std::make_shared<QPromise<bool>>();
+    QFuture<bool> future = promise->future();
+    promise->start();
+    
+    // 【工作线程】读取文件并流式读成节点描述（与同步加载共用 SplitLayoutSerializer 的读取和校验）
+    const double defaultMinSize = m_minPanelSize;
+    QFuture<LayoutReadResult> read = runInBackground<LayoutReadResult>([filePath, defaultMinSize]() {
+        LayoutReadResult result;
+        QByteArray data;
+        result.ok = readBytesFromFile(filePath, data, &result.error)
+            && SplitLayoutSerializer::readSpec(data, defaultMinSize, result.spec, &result.error);
+        return result;
+    });
+    
+    // 【GUI 线程】分片创建节点
+    read.then(this, [this, filePath, promise, generation](LayoutReadResult result) {
+        if (generation != m_loadGeneration) {
+            // 读取期间又开始了新的加载（同步、异步或 clear）：以后发起的为准
+            LOG_INFO("SplitManager", "Asynchronous layout load superseded", {{"path", filePath}});
+            promise->addResult(false);
+            promise->finish();
+            emit layoutLoaded(filePath, false);
+            return;
+        }
+        if (!result.ok) {
+            LOG_ERROR("SplitManager", "Failed to read layout file", {
+                {"path", filePath},
+                {"error", result.error}
+            });
+            promise->addResult(false);
+            promise->finish();
+            emit layoutLoaded(filePath, false);
+            return;
+        }
+        
+        // 节点还没有创建：先通知视图预编译布局中用到的面板内容组件（不同的 qmlSource 各一次）
+        QStringList qmlSources;
+        QSet<QString> seenSources;
+        for (const SplitLayoutSerializer::NodeSpec& node : result.spec.nodes) {
+            if (node.container) continue;
+            const SplitPanelType type = m_panelTypes.resolve(node.panelType, node.qmlSource);
+            if (type && !type->qmlSource.isEmpty() && !seenSources.contains(type->qmlSource)) {
+                seenSources.insert(type->qmlSource);
+                qmlSources.append(type->qmlSource);
+            }
+        }
+        emit layoutContentSourcesRead(filePath, qmlSources);
+        
+        m_slicedLoad = std::make_unique<SlicedLoad>();
+        m_slicedLoad->filePath = filePath;
+        m_slicedLoad->generation = generation;
+        m_slicedLoad->promise = promise;
+        m_slicedLoad->spec = std::move(result.spec);
+        m_slicedLoad->built.resize(m_slicedLoad->spec.nodes.size());
+        m_slicedLoad->next = int(m_slicedLoad->spec.nodes.size()) - 1;
+        
+        scheduler()->post(this, [this, generation]() {
+            // 已被取消或被新的加载取代
+            if (!m_slicedLoad || m_slicedLoad->generation != generation) return true;
+            return stepSlicedLoad();
+        }, int(m_slicedLoad->spec.nodes.size()) + 1);
+        emit loadingChanged();
+        emit loadProgressChanged();
+    });
+    
+    return future;
+}
+
+double SplitManager::loadProgress() const
+{
+    if (!m_slicedLoad) return 1.0;
+    const int total = int(m_slicedLoad->spec.nodes.size());
+    return total > 0 ? double(total - 1 - m_slicedLoad->next) / double(total + 1) : 0.0;
+}
+
+bool SplitManager::stepSlicedLoad()
+{
+    SlicedLoad& load = *m_slicedLoad;
+    
+    if (load.next >= 0) {
+        SplitNodePool::Scope poolScope(m_nodePool);
+        load.built[size_t(load.next)] = SplitLayoutSerializer::buildNode(load.spec.nodes[size_t(load.next)],
+                                                                         load.built, this, m_panelTypes);
+        --load.next;
+        
+        const int percent = int(loadProgress() * 100);
+        if (percent != load.reportedPercent) {
+            load.reportedPercent = percent;
+            emit loadProgressChanged();
+        }
         return false;
     }
     
-    QVariantMap layout = doc.object().toVariantMap();
-    bool success = loadLayout(layout);
-    
+    // 最后一步：一次替换当前树（与 loadLayoutFromFile 相同）
+    // 先取出加载状态：提交事务时信号处理中若开始新的加载，cancelSlicedLoad 不会释放它
+    std::unique_ptr<SlicedLoad> finished = std::move(m_slicedLoad);
+    std::unique_ptr<SplitPanelNode> root = load.built.empty() ? nullptr : std::move(load.built.front());
+    const bool success = applyLoadedLayout(load.spec, std::move(root));
+    finishSlicedLoad(std::move(finished), success);
+    return true;
+}
+
+void SplitManager::finishSlicedLoad(std::unique_ptr<SlicedLoad> load, bool success)
+{
     if (success) {
-        LOG_INFO("SplitManager", "Layout loaded from file", {
-            {"path", filePath},
+        LOG_INFO("SplitManager", "Layout loaded from file asynchronously", {
+            {"path", load->filePath},
             {"panelCount", QString::number(m_panels.size())}
         });
     } else {
-        LOG_ERROR("SplitManager", "Failed to load layout from file", {{"path", filePath}});
+        LOG_ERROR("SplitManager", "Failed to load layout from file", {{"path", load->filePath}});
     }
     
-    return success;
+    load->promise->addResult(success);
+    load->promise->finish();
+    emit loadingChanged();
+    emit loadProgressChanged();
+    emit layoutLoaded(load->filePath, success);
+}
+
+void SplitManager::cancelSlicedLoad()
+{
+    // 仍在工作线程读取的加载在结果返回时检查序号，自行作废
+    ++m_loadGeneration;
+    if (!m_slicedLoad) return;
+    
+    LOG_INFO("SplitManager", "Asynchronous layout load cancelled", {{"path", m_slicedLoad->filePath}});
+    // 已创建的节点随 load 释放（尚未注册，也没有挂到当前树上）
+    std::unique_ptr<SlicedLoad> load = std::move(m_slicedLoad);
+    load->promise->addResult(false);
+    load->promise->finish();
+    emit loadingChanged();
+    emit loadProgressChanged();
+    emit layoutLoaded(load->filePath, false);
 }
 
 QString SplitManager::getDefaultLayoutPath() const
@@ -291,36 +2230,96 @@ QString SplitManager::dumpTree() const
     if (!m_root) {
         return "Empty tree";
     }
-    return dumpNode(m_root.get(), 0);
+    return flatTree().dump();
 }
 
 QVariantList SplitManager::getFlatPanelList() const
 {
-    QVariantList result;
-    collectPanels(m_root.get(), result);
-    return result;
+    return flatTree().panelObjects();
+}
+
+const SplitFlatTree& SplitManager::flatTree() const
+{
+    // 树的可序列化状态变化时根节点的 treeRevision 会增加；根被替换时指针不同
+    SplitPanelNode* root = m_root.get();
+    const quint64 revision = root ? root->treeRevision() : 0;
+    if (m_flatRoot != root || m_flatRevision != revision) {
+        m_flatTree.build(root);
+        m_flatRoot = root;
+        m_flatRevision = revision;
+    }
+    return m_flatTree;
 }
 
 // ============================================================================
-// 内部辅助方法
+// 性能统计
 // ============================================================================
 
-SplitPanelNode* SplitManager::findNode(SplitPanelNode* node, const QString& id)
+void SplitManager::setProfilingEnabled(bool enabled)
 {
-    if (!node) return nullptr;
-    if (node->nodeId() == id) return node;
+    if (SplitProfiler::isEnabled() == enabled) return;
     
-    if (node->nodeType() == SplitPanelNode::Container) {
-        auto* container = qobject_cast<ContainerNode*>(node);
-        if (auto* found = findNode(container->firstChild(), id)) {
-            return found;
-        }
-        if (auto* found = findNode(container->secondChild(), id)) {
-            return found;
-        }
+    SplitProfiler::setEnabled(enabled);
+    if (!enabled) {
+        SplitProfiler::setTraceEnabled(false);
     }
+    emit profilingChanged();
+}
+
+void SplitManager::setTraceEnabled(bool enabled)
+{
+    if (SplitProfiler::isTraceEnabled() == enabled) return;
     
-    return nullptr;
+    SplitProfiler::setTraceEnabled(enabled);
+    emit profilingChanged();
+}
+
+QVariantMap SplitManager::stats() const
+{
+    QVariantMap result = SplitProfiler::stats();
+    result["panelCount"] = m_panels.size();
+    result["nodeCount"] = m_nodes.size();
+    return result;
+}
+
+void SplitManager::resetStats()
+{
+    SplitProfiler::reset();
+}
+
+bool SplitManager::saveTrace(const QString& filePath) const
+{
+    if (!SplitProfiler::writeTrace(filePath)) {
+        LOG_ERROR("SplitManager", "Failed to write trace file", {{"path", filePath}});
+        return false;
+    }
+    
+    LOG_INFO("SplitManager", "Trace saved to file", {{"path", filePath}});
+    return true;
+}
+
+void SplitManager::recordDelegateEvent(DelegateEvent event)
+{
+    switch (event) {
+    case DelegateCreated:
+        SPLITPANEL_PROFILE_COUNT(DelegateCreated);
+        break;
+    case DelegateDestroyed:
+        SPLITPANEL_PROFILE_COUNT(DelegateDestroyed);
+        break;
+    case DelegateLoaded:
+        SPLITPANEL_PROFILE_COUNT(DelegateLoaded);
+        break;
+    }
+}
+
+// ============================================================================
+// 内部辅助方法
+// ============================================================================
+
+SplitPanelNode* SplitManager::findNode(const QString& id) const
+{
+    return m_nodes.value(id, nullptr);
 }
 
 SplitPanelNode* SplitManager::findRightmostPanel(SplitPanelNode* node)
@@ -332,20 +2331,86 @@ SplitPanelNode* SplitManager::findRightmostPanel(SplitPanelNode* node)
     }
     
     auto* container = qobject_cast<ContainerNode*>(node);
-    if (container->secondChild()) {
-        return findRightmostPanel(container->secondChild());
+    if (container->childCount() == 0) {
+        return nullptr;
     }
-    if (container->firstChild()) {
-        return findRightmostPanel(container->firstChild());
+    return findRightmostPanel(container->child(container->childCount() - 1));
+}
+
+SplitPanelNode* SplitManager::findLargestPanel(Direction* dir) const
+{
+    struct Frame {
+        SplitPanelNode* node;
+        double width;   // 相对根节点的宽度（根为 1）
+        double height;
+        int depth;
+    };
+    
+    SplitPanelNode* best = nullptr;
+    double bestArea = -1.0;
+    int bestDepth = 0;
+    bool bestWide = true;
+    
+    QList<Frame> stack;
+    if (m_root) {
+        stack.append({m_root.get(), 1.0, 1.0, 0});
     }
     
-    return nullptr;
+    while (!stack.isEmpty()) {
+        const Frame frame = stack.takeLast();
+        
+        if (frame.node->nodeType() == SplitPanelNode::Panel) {
+            const double area = frame.width * frame.height;
+            // 比较时留出浮点误差，避免等分的面板因舍入被误判大小
+            const bool larger = area > bestArea * (1.0 + 1e-9);
+            const bool sameButShallower = !larger && area >= bestArea * (1.0 - 1e-9)
+                                          && frame.depth < bestDepth;
+            if (!best || larger || sameButShallower) {
+                best = frame.node;
+                bestArea = area;
+                bestDepth = frame.depth;
+                bestWide = frame.width >= frame.height;
+            }
+            continue;
+        }
+        
+        auto* container = static_cast<ContainerNode*>(frame.node);
+        if (container->orientation() == ContainerNode::Stacked) {
+            // 标签页：只有当前标签可见，占满整个区域
+            const int current = container->currentIndex();
+            if (current >= 0) {
+                stack.append({container->child(current), frame.width, frame.height, frame.depth + 1});
+            }
+            continue;
+        }
+        const QList<qreal> sizes = container->sizes();
+        // Vertical：子节点左右排列（拆分宽度）；Horizontal：上下排列（拆分高度）
+        const bool sideBySide = container->orientation() == ContainerNode::Vertical;
+        
+        // 倒序压栈，使第一个子节点先出栈（同面积时偏向靠前的面板）
+        for (int i = container->childCount() - 1; i >= 0; --i) {
+            const double share = sizes.value(i);
+            stack.append({container->child(i),
+                          sideBySide ? frame.width * share : frame.width,
+                          sideBySide ? frame.height : frame.height * share,
+                          frame.depth + 1});
+        }
+    }
+    
+    if (dir) {
+        *dir = bestWide ? Direction::Right : Direction::Bottom;
+    }
+    return best;
 }
 
-bool SplitManager::insertPanelAt(std::unique_ptr<SplitPanelNode> panel, SplitPanelNode* target, Direction dir)
+bool SplitManager::insertPanelAt(std::unique_ptr<SplitPanelNode>&& panel, SplitPanelNode* target, Direction dir,
+                                 SplitHistoryCommand* record)
 {
     if (!target || !panel) return false;
     
+    SPLITPANEL_PROFILE_SCOPE(InsertPanel);
+    SplitNodePool::Scope poolScope(m_nodePool);
+    
     // 确定分割方向
     ContainerNode::Orientation orientation;
     bool panelIsFirst = false;
@@ -367,159 +2432,376 @@ bool SplitManager::insertPanelAt(std::unique_ptr<SplitPanelNode> panel, SplitPan
         orientation = ContainerNode::Horizontal;
         panelIsFirst = false;
         break;
+    case Center:
+        // 作为新标签加在目标之后，并切换到新标签
+        orientation = ContainerNode::Stacked;
+        panelIsFirst = false;
+        break;
     default:
         return false;
     }
-    
-    // 如果目标是根节点
-    if (target == m_root.get()) {
-        auto container = std::make_unique<ContainerNode>(generateNodeId(), orientation, this);
+    SplitPanelNode* inserted = panel.get();
+    
+    // 【情况1】目标的父容器与插入方向相同：直接插在目标旁边，分走目标一半的空间
+    // 不再创建新容器，同方向的并排面板始终位于同一个容器中
+    // 目标是某棵树（主窗口或分离窗口）的根时，新容器取代该树的根
+    auto* parentContainer = getParentContainer(target);
+    QString rootWindowId;
+    std::unique_ptr<SplitPanelNode>* rootSlot = parentContainer ? nullptr : rootSlotOf(target, &rootWindowId);
+    if (!parentContainer && !rootSlot) return false;
+    
+    if (parentContainer && parentContainer->orientation() == orientation) {
+        const int targetIndex = parentContainer->indexOf(target);
+        if (targetIndex < 0) return false;
         
-        if (panelIsFirst) {
-            container->setFirstChild(std::move(panel));
-            container->setSecondChild(std::move(m_root));
-        } else {
-            container->setFirstChild(std::move(m_root));
-            container->setSecondChild(std::move(panel));
+        if (record) {
+            record->containerId = parentContainer->nodeId();
+            record->sizesBefore = parentContainer->sizes();
+        }
+        parentContainer->insertChild(panelIsFirst ? targetIndex : targetIndex + 1,
+                                     std::move(panel), targetIndex);
+        if (orientation == ContainerNode::Stacked) {
+            parentContainer->setCurrentIndex(parentContainer->indexOf(inserted));
         }
-        
-        m_root = std::move(container);
-        emit rootNodeChanged();
         return true;
     }
     
-    // 如果目标有父节点
-    QObject* parentObj = target->parent();
-    if (!parentObj) return false;
-    
-    auto* parentContainer = qobject_cast<ContainerNode*>(parentObj);
-    if (!parentContainer) return false;
+    // 【情况2】目标本身是同方向容器（如在整行面板的右侧再加一个）：插在它的一侧，新面板占一半
+    // 与"新容器包住目标再展开"得到的比例相同，但不需要创建和销毁中间容器
+    if (target->nodeType() == SplitPanelNode::Container
+        && static_cast<ContainerNode*>(target)->orientation() == orientation) {
+        auto* targetContainer = static_cast<ContainerNode*>(target);
+        if (record) {
+            record->containerId = targetContainer->nodeId();
+            record->sizesBefore = targetContainer->sizes();
+        }
+        targetContainer->insertChildWithShare(panelIsFirst ? 0 : targetContainer->childCount(),
+                                              std::move(panel), 0.5);
+        if (orientation == ContainerNode::Stacked) {
+            targetContainer->setCurrentIndex(targetContainer->indexOf(inserted));
+        }
+        return true;
+    }
     
-    // 创建新容器
-    auto newContainer = std::make_unique<ContainerNode>(generateNodeId(), orientation, this);
+    // 【情况3】创建新容器包住目标节点
+    const int targetIndex = parentContainer ? parentContainer->indexOf(target) : -1;
+    if (parentContainer && targetIndex < 0) return false;
     
-    // 从父容器取出目标节点
-    std::unique_ptr<SplitPanelNode> targetNode;
-    if (parentContainer->firstChild() == target) {
-        targetNode = parentContainer->takeFirstChild();
-    } else if (parentContainer->secondChild() == target) {
-        targetNode = parentContainer->takeSecondChild();
-    } else {
-        return false;
+    // 重做时沿用第一次插入时的容器 ID，之后的撤销记录才能找到它
+    QString containerId = record ? record->createdContainerId : QString();
+    if (containerId.isEmpty()) {
+        containerId = generateNodeId();
     }
+    if (record) {
+        record->createdContainerId = containerId;
+    }
+    
+    auto newContainer = std::make_unique<ContainerNode>(containerId, orientation, this);
+    ContainerNode* created = newContainer.get();
+    registerNode(created);
+    
+    // 目标是根节点：先取出根节点，填好子节点后新容器再成为根节点
+    // 否则：在父容器中用新容器替换目标节点，新容器沿用目标的比例
+    std::unique_ptr<SplitPanelNode> targetNode = parentContainer
+        ? parentContainer->replaceChild(targetIndex, std::move(newContainer))
+        : std::move(*rootSlot);
     
-    // 设置新容器的子节点
     if (panelIsFirst) {
-        newContainer->setFirstChild(std::move(panel));
-        newContainer->setSecondChild(std::move(targetNode));
+        created->appendChild(std::move(panel));
+        created->appendChild(std::move(targetNode));
     } else {
-        newContainer->setFirstChild(std::move(targetNode));
-        newContainer->setSecondChild(std::move(panel));
+        created->appendChild(std::move(targetNode));
+        created->appendChild(std::move(panel));
     }
-    
-    // 将新容器放回父容器
-    if (parentContainer->firstChild() == nullptr) {
-        parentContainer->setFirstChild(std::move(newContainer));
-    } else {
-        parentContainer->setSecondChild(std::move(newContainer));
+    if (orientation == ContainerNode::Stacked) {
+        created->setCurrentIndex(created->indexOf(inserted));
     }
     
+    if (!parentContainer) {
+        *rootSlot = std::move(newContainer);
+        notifyTreeRootChanged(rootWindowId);
+    }
     return true;
 }
 
+// ============================================================================
+// 树规范化（合并同方向容器）
+// ============================================================================
 
-std::unique_ptr<SplitPanelNode> SplitManager::loadNodeFromVariant(const QVariantMap& data)
+void SplitManager::normalizeContainer(ContainerNode* container)
 {
-    QString type = data["type"].toString();
-    QString id = data["id"].toString();
+    if (!container) return;
     
-    if (type == "panel") {
-        auto panel = std::make_unique<PanelNode>(id, data["title"].toString(), this);
-        panel->setQmlSource(data["qmlSource"].toString());
-        panel->setMinSize(data.value("minSize", m_minPanelSize).toDouble());
-        
-        m_panels[id] = panel.get();
-        return panel;
-    }
-    else if (type == "container") {
-        QString orientStr = data["orientation"].toString();
-        auto orientation = (orientStr == "horizontal") 
-            ? ContainerNode::Horizontal 
-            : ContainerNode::Vertical;
+    for (int i = 0; i < container->childCount(); ) {
+        std::unique_ptr<ContainerNode> emptied = container->mergeChild(i);
+        if (!emptied) {
+            ++i;
+            continue;
+        }
+        // 被展开的子容器已清空，从索引中移除后随智能指针释放
+        // 展开进来的子节点可能仍是同方向容器，原地再检查一次
+        unregisterNode(emptied->nodeId());
+    }
+}
+
+void SplitManager::normalizeSubtree(SplitPanelNode* node)
+{
+    if (!node || node->nodeType() != SplitPanelNode::Container) return;
+    
+    auto* container = static_cast<ContainerNode*>(node);
+    for (int i = 0; i < container->childCount(); ++i) {
+        normalizeSubtree(container->child(i));
+    }
+    normalizeContainer(container);
+}
+
+// ============================================================================
+// 加载时的压缩和校验
+// ============================================================================
+
+QVariantMap SplitManager::LoadRepair::toVariant() const
+{
+    return QVariantMap{
+        {"collapsedContainers", collapsedContainers},
+        {"removedContainers", removedContainers},
+        {"mergedContainers", mergedContainers},
+        {"repairedSizes", repairedSizes},
+        {"clampedMinSizes", clampedMinSizes},
+        {"minSizeScale", minSizeScale},
+        {"minSizeCheckDeferred", minSizeCheckDeferred}
+    };
+}
+
+void SplitManager::compactLoadedTree()
+{
+    SPLITPANEL_PROFILE_SCOPE(CompactLoadedTree);
+    
+    LoadRepair repair;
+    if (m_root && m_root->nodeType() == SplitPanelNode::Container) {
+        auto* root = static_cast<ContainerNode*>(m_root.get());
+        compactContainer(root, repair);
         
-        auto container = std::make_unique<ContainerNode>(id, orientation, this);
-        container->setSplitRatio(data.value("splitRatio", 0.5).toDouble());
-        container->setMinSize(data.value("minSize", m_minPanelSize).toDouble());
+        // 根容器只剩一个子节点时同样由子节点替换；空的根容器删除，得到与空布局相同的状态
+        // （保留时 addPanel 既不走空树分支，也找不到目标面板，窗口里再也加不了面板）
+        if (root->childCount() == 0) {
+            unregisterNode(root->nodeId());
+            m_root.reset();
+            ++repair.removedContainers;
+        } else if (root->childCount() == 1) {
+            // 新根节点没有 Qt 父对象，否则会随旧根容器一起释放
+            std::unique_ptr<SplitPanelNode> only = root->takeChild(0);
+            only->setParent(nullptr);
+            unregisterNode(root->nodeId());
+            m_root = std::move(only);
+            ++repair.collapsedContainers;
+        }
+    }
+    // 主窗口视口未知（窗口尚未显示）时推迟到第一次 setViewportSize
+    const auto viewport = m_viewports.constFind(QString());
+    if (viewport != m_viewports.constEnd() && !viewport->isEmpty()) {
+        m_pendingMinSizeChecks.remove(QString());
+        if (m_root) clampInfeasibleMinSizes(m_root.get(), viewport.value(), repair);
+    } else if (m_root) {
+        m_pendingMinSizeChecks.insert(QString());
+        repair.minSizeCheckDeferred = true;
+    }
+    
+    m_lastLoadReport = repair.toVariant();
+    if (!repair.isEmpty()) {
+        LOG_INFO("SplitManager", "Loaded layout compacted", {
+            {"collapsed", QString::number(repair.collapsedContainers)},
+            {"removed", QString::number(repair.removedContainers)},
+            {"merged", QString::number(repair.mergedContainers)},
+            {"repairedSizes", QString::number(repair.repairedSizes)},
+            {"clampedMinSizes", QString::number(repair.clampedMinSizes)},
+            {"minSizeScale", QString::number(repair.minSizeScale)}
+        });
+    }
+}
+
+void SplitManager::compactContainer(ContainerNode* container, LoadRepair& repair)
+{
+    for (int i = 0; i < container->childCount(); ) {
+        auto* inner = qobject_cast<ContainerNode*>(container->child(i));
+        if (!inner) {
+            ++i;
+            continue;
+        }
         
-        if (data.contains("first")) {
-            container->setFirstChild(loadNodeFromVariant(data["first"].toMap()));
+        compactContainer(inner, repair);
+        if (inner->childCount() == 0) {
+            std::unique_ptr<SplitPanelNode> removed = container->takeChild(i);
+            unregisterNode(removed->nodeId());
+            ++repair.removedContainers;
+            continue;
         }
-        if (data.contains("second")) {
-            container->setSecondChild(loadNodeFromVariant(data["second"].toMap()));
+        if (inner->childCount() == 1) {
+            // 孙节点沿用容器的比例；它已经压缩过，下面只需检查能否展开
+            std::unique_ptr<SplitPanelNode> collapsed = container->replaceChild(i, inner->takeChild(0));
+            unregisterNode(collapsed->nodeId());
+            ++repair.collapsedContainers;
         }
         
-        return container;
+        const int before = container->childCount();
+        if (std::unique_ptr<ContainerNode> emptied = container->mergeChild(i)) {
+            unregisterNode(emptied->nodeId());
+            ++repair.mergedContainers;
+            // 展开进来的子节点已经压缩过，且不会与本容器同方向（否则已在子容器中展开）
+            i += container->childCount() - before + 1;
+            continue;
+        }
+        ++i;
     }
     
-    return nullptr;
+    // 展开后的比例是两层比例的乘积，深层长链可能低于 MinChildShare
+    if (container->setSizes(container->sizes())) {
+        ++repair.repairedSizes;
+    }
+    // 子节点的最小尺寸已缓存，这里只汇总一层；clampInfeasibleMinSizes 直接使用结果
+    SplitLayoutSolver::minimumSize(container);
 }
 
-QString SplitManager::generateNodeId()
+void SplitManager::clampInfeasibleMinSizes(SplitPanelNode* root, const QSizeF& viewport, LoadRepair& repair)
 {
-    return QString("node_%1").arg(++m_nodeIdCounter);
+    const QSizeF minimum = SplitLayoutSolver::minimumSize(root);
+    const double scale = qMin(viewport.width() / minimum.width(),
+                              viewport.height() / minimum.height());
+    if (!(scale < 1.0)) return;
+    
+    repair.minSizeScale = scale;
+    std::vector<SplitPanelNode*> stack{root};
+    while (!stack.empty()) {
+        SplitPanelNode* node = stack.back();
+        stack.pop_back();
+        
+        const double minSize = node->minSize();
+        node->setMinSize(minSize * scale);
+        if (node->minSize() < minSize) {
+            ++repair.clampedMinSizes;
+        }
+        if (node->nodeType() == SplitPanelNode::Container) {
+            auto* container = static_cast<ContainerNode*>(node);
+            for (int i = 0; i < container->childCount(); ++i) {
+                stack.push_back(container->child(i));
+            }
+        }
+    }
+    LOG_WARNING("SplitManager", "Layout minimum sizes exceed the viewport, scaled down", {
+        {"rootId", root->nodeId()},
+        {"minimumWidth", QString::number(minimum.width())},
+        {"minimumHeight", QString::number(minimum.height())},
+        {"viewportWidth", QString::number(viewport.width())},
+        {"viewportHeight", QString::number(viewport.height())}
+    });
 }
 
-int SplitManager::countPanels(SplitPanelNode* node) const
+bool SplitManager::applyLoadedLayout(const SplitLayoutSerializer::LayoutSpec& spec,
+                                     std::unique_ptr<SplitPanelNode> root)
 {
-    if (!node) return 0;
+    if (!SplitLayoutSerializer::isSupportedVersion(spec.version)) {
+        LOG_WARNING("SplitManager", "Incompatible layout version");
+        return false;
+    }
     
-    if (node->nodeType() == SplitPanelNode::Panel) {
-        return 1;
+    // 与 loadLayout 相同：清空和重建合并为一次更新
+    Transaction transaction(this);
+    
+    clear();
+    
+    if (spec.hasMinPanelSize) {
+        setMinPanelSize(spec.minPanelSize);
     }
     
-    auto* container = qobject_cast<ContainerNode*>(node);
-    return countPanels(container->firstChild()) + countPanels(container->secondChild());
+    if (spec.hasRoot) {
+        // 压缩后整棵树可能为空（只有空容器），仍视为加载成功
+        const bool built = root != nullptr;
+        m_root = std::move(root);
+        registerSubtree(m_root.get());
+        compactLoadedTree();
+        notifyRootNodeChanged();
+        notifyPanelCountChanged();
+        notifyLayoutChanged();
+        return built;
+    }
+    
+    return true;
 }
 
-QString SplitManager::dumpNode(SplitPanelNode* node, int indent) const
+void SplitManager::registerSubtree(SplitPanelNode* node)
 {
-    if (!node) return "";
-    
-    QString indentStr = QString(indent * 2, ' ');
-    QString result;
+    if (!node) return;
     
     if (node->nodeType() == SplitPanelNode::Panel) {
-        auto* panel = qobject_cast<PanelNode*>(node);
-        result = QString("%1Panel[%2]: %3\n")
-            .arg(indentStr)
-            .arg(panel->nodeId())
-            .arg(panel->title());
-    } else {
-        auto* container = qobject_cast<ContainerNode*>(node);
-        QString orientStr = container->orientation() == ContainerNode::Horizontal ? "H" : "V";
-        result = QString("%1Container[%2]: %3 (ratio: %4)\n")
-            .arg(indentStr)
-            .arg(container->nodeId())
-            .arg(orientStr)
-            .arg(container->splitRatio());
-        
-        result += dumpNode(container->firstChild(), indent + 1);
-        result += dumpNode(container->secondChild(), indent + 1);
+        registerPanel(node->nodeId(), static_cast<PanelNode*>(node));
+        return;
     }
     
-    return result;
+    auto* container = static_cast<ContainerNode*>(node);
+    registerNode(container);
+    for (int i = 0; i < container->childCount(); ++i) {
+        registerSubtree(container->child(i));
+    }
 }
 
-void SplitManager::collectPanels(SplitPanelNode* node, QVariantList& panels) const
+QByteArray SplitManager::serializeLayout(int format) const
 {
-    if (!node) return;
-    
-    if (node->nodeType() == SplitPanelNode::Panel) {
-        panels.append(QVariant::fromValue(qobject_cast<PanelNode*>(node)));
+    if (format == BinaryFormat) {
+        return SplitLayoutSerializer::toCbor(flatTree(), m_minPanelSize);
+    }
+    const QJsonObject layout = SplitLayoutSerializer::toJson(flatTree(), m_minPanelSize);
+    return QJsonDocument(layout).toJson(QJsonDocument::Indented);
+}
+
+QString SplitManager::generateNodeId()
+{
+    return nextFreeId(QStringLiteral("node_"), m_nodeIdCounter);
+}
+
+QString SplitManager::generatePanelId()
+{
+    return nextFreeId(QStringLiteral("panel_"), m_panelIdCounter);
+}
+
+QString SplitManager::nextFreeId(const QString& prefix, quint64& counter) const
+{
+    // 调用方自己指定的 ID 可能占用了后面的序号（如 addPanel("node_9", ...)），跳过即可
+    QString id;
+    do {
+        id = prefix + QString::number(++counter);
+    } while (m_nodes.contains(id));
+    return id;
+}
+
+bool SplitManager::isFreeNodeId(const QString& nodeId) const
+{
+    if (nodeId.isEmpty() || m_nodes.contains(nodeId)) {
+        LOG_ERROR("SplitManager", QString("Panel id is empty or already in use: %1").arg(nodeId));
+        return false;
+    }
+    return true;
+}
+
+void SplitManager::noteNodeId(const QString& nodeId)
+{
+    static const QString nodePrefix = QStringLiteral("node_");
+    static const QString panelPrefix = QStringLiteral("panel_");
+    
+    quint64* counter = nullptr;
+    qsizetype prefixLength = 0;
+    if (nodeId.startsWith(nodePrefix)) {
+        counter = &m_nodeIdCounter;
+        prefixLength = nodePrefix.size();
+    } else if (nodeId.startsWith(panelPrefix)) {
+        counter = &m_panelIdCounter;
+        prefixLength = panelPrefix.size();
     } else {
-        auto* container = qobject_cast<ContainerNode*>(node);
-        collectPanels(container->firstChild(), panels);
-        collectPanels(container->secondChild(), panels);
+        return;
+    }
+    
+    bool ok = false;
+    const quint64 serial = QStringView(nodeId).mid(prefixLength).toULongLong(&ok);
+    if (ok && serial > *counter) {
+        *counter = serial;
     }
 }
 
@@ -538,38 +2820,77 @@ std::unique_ptr<PanelNode> SplitManager::createPanelNode(
     const QString& title,
     const QString& qmlSource)
 {
-    auto panel = std::make_unique<PanelNode>(id, title, this);
-    panel->setQmlSource(qmlSource);
-    panel->setMinSize(m_minPanelSize);
+    SplitNodePool::Scope poolScope(m_nodePool);
+    const SplitPanelType type = m_panelTypes.resolve(qmlSource);
+    auto panel = std::make_unique<PanelNode>(id, panelTitleFor(type, title), this);
+    panel->setType(type);
+    panel->setMinSize(panelMinSizeFor(type));
     return panel;
 }
 
+QString SplitManager::panelTitleFor(const SplitPanelType& type, const QString& title) const
+{
+    if (!type || type->defaultTitle.isEmpty()) {
+        return title;
+    }
+    // 与默认标题相同时直接共享类型中的字符串
+    return (title.isEmpty() || title == type->defaultTitle) ? type->defaultTitle : title;
+}
+
+double SplitManager::panelMinSizeFor(const SplitPanelType& type) const
+{
+    return (type && type->defaultMinSize > 0) ? type->defaultMinSize : m_minPanelSize;
+}
+
 void SplitManager::registerPanel(const QString& panelId, PanelNode* panel)
 {
     // 将面板指针添加到哈希表，用于快速查找 O(1)
     m_panels[panelId] = panel;
+    registerNode(panel);
 }
 
 void SplitManager::unregisterPanel(const QString& panelId)
 {
     // 从哈希表中移除面板指针（不影响实际节点的生命周期）
     m_panels.remove(panelId);
+    m_panelVisibility.remove(panelId);
+    m_panelStates.remove(panelId);
+    unregisterNode(panelId);
+}
+
+void SplitManager::registerNode(SplitPanelNode* node)
+{
+    if (!node) return;
+    // 面板和容器共用一张索引表，findNode 据此实现 O(1) 查找
+    m_nodes[node->nodeId()] = node;
+    noteNodeId(node->nodeId());
+    
+    // 批量修改期间新建的节点同样延迟信号，commitBatch 时统一补发
+    if (m_batchDepth > 0) {
+        node->setSignalsDeferred(true);
+    }
+}
+
+void SplitManager::unregisterNode(const QString& nodeId)
+{
+    // 只移除索引，节点本身由智能指针管理
+    m_nodes.remove(nodeId);
 }
 
 void SplitManager::setAsRoot(std::unique_ptr<SplitPanelNode> node)
 {
     // 设置新的根节点，旧根节点自动释放（智能指针）
     m_root = std::move(node);
-    // 立即通知 QML 根节点已改变
-    emit rootNodeChanged();
+    // 立即通知 QML 根节点已改变（批量修改期间延迟到提交时）
+    notifyRootNodeChanged();
 }
 
 void SplitManager::emitPanelAddedSignals(const QString& panelId)
 {
     // 统一发送面板添加相关的三个信号
-    emit panelCountChanged();  // 更新面板计数
-    emit panelAdded(panelId);  // 通知具体哪个面板被添加
-    emit layoutChanged();      // 通知布局已改变
+    notifyPanelCountChanged();  // 更新面板计数
+    notifyPanelAdded(panelId);  // 通知具体哪个面板被添加
+    notifyLayoutChanged();      // 通知布局已改变
 }
 
 void SplitManager::emitPanelRemovedSignals(const QString& panelId)
@@ -578,10 +2899,10 @@ void SplitManager::emitPanelRemovedSignals(const QString& panelId)
     // 原因：QTimer::singleShot 会延迟发送信号到事件循环的下一轮
     //       此时父容器可能已被智能指针删除，导致 QML 访问空指针崩溃
     // 修复：改为立即发送，确保信号在节点树重组完成后立即通知 QML 更新
-    emit rootNodeChanged();
-    emit panelCountChanged();
-    emit panelRemoved(panelId);
-    emit layoutChanged();
+    notifyRootNodeChanged();
+    notifyPanelCountChanged();
+    notifyPanelRemoved(panelId);
+    notifyLayoutChanged();
 }
 
 std::pair<std::unique_ptr<SplitPanelNode>, bool> SplitManager::takeSiblingNode(
@@ -592,19 +2913,15 @@ std::pair<std::unique_ptr<SplitPanelNode>, bool> SplitManager::takeSiblingNode(
         return {nullptr, false};
     }
     
-    // 判断目标子节点是第一个还是第二个
-    bool isFirst = (parent->firstChild() == targetChild);
-    
-    if (isFirst) {
-        // 目标是第一个子节点，取出第二个子节点（兄弟）
-        return {parent->takeSecondChild(), true};
-    } else if (parent->secondChild() == targetChild) {
-        // 目标是第二个子节点，取出第一个子节点（兄弟）
-        return {parent->takeFirstChild(), false};
+    // 只用于只有两个子节点的容器（更多子节点时 removePanel 直接移除面板）
+    const int index = parent->indexOf(targetChild);
+    if (index < 0 || parent->childCount() != 2) {
+        // 目标子节点不在父容器中（理论上不应该发生）
+        return {nullptr, false};
     }
     
-    // 目标子节点不在父容器中（理论上不应该发生）
-    return {nullptr, false};
+    const bool isFirst = (index == 0);
+    return {parent->takeChild(isFirst ? 1 : 0), isFirst};
 }
 
 bool SplitManager::replaceChildInContainer(
@@ -616,57 +2933,69 @@ bool SplitManager::replaceChildInContainer(
         return false;
     }
     
-    // 设置新子节点的 Qt 父对象（用于内存管理和对象树）
-    if (newChild) {
-        newChild->setParent(container);
+    // 在容器中查找旧子节点，并用新子节点替换（新子节点沿用旧子节点的比例）
+    const int index = container->indexOf(oldChild);
+    if (index < 0) {
+        // 旧子节点不在容器中
+        return false;
     }
     
-    // 在容器中查找旧子节点，并用新子节点替换
-    if (container->firstChild() == oldChild) {
-        // 旧子节点是第一个子节点
-        container->setFirstChild(std::move(newChild));
-        return true;
-    } else if (container->secondChild() == oldChild) {
-        // 旧子节点是第二个子节点
-        container->setSecondChild(std::move(newChild));
+    if (!newChild) {
+        container->takeChild(index);
         return true;
     }
     
-    // 旧子节点不在容器中
-    return false;
+    // 旧子节点随返回的智能指针释放
+    container->replaceChild(index, std::move(newChild));
+    return true;
 }
 
 ContainerNode* SplitManager::getParentContainer(SplitPanelNode* node)
 {
-    if (!node) return nullptr;
-    // 获取 Qt 父对象，并尝试转换为 ContainerNode
-    // 如果父对象不是 ContainerNode，返回 nullptr
-    return qobject_cast<ContainerNode*>(node->parent());
+    // 节点自己记录所在容器（adopt 时设置、取出时清空），不再经过 QObject 父对象和 qobject_cast
+    return node ? node->parentContainer() : nullptr;
 }
 
 bool SplitManager::promoteSiblingNode(
     ContainerNode* parentContainer,
-    std::unique_ptr<SplitPanelNode> sibling)
+    std::unique_ptr<SplitPanelNode> sibling,
+    bool normalize)
 {
     if (!parentContainer) return false;
     
-    // 【情况1】父容器是根节点，直接替换根节点
+    // 父容器无论走哪个分支都会被销毁（被兄弟节点替换），先从索引中移除
+    unregisterNode(parentContainer->nodeId());
+    
+    // 【情况1】父容器是根节点（主窗口或分离窗口的树），直接替换根节点
     // 删除前树结构：root(container) -> [panel, sibling]
     // 删除后树结构：root(sibling)
-    if (parentContainer == m_root.get()) {
+    if (!getParentContainer(parentContainer)) {
+        QString windowId;
+        std::unique_ptr<SplitPanelNode>* rootSlot = rootSlotOf(parentContainer, &windowId);
+        if (!rootSlot) {
+            LOG_ERROR("SplitManager", "Parent container is not the root of any window");
+            return false;
+        }
+        
         if (sibling) {
             // 【关键修复】先设置兄弟节点的Qt父对象为nullptr（根节点没有父对象）
             // 这样当m_root替换时，QML绑定访问sibling的parent()会返回nullptr而不是旧的container
             sibling->setParent(nullptr);
             
             // 兄弟节点提升为新根节点
-            m_root = std::move(sibling);
+            *rootSlot = std::move(sibling);
             LOG_DEBUG("SplitManager", "Parent is root, replacing root with sibling");
         } else {
             // 没有兄弟节点，树变为空
-            m_root.reset();
+            rootSlot->reset();
             LOG_DEBUG("SplitManager", "Parent is root, no sibling, clearing root");
         }
+        
+        // 主窗口的根节点信号由调用者统一发送（见 emitPanelRemovedSignals）
+        if (!windowId.isEmpty()) {
+            removeEmptyWindows();
+            notifyWindowsChanged();
+        }
         return true;
     }
     
@@ -680,8 +3009,16 @@ bool SplitManager::promoteSiblingNode(
     }
     
     // 在祖父容器中用兄弟节点替换父容器
+    const int slotIndex = grandParent->indexOf(parentContainer);
+    const bool hasSibling = sibling != nullptr;
     if (replaceChildInContainer(grandParent, parentContainer, std::move(sibling))) {
         LOG_DEBUG("SplitManager", "Replaced parent container with sibling in grandparent");
+        // 兄弟节点是与祖父容器同方向的容器时展开合并（其余子节点未变，不必检查）
+        if (normalize && hasSibling) {
+            if (std::unique_ptr<ContainerNode> emptied = grandParent->mergeChild(slotIndex)) {
+                unregisterNode(emptied->nodeId());
+            }
+        }
         return true;
     }
     
@@ -699,23 +3036,99 @@ void SplitManager::finalizePanelRemoval(const QString& panelId)
     LOG_DEBUG("SplitManager", QString("New panel count: %1").arg(m_panels.size()));
 }
 
+// ============================================================================
+// 信号发送（批量修改期间延迟）
+// ============================================================================
+
+void SplitManager::notifyRootNodeChanged()
+{
+    if (m_batchDepth > 0) {
+        m_pendingSignals.rootNodeChanged = true;
+        return;
+    }
+    emit rootNodeChanged();
+}
+
+void SplitManager::notifyWindowsChanged()
+{
+    if (m_batchDepth > 0) {
+        m_pendingSignals.windowsChanged = true;
+        return;
+    }
+    emit windowsChanged();
+}
+
+void SplitManager::notifyTreeRootChanged(const QString& windowId)
+{
+    if (windowId.isEmpty()) {
+        notifyRootNodeChanged();
+    } else {
+        notifyWindowsChanged();
+    }
+}
+
+void SplitManager::notifyPanelCountChanged()
+{
+    if (m_batchDepth > 0) {
+        m_pendingSignals.panelCountChanged = true;
+        return;
+    }
+    emit panelCountChanged();
+}
+
+void SplitManager::notifyLayoutChanged()
+{
+    if (m_batchDepth > 0) {
+        m_pendingSignals.layoutChanged = true;
+        return;
+    }
+    emit layoutChanged();
+}
+
+void SplitManager::notifyPanelAdded(const QString& panelId)
+{
+    if (m_batchDepth > 0) {
+        m_pendingSignals.addedPanels.append(panelId);
+        return;
+    }
+    emitPanelNotices({}, {panelId});
+}
+
+void SplitManager::notifyPanelRemoved(const QString& panelId)
+{
+    if (m_batchDepth > 0) {
+        // 同一批次内先添加后删除的面板对外不可见，两条通知互相抵消
+        if (m_pendingSignals.addedPanels.removeOne(panelId)) {
+            return;
+        }
+        m_pendingSignals.removedPanels.append(panelId);
+        return;
+    }
+    emitPanelNotices({panelId}, {});
+}
+
 // ============================================================================
 // 静态辅助方法实现
 // ============================================================================
 
-bool SplitManager::writeJsonToFile(const QString& filePath, const QJsonDocument& jsonDoc)
+bool SplitManager::writeBytesToFile(const QString& filePath, const QByteArray& data)
 {
-    QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    // QSaveFile 先写临时文件，commit() 时原子替换目标文件
+    // 二进制格式不能用 Text 模式（会改写换行字节），JSON 输出本身只含 \n，统一按二进制写入
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
         return false;
     }
     
-    qint64 bytesWritten = file.write(jsonDoc.toJson(QJsonDocument::Indented));
-    file.close();
-    return bytesWritten > 0;
+    qint64 bytesWritten = file.write(data);
+    if (bytesWritten != data.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
 }
 
-bool SplitManager::readJsonFromFile(const QString& filePath, QJsonDocument& outDoc, QString* errorMsg)
+bool SplitManager::readBytesFromFile(const QString& filePath, QByteArray& outData, QString* errorMsg)
 {
     QFile file(filePath);
     if (!file.exists()) {
@@ -723,27 +3136,13 @@ bool SplitManager::readJsonFromFile(const QString& filePath, QJsonDocument& outD
         return false;
     }
     
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         if (errorMsg) *errorMsg = "Failed to open file";
         return false;
     }
     
-    QByteArray data = file.readAll();
+    outData = file.readAll();
     file.close();
-    
-    QJsonParseError parseError;
-    outDoc = QJsonDocument::fromJson(data, &parseError);
-    
-    if (parseError.error != QJsonParseError::NoError) {
-        if (errorMsg) *errorMsg = parseError.errorString();
-        return false;
-    }
-    
-    if (!outDoc.isObject()) {
-        if (errorMsg) *errorMsg = "JSON root is not an object";
-        return false;
-    }
-    
     return true;
 }
 
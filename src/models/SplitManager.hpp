@@ -5,12 +5,22 @@
 #include <QString>
 #include <QVariantMap>
 #include <QHash>
-#include <QtQml/qqmlregistration.h>
+#include <QSet>
+#include <QStringList>
 #include <QFile>
 #include <QDir>
-#include <QJsonDocument>
+#include <QFuture>
+#include <QElapsedTimer>
 #include <memory>
+#include <vector>
 #include "SplitPanelNode.hpp"
+#include "SplitFlatTree.hpp"
+#include "SplitLayoutSerializer.hpp"
+#include "SplitHistory.hpp"
+#include "../utils/SplitFrameScheduler.hpp"
+#include "../utils/SplitProfiler.hpp"
+
+class QTimer;
 
 /**
  * ============================================================================
@@ -42,7 +52,6 @@
  */
 class SplitManager : public QObject {
     Q_OBJECT
-    QML_ELEMENT
     
     // ========================================================================
     // QML 属性
@@ -66,6 +75,47 @@ class SplitManager : public QObject {
     // false: 优先加载JSON，INI作为默认模板（正式使用）
     Q_PROPERTY(bool devMode READ devMode WRITE setDevMode NOTIFY devModeChanged)
     
+    // placementStrategy - addPanel 自动选择插入位置的策略（PlacementStrategy）
+    Q_PROPERTY(PlacementStrategy placementStrategy READ placementStrategy
+               WRITE setPlacementStrategy NOTIFY placementStrategyChanged)
+    
+    // hibernationSizeThreshold - 面板宽或高小于该值（像素）时休眠，0 = 不按尺寸休眠
+    Q_PROPERTY(double hibernationSizeThreshold READ hibernationSizeThreshold
+               WRITE setHibernationSizeThreshold NOTIFY hibernationPolicyChanged)
+    
+    // hibernationDelay - 面板连续不可见超过该时间（毫秒）后休眠，0 = 不按可见性休眠
+    Q_PROPERTY(int hibernationDelay READ hibernationDelay WRITE setHibernationDelay NOTIFY hibernationPolicyChanged)
+    
+    // canUndo / canRedo - 是否有可撤销/重做的步骤
+    Q_PROPERTY(bool canUndo READ canUndo NOTIFY historyChanged)
+    Q_PROPERTY(bool canRedo READ canRedo NOTIFY historyChanged)
+    
+    // historyLimit - 最多保留的撤销步骤数（超出时丢弃最早的）
+    Q_PROPERTY(int historyLimit READ historyLimit WRITE setHistoryLimit NOTIFY historyChanged)
+    
+    // profilingEnabled / traceEnabled - 热路径计时与计数（进程级，见 SplitProfiler）
+    Q_PROPERTY(bool profilingEnabled READ profilingEnabled WRITE setProfilingEnabled NOTIFY profilingChanged)
+    Q_PROPERTY(bool traceEnabled READ traceEnabled WRITE setTraceEnabled NOTIFY profilingChanged)
+    
+    // autosaveEnabled / autosavePath - 自动保存开关和目标文件（默认 getDefaultLayoutPath()）
+    Q_PROPERTY(bool autosaveEnabled READ autosaveEnabled WRITE setAutosaveEnabled NOTIFY autosaveChanged)
+    Q_PROPERTY(QString autosavePath READ autosavePath WRITE setAutosavePath NOTIFY autosaveChanged)
+    
+    // autosaveDelay / autosaveMaxLatency - 停止修改多久后写入、第一次修改后最迟多久写入（毫秒）
+    Q_PROPERTY(int autosaveDelay READ autosaveDelay WRITE setAutosaveDelay NOTIFY autosaveChanged)
+    Q_PROPERTY(int autosaveMaxLatency READ autosaveMaxLatency WRITE setAutosaveMaxLatency NOTIFY autosaveChanged)
+    
+    // scheduler - 分片执行大操作的调度器（GUI 线程共用，frameBudget / busy / progress 见 SplitFrameScheduler）
+    Q_PROPERTY(SplitFrameScheduler* scheduler READ scheduler CONSTANT)
+    
+    // loading / loadProgress - 异步加载是否在进行、节点创建进度（0~1）
+    Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged)
+    Q_PROPERTY(double loadProgress READ loadProgress NOTIFY loadProgressChanged)
+    
+    // windowIds / windowRoots - 分离窗口的 ID（按创建顺序）和各窗口的根节点（ID → 节点），主窗口的树仍是 rootNode
+    Q_PROPERTY(QStringList windowIds READ windowIds NOTIFY windowsChanged)
+    Q_PROPERTY(QVariantMap windowRoots READ windowRoots NOTIFY windowsChanged)
+
 public:
     // ========================================================================
     // 方向枚举（用于 addPanelAt）
@@ -75,7 +125,7 @@ public:
      * 添加面板的方向
      * Left/Right：在目标面板左侧/右侧添加
      * Top/Bottom：在目标面板上方/下方添加
-     * Center：替换目标面板（暂未使用）
+     * Center：作为新标签加入目标所在的标签页（目标不在标签页中时与新面板组成标签页）
      * 
      * QML 使用：DockingManager.Left, SplitManager.Right 等
      */
@@ -88,6 +138,44 @@ public:
     };
     Q_ENUM(Direction)  // 注册到 Qt 元对象系统
     
+    /**
+     * 布局文件格式
+     * JsonFormat：可读 JSON（默认，layout.json）
+     * BinaryFormat：CBOR + 字符串表，体积小、解析快
+     * 
+     * 加载时根据文件头自动识别，无需指定格式
+     * QML 使用：SplitManager.BinaryFormat
+     */
+    enum LayoutFormat {
+        JsonFormat = 0,
+        BinaryFormat = 1
+    };
+    Q_ENUM(LayoutFormat)
+    
+    /**
+     * addPanel 的自动放置策略
+     * AppendRight：拆分最右侧的面板（默认，原有行为；面板多时树退化为右倾链）
+     * Balanced：拆分面积最大的面板（同面积取最浅的），沿其较长的一边对半分，
+     *           树深度保持 O(log n)，QML Loader 嵌套层数也随之变浅
+     */
+    enum PlacementStrategy {
+        AppendRight = 0,
+        Balanced = 1
+    };
+    Q_ENUM(PlacementStrategy)
+    
+    /**
+     * QML 委托事件（recordDelegateEvent 的参数）
+     * DelegateCreated/DelegateDestroyed：节点委托（SplitNodeRenderer、容器的子节点 Loader）创建/销毁
+     * DelegateLoaded：节点委托加载了新的视图组件（节点类型变化或首次加载）
+     */
+    enum DelegateEvent {
+        DelegateCreated = 0,
+        DelegateDestroyed = 1,
+        DelegateLoaded = 2
+    };
+    Q_ENUM(DelegateEvent)
+    
     /**
      * 构造函数
      * 参数：parent - Qt 父对象
@@ -95,6 +183,12 @@ public:
      */
     explicit SplitManager(QObject* parent = nullptr);
     
+    /**
+     * 析构函数
+     * 等待尚未完成的异步保存写完，避免退出时布局文件只写了一半
+     */
+    ~SplitManager() override;
+    
     // ========================================================================
     // 属性访问器
     // ========================================================================
@@ -113,6 +207,25 @@ public:
      */
     int panelCount() const { return m_panels.size(); }
     
+    /**
+     * 节点树的扁平副本（C++ 接口，不暴露给 QML）
+     * 返回：按需重建并缓存的 SplitFlatTree，树未修改时重复调用不会重建
+     * 用途：dumpTree/getFlatPanelList/saveLayout/序列化等整树只读遍历
+     * 注意：引用在下次修改树之后失效，需要跨线程使用时复制一份
+     */
+    const SplitFlatTree& flatTree() const;
+    
+    /**
+     * 按 ID 查找节点（面板或容器）
+     * 参数：id - 要查找的节点 ID
+     * 返回：找到返回指针，否则返回 nullptr
+     * 
+     * 用途：C++ 接口（SplitTreeModel 按 ID 查索引），QML 使用 findPanel
+     * 实现：直接查询 m_nodes 统一索引，O(1)
+     *   拖动分割条时 updateSplitRatio 每帧都会调用，不能再递归遍历整棵树
+     */
+    SplitPanelNode* findNode(const QString& id) const;
+    
     /**
      * 获取最小面板尺寸
      */
@@ -146,6 +259,17 @@ public:
         }
     }
     
+    /**
+     * 获取/设置 addPanel 的放置策略（只影响之后添加的面板）
+     */
+    PlacementStrategy placementStrategy() const { return m_placementStrategy; }
+    void setPlacementStrategy(PlacementStrategy strategy) {
+        if (m_placementStrategy != strategy) {
+            m_placementStrategy = strategy;
+            emit placementStrategyChanged();
+        }
+    }
+    
     // ========================================================================
     // 核心 API（可从 QML 调用）
     // ========================================================================
@@ -154,19 +278,27 @@ public:
      * 创建面板（仅创建，不添加到树中）
      * 参数：
      *   title - 面板标题
-     *   qmlSource - QML 内容文件路径
+     *   qmlSource - 已注册的面板类型键，或 QML 内容文件路径
      * 返回：创建的 PanelNode 指针
      * 用途：暂未使用，保留接口
      */
     Q_INVOKABLE PanelNode* createPanel(const QString& title, const QString& qmlSource = "");
     
+    /**
+     * 生成未被占用的面板 ID（"panel_1", "panel_2", ...）
+     * 计数器在登记节点时越过已有的同前缀 ID（加载的布局、应用的预设），
+     * 生成的 ID 不会与当前任何节点重复，也不会重复使用已删除节点的 ID
+     * QML 调用：splitManager.addPanel(splitManager.generatePanelId(), "新面板", "content")
+     */
+    Q_INVOKABLE QString generatePanelId();
+    
     /**
      * 添加面板（自动选择位置）
      * 参数：
-     *   panelId - 面板唯一 ID
-     *   title - 面板标题
-     *   qmlSource - QML 内容文件路径
-     * 返回：成功返回 true
+     *   panelId - 面板唯一 ID（可用 generatePanelId() 生成）
+     *   title - 面板标题（为空时使用面板类型的默认标题）
+     *   qmlSource - 已注册的面板类型键，或 QML 内容文件路径
+     * 返回：成功返回 true；panelId 为空或已被占用时返回 false
      * 
      * 逻辑：
      *   1. 如果树为空：创建面板作为根节点
@@ -180,11 +312,11 @@ public:
      * 在指定位置添加面板（核心方法）
      * 参数：
      *   panelId - 新面板的唯一 ID
-     *   title - 面板标题
-     *   qmlSource - QML 内容文件路径
+     *   title - 面板标题（为空时使用面板类型的默认标题）
+     *   qmlSource - 已注册的面板类型键，或 QML 内容文件路径
      *   targetId - 目标面板 ID（在哪个面板旁边添加）
-     *   direction - 方向（Left/Right/Top/Bottom）
-     * 返回：成功返回 true
+     *   direction - 方向（Left/Right/Top/Bottom/Center）
+     * 返回：成功返回 true；panelId 为空或已被占用时返回 false
      * 
      * 逻辑：
      *   1. 创建新 PanelNode
@@ -217,6 +349,19 @@ public:
      */
     Q_INVOKABLE bool removePanel(const QString& panelId);
     
+    /**
+     * 批量删除面板
+     * 参数：panelIds - 面板 ID 列表（不存在的跳过）
+     * 返回：实际删除的面板数
+     * 
+     * 说明：
+     *   全部删除合并为一次批量修改（QML 只更新一次，撤销为一步）
+     *   删除的面板较多时 panelRemoved 通知经调度器分片补发，见 commitBatch()
+     * 
+     * QML 调用：dockingManager.removePanels(["panel_1", "panel_2"])
+     */
+    Q_INVOKABLE int removePanels(const QStringList& panelIds);
+    
     /**
      * 查找面板
      * 参数：panelId - 面板 ID
@@ -235,6 +380,67 @@ public:
      */
     Q_INVOKABLE bool updateSplitRatio(const QString& containerId, double ratio);
     
+    /**
+     * 更新容器全部子节点的比例
+     * 参数：
+     *   containerId - 容器 ID
+     *   sizes - 各子节点的比例（长度必须等于子节点数，自动归一化）
+     * 返回：容器存在时返回 true
+     */
+    Q_INVOKABLE bool updateSizes(const QString& containerId, const QList<qreal>& sizes);
+    
+    // ========================================================================
+    // 实时拖动（分割条拖动期间只更新预览比例）
+    // ========================================================================
+    
+    /**
+     * 开始拖动容器的分割条
+     * 返回：容器存在时返回 true
+     */
+    Q_INVOKABLE bool beginLiveResize(const QString& containerId);
+    
+    /**
+     * 拖动中更新比例
+     * 作用：只记录最新值，每帧（LiveResizeFrameMs）最多写一次 previewSizes，
+     *       不修改 sizes，不发送 layoutChanged
+     * 未调用 beginLiveResize 时等同于 updateSizes
+     */
+    Q_INVOKABLE void updateLiveResize(const QString& containerId, const QList<qreal>& sizes);
+    
+    /**
+     * 结束拖动
+     * 参数：commit - true 提交为 sizes（比例变化时发送一次 layoutChanged），false 放弃
+     * 返回：sizes 是否发生变化
+     */
+    Q_INVOKABLE bool endLiveResize(const QString& containerId, bool commit = true);
+    
+    /**
+     * 预览比例的合并间隔（约一帧）
+     */
+    static constexpr int LiveResizeFrameMs = 16;
+    
+    // ========================================================================
+    // 布局几何（SplitLayoutSolver）
+    // ========================================================================
+    
+    /**
+     * 布局几何：
+     *   视图上报每棵树（主窗口、分离窗口）的视口尺寸，SplitLayoutSolver 一次遍历算出
+     *   每个节点的 layoutRect / layoutMinimumSize（满足整棵子树的 minSize），QML 只绑定结果
+     *   树修改后（根节点 treeRevisionChanged）合并到下一轮事件循环增量重算，只重算修改过的子树；
+     *   实时拖动时每帧只重新分配被拖动容器的子节点
+     * 
+     * setViewportSize：上报树的视口尺寸并立即求解（root 为 rootNode 或 windowRoots 中的根节点）
+     *   视口按窗口记录，根节点被替换后新根沿用同一视口
+     *   加载或分离时视口尚未上报的树，在第一次上报时补做最小尺寸检查（见 clampInfeasibleMinSizes）
+     */
+    Q_INVOKABLE void setViewportSize(SplitPanelNode* root, qreal width, qreal height);
+    
+    /**
+     * 立即重算所有已上报视口的树（没有修改的子树直接跳过）
+     */
+    void updateGeometry();
+    
     /**
      * 清空所有节点
      * 用途：重置布局时调用
@@ -242,6 +448,231 @@ public:
      */
     Q_INVOKABLE void clear();
     
+    // ========================================================================
+    // 面板休眠（内容卸载，内存和场景图开销只与屏幕上的面板有关）
+    // ========================================================================
+    
+    double hibernationSizeThreshold() const { return m_hibernationSizeThreshold; }
+    void setHibernationSizeThreshold(double threshold);
+    
+    int hibernationDelay() const { return m_hibernationDelay; }
+    void setHibernationDelay(int delayMs);
+    
+    /**
+     * 视图上报面板的可见性和尺寸（可见性/尺寸变化时调用）
+     * 休眠策略：
+     *   - 可见但宽或高小于 hibernationSizeThreshold：立即休眠
+     *   - 连续不可见超过 hibernationDelay：休眠
+     *   - 休眠中的面板重新可见且尺寸达到阈值的 WakeHysteresis 倍：唤醒
+     *     （留出余量，避免拖动分割条经过阈值附近时反复休眠/唤醒）
+     */
+    Q_INVOKABLE void reportPanelVisibility(const QString& panelId, bool visible, double width, double height);
+    
+    /**
+     * 手动休眠/唤醒面板
+     * 返回：面板存在且状态发生变化时返回 true
+     */
+    Q_INVOKABLE bool hibernatePanel(const QString& panelId);
+    Q_INVOKABLE bool wakePanel(const QString& panelId);
+    
+    /**
+     * 暂存/取回面板内容的状态（视图在卸载内容前保存、重新创建后恢复）
+     * 面板删除或布局清空时一并丢弃
+     */
+    Q_INVOKABLE void storePanelState(const QString& panelId, const QVariant& state);
+    Q_INVOKABLE QVariant takePanelState(const QString& panelId);
+    
+    /**
+     * 唤醒所需尺寸相对休眠阈值的倍数
+     */
+    static constexpr double WakeHysteresis = 1.25;
+    
+    // ========================================================================
+    // 批量修改（事务）
+    // ========================================================================
+    
+    /**
+     * 开始批量修改
+     * 作用：之后的所有节点信号和管理器信号都被延迟、去重，直到 commitBatch()
+     * 说明：
+     *   - 可嵌套调用，只有最外层的 commitBatch() 才会真正发送信号
+     *   - 批量修改期间 QML 看不到任何中间状态（绑定不会被触发）
+     * 
+     * QML 调用：
+     *   splitManager.beginBatch()
+     *   for (...) splitManager.addPanelAt(...)
+     *   splitManager.commitBatch()
+     */
+    Q_INVOKABLE void beginBatch();
+    
+    /**
+     * 提交批量修改
+     * 作用：每个被修改过的节点只补发一次对应信号，
+     *       再统一发送 rootNodeChanged / panelCountChanged / panelAdded / panelRemoved / layoutChanged
+     * 
+     * 分片补发：
+     *   panelAdded / panelRemoved 超过 SlicedNoticeThreshold 条时经 scheduler() 分片发送（顺序不变），
+     *   分片发送期间产生的新通知排在后面；其余信号和节点信号仍在提交时同步发送，
+     *   视图不会看到只更新了一半的树
+     *   需要立即收到全部通知时调用 scheduler()->flush()
+     */
+    Q_INVOKABLE void commitBatch();
+    
+    /**
+     * 同步发送的面板通知条数上限
+     */
+    static constexpr int SlicedNoticeThreshold = 32;
+    
+    /**
+     * 是否处于批量修改中
+     */
+    bool isBatching() const { return m_batchDepth > 0; }
+    
+    /**
+     * RAII 事务封装（C++ 使用）
+     * 构造时 beginBatch()，析构时 commitBatch()
+     * 
+     * 示例：
+     *   {
+     *       SplitManager::Transaction transaction(manager);
+     *       manager->addPanel(...);
+     *       manager->addPanelAt(...);
+     *   }  // 这里统一发送信号
+     */
+    class Transaction {
+    public:
+        explicit Transaction(SplitManager* manager) : m_manager(manager) {
+            if (m_manager) m_manager->beginBatch();
+        }
+        ~Transaction() {
+            if (m_manager) m_manager->commitBatch();
+        }
+        Transaction(const Transaction&) = delete;
+        Transaction& operator=(const Transaction&) = delete;
+    
+    private:
+        SplitManager* m_manager;
+    };
+    
+    // ========================================================================
+    // 撤销/重做（见 SplitHistory）
+    // ========================================================================
+    
+    bool canUndo() const { return m_history.canUndo(); }
+    bool canRedo() const { return m_history.canRedo(); }
+    
+    int historyLimit() const { return m_history.limit(); }
+    void setHistoryLimit(int limit);
+    
+    /**
+     * 撤销/重做一步
+     * 记录的操作：addPanel/addPanelAt、removePanel、updateSizes/updateSplitRatio、
+     *             实时拖动的提交、setContainerOrientation；批量修改期间的操作合并为一步
+     * 不记录：loadLayout/clear（清空历史）、QML 按界面尺寸回写的 sizes
+     * 每条记录只保存被修改的面板和容器，撤销/重做的开销与树的大小无关
+     * 返回：成功返回 true；记录与当前树对不上时清空历史并返回 false
+     */
+    Q_INVOKABLE bool undo();
+    Q_INVOKABLE bool redo();
+    
+    /**
+     * 清空撤销/重做历史
+     */
+    Q_INVOKABLE void clearHistory();
+    
+    /**
+     * 修改容器方向（记录到撤销历史）
+     * 参数：orientation - ContainerNode::Horizontal / Vertical
+     * 注意：不与相邻的同方向容器合并（撤销时才能原样恢复），加载布局时再规范化
+     * 返回：容器存在时返回 true
+     */
+    Q_INVOKABLE bool setContainerOrientation(const QString& containerId, int orientation);
+    
+    // ========================================================================
+    // 多窗口（分离的面板组）
+    // ========================================================================
+    
+    /**
+     * 多窗口：
+     *   主窗口的树是 rootNode，每个分离窗口各有一棵树（windowRoots[windowId]）
+     *   所有树共用节点索引、面板类型、对象池和管理器信号，findPanel/removePanel/addPanelAt 对任何窗口的节点都有效
+     *   节点在窗口间移动只是把子树从一棵树取下、挂到另一棵树上：节点对象和 ID 不变，
+     *   QML 各窗口共用一个 SplitPanelViewPool 时面板视图及其内容也原样保留
+     * 
+     * 注意：
+     *   - 分离窗口的最后一个面板被删除或移走时窗口自动关闭
+     *   - 窗口操作不进入撤销历史，并清空已有历史（与加载布局相同）
+     *   - 保存布局和自动保存只包含主窗口：退出前调用 closeAllWindows() 把面板停靠回主窗口
+     *   - applyLayout 先把分离窗口并回主窗口再对比；loadLayout/clear 直接关闭分离窗口
+     */
+    QStringList windowIds() const;
+    QVariantMap windowRoots() const;
+    
+    /**
+     * 节点所在的分离窗口 ID（节点在主窗口中或不存在时返回空字符串）
+     */
+    Q_INVOKABLE QString windowOf(const QString& nodeId) const;
+    
+    /**
+     * 把节点（面板或容器，连同子树）移到一个新的分离窗口
+     * 返回：新窗口 ID；节点已独占一个分离窗口时返回该窗口 ID；节点不存在时返回空字符串
+     */
+    Q_INVOKABLE QString detachNode(const QString& nodeId);
+    
+    /**
+     * 把节点（连同子树）移到 targetId 的 direction 一侧，两者可以在不同窗口中
+     * 返回：成功返回 true；目标在被移动的子树中或插入失败（如方向无效）时返回 false，
+     *       插入失败时子树放回原来的位置
+     */
+    Q_INVOKABLE bool moveNode(const QString& nodeId, const QString& targetId, int direction);
+    
+    /**
+     * 关闭分离窗口：它的树停靠到主窗口右侧（主窗口为空时直接成为主窗口的树）
+     * 停靠失败时窗口保留，返回 false
+     */
+    Q_INVOKABLE bool closeWindow(const QString& windowId);
+    
+    /**
+     * 关闭全部分离窗口（一次批量修改）
+     */
+    Q_INVOKABLE void closeAllWindows();
+    
+    // ========================================================================
+    // 面板类型（见 SplitPanelTypeRegistry）
+    // ========================================================================
+    
+    /**
+     * 注册面板类型
+     * 参数：
+     *   key - 类型键（如 "content"），addPanel 的 qmlSource 参数可直接传类型键
+     *   qmlSource - QML 内容文件路径
+     *   defaultTitle - 新建面板的默认标题
+     *   defaultMinSize - 新建面板的默认最小尺寸（0 = 使用 minPanelSize）
+     * 返回：成功返回 true
+     * 
+     * 注意：应在加载布局之前注册，已存在的面板不会切换到新注册的数据
+     * 
+     * QML 调用：splitManager.registerPanelType("content", "SplitPanelContent.qml", "新面板")
+     */
+    Q_INVOKABLE bool registerPanelType(const QString& key, const QString& qmlSource,
+                                       const QString& defaultTitle = QString(), double defaultMinSize = 0);
+    
+    /**
+     * 已注册的面板类型键（按注册顺序）
+     */
+    Q_INVOKABLE QStringList registeredPanelTypes() const;
+    
+    /**
+     * 面板类型信息：{ key, qmlSource, defaultTitle, defaultMinSize }，未注册时返回空 Map
+     */
+    Q_INVOKABLE QVariantMap panelTypeInfo(const QString& key) const;
+    
+    /**
+     * 面板类型注册表（C++ 访问）
+     */
+    SplitPanelTypeRegistry& panelTypeRegistry() { return m_panelTypes; }
+    const SplitPanelTypeRegistry& panelTypeRegistry() const { return m_panelTypes; }
+    
     // ========================================================================
     // 布局序列化（保存和加载）
     // ========================================================================
@@ -252,7 +683,7 @@ public:
      * 用途：内部使用，saveLayoutToFile() 会调用此方法
      * 
      * 格式：{
-     *   version: "2.0",
+     *   version: "2.1",
      *   minPanelSize: 150,
      *   root: { 递归的树结构 }
      * }
@@ -267,44 +698,181 @@ public:
      * 
      * 逻辑：
      *   1. 检查版本兼容性
-     *   2. 清空当前树
-     *   3. 递归重建树结构
-     *   4. 发送 rootNodeChanged 信号
+     *   2. 经 SplitLayoutSerializer::specFromVariant 读成扁平描述
+     *      （与文件加载共用校验：空 ID、重复 ID 使整个布局无效，当前树不变）
+     *   3. 清空当前树，按描述重建树结构
+     *   4. 压缩和校验（见 compactLoadedTree，改动见 lastLoadReport）
+     *   5. 发送 rootNodeChanged 信号
      */
     Q_INVOKABLE bool loadLayout(const QVariantMap& layout);
     
     /**
-     * 保存布局到文件（JSON 格式）
-     * 参数：filePath - 文件路径
+     * 把布局差量应用到当前树（切换工作区预设）
+     * 参数：layout - 布局数据（与 loadLayout 格式相同）
+     * 返回：成功返回 true；布局无效（版本不兼容、ID 重复、空容器）时不修改当前树
+     * 
+     * 与 loadLayout 的区别：
+     *   按节点 ID 对比新旧两棵树，ID 和类型都相同的节点原样复用
+     *   （面板视图和内容不重建），只有子节点列表变化的容器重新挂接子节点，
+     *   比例、方向、标题等属性原地更新；新树中没有的节点才被销毁
+     *   界面的更新量与差异的大小成正比，而不是整棵树
+     * 
+     * 注意：对比本身仍需遍历两棵树（只比较 ID），撤销历史被清空（与 loadLayout 一致）
+     */
+    Q_INVOKABLE bool applyLayout(const QVariantMap& layout);
+    
+    /**
+     * 把布局文件内容（JSON 或二进制，自动识别）差量应用到当前树
+     * 经 SplitLayoutSerializer::readSpec 流式读取，不生成中间 QVariantMap
+     * 用途：SplitLayoutStore::load 直接应用映射区中的预设主体
+     */
+    bool applyLayoutData(const QByteArray& data);
+    
+    /**
+     * 保存布局到文件
+     * 参数：
+     *   filePath - 文件路径
+     *   format - 文件格式（LayoutFormat，默认 JSON）
      * 返回：成功返回 true
      * 
      * 流程：
-     *   1. 调用 saveLayout() 获取 QVariantMap
-     *   2. 转换为 QJsonDocument
-     *   3. 写入文件（带缩进格式化）
+     *   1. SplitLayoutSerializer 直接遍历节点树，编码为 JSON（带缩进）或二进制
+     *   2. 写入文件
+     * 
+     * 说明：不经过 saveLayout() 的 QVariantMap 中间结构
      * 
      * QML 调用：dockingManager.saveLayoutToFile(path)
+     *          dockingManager.saveLayoutToFile(path, SplitManager.BinaryFormat)
      */
-    Q_INVOKABLE bool saveLayoutToFile(const QString& filePath) const;
+    Q_INVOKABLE bool saveLayoutToFile(const QString& filePath, int format = JsonFormat) const;
     
     /**
-     * 从文件加载布局（JSON 格式）
+     * 从文件加载布局（JSON / 二进制自动识别）
      * 参数：filePath - 文件路径
      * 返回：成功返回 true
      * 
      * 流程：
      *   1. 读取文件
-     *   2. 解析 JSON
-     *   3. 调用 loadLayout() 重建树
+     *   2. 根据文件头识别格式
+     *   3. SplitLayoutSerializer 从 QJsonObject / CBOR 流读成节点描述（ID 为空或重复时失败），再创建节点树
+     *   4. 替换当前树并压缩、校验（与 loadLayout() 行为一致）
      * 
      * 错误处理：
      *   - 文件不存在：返回 false（不影响程序）
-     *   - JSON 格式错误：返回 false，记录错误日志
+     *   - 文件内容损坏：返回 false，记录错误日志
      * 
      * QML 调用：dockingManager.loadLayoutFromFile(path)
      */
     Q_INVOKABLE bool loadLayoutFromFile(const QString& filePath);
     
+    /**
+     * 最近一次加载时压缩和校验修改了什么
+     * 返回：{
+     *   collapsedContainers: 只剩一个子节点、被子节点替换的容器数,
+     *   removedContainers: 没有子节点、被删除的容器数,
+     *   mergedContainers: 展开到同方向父容器中的容器数,
+     *   repairedSizes: 比例被重新规范化的容器数,
+     *   clampedMinSizes: minSize 被缩小的节点数,
+     *   minSizeScale: minSize 的缩放系数（1 表示未缩放）,
+     *   minSizeCheckDeferred: 加载时主窗口视口未知，最小尺寸检查推迟到第一次上报视口
+     *     （检查完成后改为 false 并更新 clampedMinSizes / minSizeScale）
+     * }
+     * 用途：提示用户旧布局文件已被修正，或在保存前确认布局没有问题
+     */
+    Q_INVOKABLE QVariantMap lastLoadReport() const { return m_lastLoadReport; }
+    
+    // ========================================================================
+    // 异步布局保存/加载（不阻塞 GUI 线程）
+    // ========================================================================
+    
+    /**
+     * 异步保存布局到文件（C++ 接口）
+     * 参数：
+     *   filePath - 文件路径
+     *   format - 文件格式（LayoutFormat，默认 JSON）
+     * 返回：QFuture<bool>，完成后同时发送 layoutSaved(filePath, success)
+     * 
+     * 流程：
+     *   1. 【GUI 线程】复制一份 flatTree()（值数据，隐式共享）
+     *   2. 【工作线程】编码为 JSON 文本 / CBOR + 通过 QSaveFile 原子写入
+     *   3. 【GUI 线程】记录日志，发送 layoutSaved
+     * 
+     * 说明：多次保存按提交顺序依次写入，后一次不会被前一次覆盖
+     */
+    QFuture<bool> saveLayoutAsync(const QString& filePath, int format = JsonFormat);
+    
+    /**
+     * 异步从文件加载布局（C++ 接口）
+     * 参数：filePath - 文件路径
+     * 返回：QFuture<bool>，完成后同时发送 layoutLoaded(filePath, success)
+     * 
+     * 流程：
+     *   1. 【工作线程】读取文件，SplitLayoutSerializer::readSpec 流式读成先序的节点描述（不创建 QObject，
+     *      不经过 QVariantMap；读取和校验与 loadLayoutFromFile 相同）
+     *   2. 【GUI 线程】经 scheduler() 分片创建节点（子节点先于父容器，每步一个节点），
+     *      新树创建期间当前树保持不变，期间 loading 为 true、loadProgress 逐步增加
+     *   3. 【GUI 线程】最后一步一次替换当前树（与 loadLayoutFromFile 相同）
+     * 
+     * 说明：
+     *   - 再次调用、同步加载（loadLayout / loadLayoutFromFile / applyLayout）和 clear 会取消尚未完成的加载
+     *     （包括仍在工作线程读取的），最后发起的加载生效；
+     *     被取消的加载以 false 完成并发送 layoutLoaded(filePath, false)
+     *   - 加载期间对当前树的修改在替换时被丢弃
+     *   - 节点描述无效（ID 重复等）时整个布局加载失败；空容器与同步加载一样在压缩时删除
+     */
+    QFuture<bool> loadLayoutAsync(const QString& filePath);
+    
+    /**
+     * 异步保存布局（QML 接口，结果通过 layoutSaved 信号返回）
+     * QML 调用：dockingManager.saveLayoutToFileAsync(path)
+     */
+    Q_INVOKABLE void saveLayoutToFileAsync(const QString& filePath, int format = JsonFormat) { saveLayoutAsync(filePath, format); }
+    
+    /**
+     * 异步加载布局（QML 接口，结果通过 layoutLoaded 信号返回）
+     * QML 调用：dockingManager.loadLayoutFromFileAsync(path)
+     */
+    Q_INVOKABLE void loadLayoutFromFileAsync(const QString& filePath) { loadLayoutAsync(filePath); }
+    
+    SplitFrameScheduler* scheduler() const { return SplitFrameScheduler::instance(); }
+    
+    bool isLoading() const { return m_slicedLoad != nullptr; }
+    double loadProgress() const;
+    
+    // ========================================================================
+    // 自动保存
+    // ========================================================================
+    
+    /**
+     * 自动保存
+     * 
+     * 脏标记：节点的可序列化状态变化时更新子树版本号（treeRevision），
+     *   根节点发送 treeRevisionChanged；另外监听根节点替换和 minPanelSize
+     *   根节点和版本号与上次自动保存相同时不写入（拖动后原样拖回仍会生成快照，见下）
+     * 防抖：停止修改 autosaveDelay 毫秒后写入；持续修改时，第一次修改后最迟 autosaveMaxLatency 毫秒写入
+     * 写入：经过 saveLayoutAsync 的同一条串行队列，编码和写文件都在工作线程；
+     *   编码结果的哈希与该路径上次写入的内容相同时跳过写文件
+     * 
+     * 开启时当前树视为已保存（应在启动加载完成后开启，避免用空布局覆盖文件）
+     */
+    bool autosaveEnabled() const { return m_autosaveEnabled; }
+    void setAutosaveEnabled(bool enabled);
+    
+    QString autosavePath() const;
+    void setAutosavePath(const QString& filePath);
+    
+    int autosaveDelay() const { return m_autosaveDelay; }
+    void setAutosaveDelay(int delayMs);
+    
+    int autosaveMaxLatency() const { return m_autosaveMaxLatency; }
+    void setAutosaveMaxLatency(int latencyMs);
+    
+    /**
+     * 有未保存的修改时立即提交一次自动保存（不等防抖，如窗口关闭时）
+     * 返回：提交了写入返回 true
+     */
+    Q_INVOKABLE bool flushAutosave();
+    
     
     /**
      * 获取默认布局文件路径
@@ -343,6 +911,45 @@ public:
      */
     Q_INVOKABLE QVariantList getFlatPanelList() const;
     
+    // ========================================================================
+    // 性能统计
+    // ========================================================================
+    
+    /**
+     * 开启/关闭热路径统计（区段耗时、每个容器的信号数、QML 委托创建/销毁数）
+     * 关闭时每个统计点只有一次原子读取；统计为进程级，所有 SplitManager 共用
+     */
+    bool profilingEnabled() const { return SplitProfiler::isEnabled(); }
+    void setProfilingEnabled(bool enabled);
+    
+    /**
+     * 开启/关闭 Chrome trace 事件记录（开启时同时开启统计）
+     */
+    bool traceEnabled() const { return SplitProfiler::isTraceEnabled(); }
+    void setTraceEnabled(bool enabled);
+    
+    /**
+     * 获取统计汇总（格式见 SplitProfiler::stats()）
+     * 额外包含当前树的 panelCount / nodeCount
+     */
+    Q_INVOKABLE QVariantMap stats() const;
+    
+    /**
+     * 清空统计和已记录的 trace 事件
+     */
+    Q_INVOKABLE void resetStats();
+    
+    /**
+     * 把已记录的 trace 事件写成 Chrome trace JSON（chrome://tracing 或 Perfetto 打开）
+     * 返回：是否写入成功
+     */
+    Q_INVOKABLE bool saveTrace(const QString& filePath) const;
+    
+    /**
+     * 记录 QML 委托事件（由 SplitNodeRenderer / SplitContainerView 在统计开启时调用）
+     */
+    Q_INVOKABLE void recordDelegateEvent(DelegateEvent event);
+
 signals:
     /**
      * 根节点改变信号
@@ -369,6 +976,37 @@ signals:
      */
     void devModeChanged();
     
+    /**
+     * 放置策略改变信号
+     */
+    void placementStrategyChanged();
+    
+    /**
+     * 休眠策略（尺寸阈值/不可见延迟）改变信号
+     */
+    void hibernationPolicyChanged();
+    
+    /**
+     * 撤销/重做状态（canUndo/canRedo/historyLimit）改变信号
+     */
+    void historyChanged();
+    
+    /**
+     * 统计开关（profilingEnabled/traceEnabled）改变信号
+     */
+    void profilingChanged();
+    
+    /**
+     * 自动保存设置改变信号
+     */
+    void autosaveChanged();
+    
+    /**
+     * 自动保存完成信号（内容未变而跳过写文件时 success 也为 true）
+     * 注意：自动保存不发送 layoutSaved
+     */
+    void autosaved(const QString& filePath, bool success);
+    
     /**
      * 面板添加信号
      * 参数：panelId - 新添加的面板 ID
@@ -390,24 +1028,46 @@ signals:
      */
     void layoutChanged();
     
-private:
-    // ========================================================================
-    // 内部辅助方法（不暴露给 QML）
-    // ========================================================================
+    /**
+     * 异步保存完成信号
+     * 参数：
+     *   filePath - 文件路径
+     *   success - 是否写入成功
+     */
+    void layoutSaved(const QString& filePath, bool success);
     
     /**
-     * 递归查找节点
+     * 异步加载完成信号
      * 参数：
-     *   node - 起始节点
-     *   id - 要查找的节点 ID
-     * 返回：找到返回指针，否则返回 nullptr
-     * 
-     * 算法：深度优先搜索（DFS）
-     *   1. 如果当前节点 ID 匹配，返回
-     *   2. 如果是容器，递归查找 firstChild
-     *   3. 递归查找 secondChild
+     *   filePath - 文件路径
+     *   success - 是否加载成功（文件不存在也视为失败）
+     */
+    void layoutLoaded(const QString& filePath, bool success);
+    
+    /**
+     * 异步加载读完文件、开始创建节点之前发出
+     * 参数：
+     *   filePath - 文件路径
+     *   qmlSources - 布局中面板用到的内容组件路径（去重，经面板类型注册表解析）
+     * 用途：视图在节点分片创建期间预编译这些组件（PanelContentCache.preload）
      */
-    SplitPanelNode* findNode(SplitPanelNode* node, const QString& id);
+    void layoutContentSourcesRead(const QString& filePath, const QStringList& qmlSources);
+    
+    /**
+     * 异步加载开始/结束，节点创建进度变化
+     */
+    void loadingChanged();
+    void loadProgressChanged();
+    
+    /**
+     * 分离窗口增减或某个分离窗口的根节点改变
+     */
+    void windowsChanged();
+
+private:
+    // ========================================================================
+    // 内部辅助方法（不暴露给 QML）
+    // ========================================================================
     
     /**
      * 查找最右侧的面板
@@ -417,77 +1077,147 @@ private:
      * 
      * 算法：
      *   1. 如果是 Panel，返回自己
-     *   2. 如果是 Container，优先查找 secondChild
-     *   3. 如果 secondChild 不存在，查找 firstChild
+     *   2. 如果是 Container，查找最后一个子节点
      */
     SplitPanelNode* findRightmostPanel(SplitPanelNode* node);
     
+    /**
+     * 查找面积最大的面板（Balanced 放置策略）
+     * 参数：dir - 输出插入方向（面板较宽时 Right，较高时 Bottom）
+     * 返回：最大的面板，树为空时返回 nullptr
+     * 
+     * 算法：
+     *   以根节点为单位正方形，按 sizes 逐层计算每个面板的相对宽高，
+     *   取面积最大者（面积相同取深度最浅、再取先遍历到的）
+     *   用显式栈遍历，不递归；每次添加遍历整棵树 O(n)，换来之后所有按深度的操作 O(log n)
+     */
+    SplitPanelNode* findLargestPanel(Direction* dir) const;
+    
     /**
      * 在目标节点旁插入面板（核心算法）
      * 参数：
-     *   panel - 要插入的面板（智能指针，所有权转移）
+     *   panel - 要插入的面板（成功时取走所有权；失败时不取走，调用方可以把它放回原处）
      *   target - 目标节点
      *   dir - 插入方向
      * 返回：成功返回 true
      * 
      * 算法步骤：
      *   1. 确定分割方向（Left/Right→Vertical, Top/Bottom→Horizontal）
-     *   2. 创建新 ContainerNode
-     *   3. 从父容器取出 target
-     *   4. 设置新容器的子节点（根据方向确定顺序）
-     *   5. 将新容器放回父容器
+     *   2. 父容器方向与分割方向相同：插在 target 旁边，分走 target 一半的空间
+     *   3. target 本身是同方向容器：插在它的一侧，新面板占一半
+     *   4. 否则创建新 ContainerNode，在父容器中替换 target（沿用 target 的比例）
+     *   5. 设置新容器的子节点（根据方向确定顺序）
      * 
      * 特殊情况：
-     *   - 如果 target 是 root，直接替换 root
+     *   - 如果 target 是 root，新容器成为 root
+     * 
+     * 撤销记录：record 非空时填入接收面板的容器及其插入前的 sizes，或新容器的 ID；
+     *   record->createdContainerId 已有值时新容器使用该 ID（重做时保持 ID 不变）
      */
-    bool insertPanelAt(std::unique_ptr<SplitPanelNode> panel, SplitPanelNode* target, Direction dir);
+    bool insertPanelAt(std::unique_ptr<SplitPanelNode>&& panel, SplitPanelNode* target, Direction dir,
+                       SplitHistoryCommand* record = nullptr);
     
     /**
-     * 从 QVariantMap 加载节点（递归）
-     * 参数：data - 节点数据
-     * 返回：创建的节点（智能指针）
-     * 
-     * 递归逻辑：
-     *   1. 读取 type 字段
-     *   2. 如果是 "panel"：创建 PanelNode，设置属性
-     *   3. 如果是 "container"：
-     *      - 创建 ContainerNode
-     *      - 递归加载 first 和 second 子节点
-     *   4. 返回创建的节点
+     * 删除面板（removePanel 的实现，不含重入保护）
+     * 参数：
+     *   normalize - 提升的兄弟节点与祖父容器同方向时是否合并（撤销插入时为 false，原样恢复）
+     *   record - 非空时填入恢复面板所需的记录
+     */
+    bool removePanelNode(const QString& panelId, bool normalize, SplitHistoryCommand* record);
+    
+    /**
+     * 差量应用已读好的布局描述（applyLayout / applyLayoutData 的共同实现）
+     */
+    bool applyLayoutSpec(SplitLayoutSerializer::LayoutSpec spec);
+    
+    /**
+     * 用读取结果替换当前树（文件加载路径的 loadLayout）
+     * 参数：
+     *   spec - 布局描述（版本、minPanelSize）
+     *   root - 按 spec 创建的尚未注册的节点树（SplitLayoutSerializer::buildTree 或分片创建）
+     * 逻辑：检查版本 → 清空 → 设置 minPanelSize → 挂上新树并注册所有节点
+     * 返回：成功返回 true
      */
-    std::unique_ptr<SplitPanelNode> loadNodeFromVariant(const QVariantMap& data);
+    bool applyLoadedLayout(const SplitLayoutSerializer::LayoutSpec& spec, std::unique_ptr<SplitPanelNode> root);
+    
+    /**
+     * 递归注册子树中的所有节点（直接构建的节点树在挂上后统一注册）
+     */
+    void registerSubtree(SplitPanelNode* node);
+    
+    /**
+     * applyLayout 的中间状态（新树的节点描述、取下的节点、统计），定义见 SplitManager.cpp
+     */
+    struct LayoutPatch;
+    
+    /**
+     * 按新树的一个节点描述复用或创建节点（递归处理子节点）
+     * 返回：需要由父容器挂接的节点（新建的或被取下的）；仍挂在原位置的节点返回 nullptr
+     */
+    std::unique_ptr<SplitPanelNode> patchNode(LayoutPatch& patch, int specIndex);
+    
+    /**
+     * 分片进行中的异步加载（节点描述、已创建的节点），定义见 SplitManager.cpp
+     */
+    struct SlicedLoad;
+    
+    /**
+     * 异步加载的一步：创建一个节点；全部创建后替换当前树
+     * 返回：true 表示加载已结束
+     */
+    bool stepSlicedLoad();
+    
+    /**
+     * 结束异步加载（记录日志、完成 future、发送 layoutLoaded 和 loadingChanged）
+     * load 已由 stepSlicedLoad 从 m_slicedLoad 中取出
+     */
+    void finishSlicedLoad(std::unique_ptr<SlicedLoad> load, bool success);
+    
+    /**
+     * 取消尚未完成的异步加载（已创建的节点直接释放）
+     * 同时递增 m_loadGeneration：仍在工作线程读取的加载返回时发现序号已变，结果直接丢弃
+     * 调用时机：所有同步加载、applyLayout、clear 和新的异步加载开始时
+     */
+    void cancelSlicedLoad();
+    
+    /**
+     * 发送面板通知（分片发送期间排队，保持顺序）
+     */
+    void emitPanelNotices(const QStringList& removedPanels, const QStringList& addedPanels);
+    
+    /**
+     * 分片发送的一步：发送一条排队的面板通知
+     * 返回：true 表示队列已发送完
+     */
+    bool stepPanelNotices();
+    
+    /**
+     * 编码当前布局为文件内容（直接遍历节点树）
+     */
+    QByteArray serializeLayout(int format) const;
     
     /**
      * 生成唯一节点 ID
-     * 返回：如 "node_1", "node_2", ...
+     * 返回：如 "node_1", "node_2", ...（规则同 generatePanelId）
      * 用途：创建容器时自动生成 ID
      */
     QString generateNodeId();
     
     /**
-     * 递归统计面板数量
-     * 参数：node - 起始节点
-     * 返回：以该节点为根的子树中的面板数量
+     * 前缀 + 递增序号，跳过已登记的 ID（计数器已越过登记过的序号，通常一次命中）
      */
-    int countPanels(SplitPanelNode* node) const;
+    QString nextFreeId(const QString& prefix, quint64& counter) const;
     
     /**
-     * 递归生成树的文本表示（用于调试）
-     * 参数：
-     *   node - 当前节点
-     *   indent - 缩进层级
-     * 返回：带缩进的树结构字符串
+     * 新面板的 ID 可用（非空且没有被任何节点占用）；不可用时记录错误
      */
-    QString dumpNode(SplitPanelNode* node, int indent = 0) const;
+    bool isFreeNodeId(const QString& nodeId) const;
     
     /**
-     * 递归收集所有面板（扁平化）
-     * 参数：
-     *   node - 起始节点
-     *   panels - 输出列表（引用传递）
-     * 用途：getFlatPanelList() 调用
+     * 登记节点时调用：ID 形如 "node_N" / "panel_N" 时把对应计数器推进到 N
+     * 加载布局后新建的节点因此不会与已加载的 ID 冲突
      */
-    void collectPanels(SplitPanelNode* node, QVariantList& panels) const;
+    void noteNodeId(const QString& nodeId);
     
     // ========================================================================
     // 通用辅助函数（代码复用）
@@ -499,7 +1229,7 @@ private:
      * 参数：
      *   id - 面板ID
      *   title - 标题
-     *   qmlSource - QML文件路径
+     *   qmlSource - 面板类型键或 QML 文件路径（经注册表解析）
      * 返回：面板节点智能指针
      */
     std::unique_ptr<PanelNode> createPanelNode(
@@ -507,6 +1237,16 @@ private:
         const QString& title,
         const QString& qmlSource);
     
+    /**
+     * 新建面板的标题：为空或等于类型默认标题时使用类型中的字符串（共享存储）
+     */
+    QString panelTitleFor(const SplitPanelType& type, const QString& title) const;
+    
+    /**
+     * 新建面板的最小尺寸：类型有默认值时使用类型的，否则使用 minPanelSize
+     */
+    double panelMinSizeFor(const SplitPanelType& type) const;
+    
     /**
      * 注册面板到映射表（原子操作）
      * 作用：将面板指针添加到 m_panels 哈希表
@@ -523,6 +1263,21 @@ private:
      */
     void unregisterPanel(const QString& panelId);
     
+    /**
+     * 注册节点到统一索引（原子操作）
+     * 作用：将节点（面板或容器）添加到 m_nodes 哈希表
+     * 参数：node - 节点指针
+     * 说明：面板通过 registerPanel 注册时会自动调用此方法
+     */
+    void registerNode(SplitPanelNode* node);
+    
+    /**
+     * 从统一索引注销节点（原子操作）
+     * 作用：从 m_nodes 哈希表移除节点
+     * 参数：nodeId - 节点ID
+     */
+    void unregisterNode(const QString& nodeId);
+    
     /**
      * 设置节点为根节点（原子操作）
      * 作用：将节点设为树的根节点
@@ -546,9 +1301,70 @@ private:
      */
     void emitPanelRemovedSignals(const QString& panelId);
     
+    /**
+     * 合并同方向的子容器（规范化）
+     * 作用：把 container 中与它方向相同的子容器展开，子节点直接归 container 所有
+     *       被展开的容器从索引中注销并释放
+     * 调用时机：normalizeSubtree（插入时直接插入同方向容器，删除时只合并提升的那个位置，见 promoteSiblingNode）
+     */
+    void normalizeContainer(ContainerNode* container);
+    
+    /**
+     * 规范化整棵子树（自底向上调用 normalizeContainer）
+     * 调用时机：加载布局后（旧布局中的二分长链被展平为 N 叉容器）
+     */
+    void normalizeSubtree(SplitPanelNode* node);
+    
+    /**
+     * 加载时的压缩和校验统计（见 lastLoadReport）
+     */
+    struct LoadRepair {
+        int collapsedContainers = 0;
+        int removedContainers = 0;
+        int mergedContainers = 0;
+        int repairedSizes = 0;
+        int clampedMinSizes = 0;
+        double minSizeScale = 1.0;
+        bool minSizeCheckDeferred = false;  // 主窗口视口未知，最小尺寸检查推迟到第一次 setViewportSize
+        
+        bool isEmpty() const {
+            return !collapsedContainers && !removedContainers && !mergedContainers
+                && !repairedSizes && !clampedMinSizes;
+        }
+        QVariantMap toVariant() const;
+    };
+    
+    /**
+     * 压缩和校验刚加载的主窗口树（替代 normalizeSubtree，一次自底向上遍历）
+     * 作用：
+     *   - 删除没有子节点的容器，只剩一个子节点的容器由该子节点替换
+     *     （根容器同样处理：为空时删除，rootNode 为空，与空布局一致）
+     *   - 同方向的子容器展开到父容器中（二分长链展平为 N 叉容器）
+     *   - 展开后比例重新规范化（深层长链相乘后的比例可能低于 MinChildShare）
+     *   - 整棵树的最小尺寸超出主窗口视口则按比例缩小所有 minSize（见 clampInfeasibleMinSizes）；
+     *     视口未知时推迟到第一次 setViewportSize，lastLoadReport 中 minSizeCheckDeferred 为 true
+     * 改动写入 m_lastLoadReport 并记录日志
+     * 调用时机：loadLayout、applyLoadedLayout（文件加载和分片加载）
+     */
+    void compactLoadedTree();
+    
+    /**
+     * 压缩一个容器的子树（compactLoadedTree 的递归部分）
+     * 每个子节点只递归一次：替换上来的孙节点和展开进来的子节点都已经压缩过
+     */
+    void compactContainer(ContainerNode* container, LoadRepair& repair);
+    
+    /**
+     * 最小尺寸不可满足时按比例缩小所有 minSize（下限见 validateMinSize）
+     * 参数：root - 窗口的树；viewport - 该窗口的视口尺寸（非空）
+     * 只在整棵树的最小尺寸超出视口时修改
+     * 调用时机：compactLoadedTree（主窗口视口已知），或 m_pendingMinSizeChecks 中的窗口第一次 setViewportSize
+     */
+    void clampInfeasibleMinSizes(SplitPanelNode* root, const QSizeF& viewport, LoadRepair& repair);
+    
     /**
      * 获取兄弟节点
-     * 作用：删除面板时取出兄弟节点用于提升
+     * 作用：删除面板时取出兄弟节点用于提升（仅用于只有两个子节点的父容器）
      * 参数：
      *   parent - 父容器
      *   targetChild - 目标子节点
@@ -586,14 +1402,16 @@ private:
      * 参数：
      *   parentContainer - 父容器（将被替换）
      *   sibling - 兄弟节点（提升到父容器位置）
+     *   normalize - 兄弟节点是与祖父容器同方向的容器时是否展开合并
      * 返回：是否成功
      * 说明：
      *   - 如果父容器是根节点，直接替换 m_root
-     *   - 否则在祖父容器中替换父容器为兄弟节点
+     *   - 否则在祖父容器中替换父容器为兄弟节点（合并只检查这一个位置）
      */
     bool promoteSiblingNode(
         ContainerNode* parentContainer,
-        std::unique_ptr<SplitPanelNode> sibling);
+        std::unique_ptr<SplitPanelNode> sibling,
+        bool normalize = true);
     
     /**
      * 完成面板删除后的清理工作（原子操作）
@@ -602,15 +1420,168 @@ private:
      */
     void finalizePanelRemoval(const QString& panelId);
     
+    // ========================================================================
+    // 信号发送（批量修改期间延迟）
+    // ========================================================================
+    
+    /**
+     * 发送管理器信号（原子操作）
+     * 作用：非批量状态下立即 emit；批量状态下只记录到 m_pendingSignals
+     */
+    void notifyRootNodeChanged();
+    void notifyPanelCountChanged();
+    void notifyLayoutChanged();
+    void notifyPanelAdded(const QString& panelId);
+    void notifyPanelRemoved(const QString& panelId);
+    
+    // ========================================================================
+    // 保存队列与自动保存（内部）
+    // ========================================================================
+    
+    /**
+     * 把当前树的快照排进保存队列（工作线程编码并写文件）
+     * 参数：skipUnchanged - 编码结果与该路径上次写入的内容相同时不写文件
+     * 返回：写入（或跳过）成功为 true，在工作线程中完成
+     */
+    QFuture<bool> enqueueLayoutWrite(const QString& filePath, int format, bool skipUnchanged);
+    
+    /**
+     * 记录一次修改，启动防抖定时器（未开启自动保存时忽略）
+     */
+    void markAutosaveDirty();
+    
+    /**
+     * 重新连接当前根节点的 treeRevisionChanged（根节点替换后调用）
+     */
+    void watchAutosaveRoot();
+    
+    /**
+     * 树或 minPanelSize 与上次自动保存时不同
+     */
+    bool isAutosaveDirty() const;
+    
+    /**
+     * 重新连接各棵树根节点的 treeRevisionChanged（根节点替换、窗口增减后调用），并安排一次几何求解
+     */
+    void watchGeometryRoots();
+    
+    /**
+     * 把当前状态记为已自动保存（不写文件）
+     */
+    void markAutosaveClean();
+    
+    // ========================================================================
+    // 多窗口（内部）
+    // ========================================================================
+    
+    /**
+     * 持有顶层节点 root 的槽位（主窗口为 m_root），root 不是任何树的根时返回 nullptr
+     * 参数：windowId - 可选，输出所在的分离窗口 ID（主窗口为空字符串）
+     * 注意：m_windows 增删后槽位失效，不能跨越窗口的增删保存
+     */
+    std::unique_ptr<SplitPanelNode>* rootSlotOf(const SplitPanelNode* root, QString* windowId = nullptr);
+    
+    /**
+     * 节点所在树的根节点
+     */
+    SplitPanelNode* treeRootOf(SplitPanelNode* node) const;
+    
+    /**
+     * 把节点连同子树从所在的树上取下（节点仍在索引中，所有权交给调用者）
+     * 父容器只剩一个子节点时用兄弟节点替换（不合并同方向容器，调用者最后调用 normalizeAllTrees）
+     * 分离窗口的树被取空时窗口随之关闭
+     */
+    std::unique_ptr<SplitPanelNode> takeSubtree(SplitPanelNode* node);
+    
+    /**
+     * 节点在树中的位置（takeSubtree 之前用 originOf 记录，之后插入失败时 restoreSubtree 放回）
+     */
+    struct SubtreeOrigin {
+        QString windowId;                   // 所在窗口（主窗口为空字符串）
+        int windowIndex = -1;               // 节点是分离窗口的根时，窗口在 m_windows 中的位置
+        QString parentId;                   // 父容器 ID（为空表示节点是树根）
+        ContainerNode::Orientation orientation = ContainerNode::Vertical;
+        int index = -1;                     // 在父容器中的位置
+        QList<qreal> sizes;                 // 父容器取下前的比例
+        int currentIndex = 0;               // 父容器取下前的当前标签
+        bool parentCollapsed = false;       // 父容器只有两个子节点，取下后被兄弟节点替换
+        QString siblingId;                  // parentCollapsed 时替换父容器的兄弟节点
+    };
+    SubtreeOrigin originOf(SplitPanelNode* node);
+    
+    /**
+     * 把 takeSubtree 取下的子树放回 origin 记录的位置（父容器已被替换时按原 ID 重建，比例复原）
+     * 返回：放回成功返回 true；失败时不取走 subtree
+     */
+    bool restoreSubtree(std::unique_ptr<SplitPanelNode>&& subtree, const SubtreeOrigin& origin);
+    
     /**
-     * 写入JSON到文件（静态辅助方法）
+     * 规范化主窗口和所有分离窗口的树
      */
-    static bool writeJsonToFile(const QString& filePath, const QJsonDocument& jsonDoc);
+    void normalizeAllTrees();
     
     /**
-     * 从文件读取JSON（静态辅助方法）
+     * 删除树已为空的分离窗口
      */
-    static bool readJsonFromFile(const QString& filePath, QJsonDocument& outDoc, QString* errorMsg = nullptr);
+    void removeEmptyWindows();
+    
+    /**
+     * 某棵树的根节点改变（主窗口发送 rootNodeChanged，分离窗口发送 windowsChanged）
+     */
+    void notifyTreeRootChanged(const QString& windowId);
+    void notifyWindowsChanged();
+    
+    // ========================================================================
+    // 撤销/重做（内部）
+    // ========================================================================
+    
+    /**
+     * 添加撤销记录（执行撤销/重做期间忽略）
+     * 参数：coalesce - 允许与同一容器上一条比例调整合并
+     */
+    void recordHistory(SplitHistoryCommand command, bool coalesce = false);
+    
+    /**
+     * 撤销（undo = true）或重做一条记录
+     * 返回：记录引用的节点都存在且操作成功时返回 true
+     */
+    bool applyHistoryCommand(const SplitHistoryCommand& command, bool undo);
+    
+    /**
+     * 按删除记录把面板放回原处（需要时重建被销毁的父容器和被合并的兄弟容器）
+     */
+    bool restoreRemovedPanel(const SplitHistoryCommand& command);
+    
+    /**
+     * 按插入记录重新插入面板（ID 与第一次插入时相同）
+     */
+    bool reinsertPanel(const SplitHistoryCommand& command);
+    
+    /**
+     * 按记录重建面板节点（未注册）
+     */
+    std::unique_ptr<PanelNode> restorePanelNode(const SplitHistoryCommand& command);
+    
+    /**
+     * 按 ID 查找容器（不是容器时返回 nullptr）
+     */
+    ContainerNode* findContainer(const QString& id) const;
+    
+    /**
+     * canUndo/canRedo 与之前不同时发送 historyChanged
+     */
+    void notifyHistoryChanged(bool couldUndo, bool couldRedo);
+    
+    /**
+     * 写入文件内容（静态辅助方法，线程安全）
+     * 通过 QSaveFile 先写临时文件再原子替换，写入中途崩溃不会损坏原文件
+     */
+    static bool writeBytesToFile(const QString& filePath, const QByteArray& data);
+    
+    /**
+     * 读取文件内容（静态辅助方法，线程安全）
+     */
+    static bool readBytesFromFile(const QString& filePath, QByteArray& outData, QString* errorMsg = nullptr);
     
     /**
      * 确保目录存在（静态辅助方法）
@@ -626,13 +1597,118 @@ private:
     // 成员变量
     // ========================================================================
     
+    SplitNodePool* m_nodePool;            // 节点对象池（本管理器创建的所有节点都从这里分配）
     std::unique_ptr<SplitPanelNode> m_root;  // 树的根节点（所有权）
+    
+    /**
+     * 分离窗口（主窗口的树是 m_root）
+     */
+    struct SplitWindow {
+        QString id;
+        std::unique_ptr<SplitPanelNode> root;  // 窗口的树（所有权，不为空）
+    };
+    std::vector<SplitWindow> m_windows;   // 按创建顺序
+    int m_windowIdCounter = 0;            // 窗口 ID 计数器
+    
     QHash<QString, PanelNode*> m_panels;  // 面板快速查找表（ID → 指针）
+    QHash<QString, SplitPanelNode*> m_nodes;  // 统一节点索引（ID → 指针，含面板和容器）
+    SplitPanelTypeRegistry m_panelTypes;  // 面板类型注册表
     double m_minPanelSize = 150.0;        // 全局最小面板尺寸
-    int m_nodeIdCounter = 0;              // 节点 ID 计数器（用于生成唯一 ID）
+    quint64 m_nodeIdCounter = 0;          // 容器 ID 计数器（"node_N"，只增不减）
+    quint64 m_panelIdCounter = 0;         // 面板 ID 计数器（"panel_N"，只增不减）
     bool m_devMode = false;               // 【开发模式开关】false=生产模式（默认），true=开发模式
+    PlacementStrategy m_placementStrategy = AppendRight;  // addPanel 放置策略
+    
+    /**
+     * 批量修改期间积压的管理器信号
+     */
+    struct PendingSignals {
+        bool rootNodeChanged = false;
+        bool panelCountChanged = false;
+        bool layoutChanged = false;
+        bool windowsChanged = false;
+        QStringList removedPanels;   // 按发生顺序记录
+        QStringList addedPanels;
+    };
+    int m_batchDepth = 0;                 // 批量修改嵌套深度（0 = 未在批量中）
+    PendingSignals m_pendingSignals;      // 积压的管理器信号
+    
+    /**
+     * 分片发送中的面板通知
+     */
+    struct PanelNotice {
+        QString panelId;
+        bool added = false;
+    };
+    QVector<PanelNotice> m_panelNotices;  // 按发生顺序排队（为空 = 没有分片发送）
+    int m_panelNoticeCursor = 0;          // 下一条要发送的通知
     
+    std::unique_ptr<SlicedLoad> m_slicedLoad;  // 进行中的异步加载（为空 = 没有）
+    quint64 m_loadGeneration = 0;         // 加载序号（每次加载或取消时递增，过期的异步读取据此作废）
+    
+    mutable SplitFlatTree m_flatTree;     // flatTree() 缓存
+    mutable SplitPanelNode* m_flatRoot = nullptr;   // 缓存对应的根节点
+    mutable quint64 m_flatRevision = 0;   // 缓存对应的根节点 treeRevision
+    QFuture<bool> m_lastSave;             // 最近一次异步保存（用于串行化写入和退出时等待）
+    
+    /**
+     * 视图上报的面板可见性（休眠策略的输入）
+     */
+    struct PanelVisibility {
+        bool visible = true;
+        double width = 0.0;
+        double height = 0.0;
+        qint64 hiddenSince = -1;          // 开始不可见的时间（m_clock，毫秒），可见时为 -1
+    };
+    QHash<QString, PanelVisibility> m_panelVisibility;  // 面板ID → 可见性
+    QHash<QString, QVariant> m_panelStates;             // 面板ID → 休眠时暂存的内容状态
+    double m_hibernationSizeThreshold = 24.0;
+    int m_hibernationDelay = 30000;
+    QTimer* m_hibernationTimer = nullptr; // 不可见面板检查定时器（有待休眠面板时才运行）
+    QElapsedTimer m_clock;                // 不可见时长计时基准
+    
+    QHash<QString, QList<qreal>> m_liveResizePending; // 容器ID → 尚未写入的预览比例
+    QTimer* m_liveResizeTimer = nullptr;        // 预览比例合并定时器（单次）
+    
+    QHash<QString, QSizeF> m_viewports;   // 窗口ID（主窗口为空字符串）→ 视口尺寸
+    QVariantMap m_lastLoadReport;         // 最近一次加载的压缩和校验结果（见 lastLoadReport）
+    QSet<QString> m_pendingMinSizeChecks; // 视口未知、等待第一次 setViewportSize 做最小尺寸检查的窗口 ID
+    QTimer* m_geometryTimer = nullptr;    // 几何求解合并定时器（单次，0 毫秒）
+    QList<QMetaObject::Connection> m_geometryConnections;  // 各根节点 treeRevisionChanged 的连接
+    
+    bool m_autosaveEnabled = false;
+    QString m_autosavePath;               // 为空时使用 getDefaultLayoutPath()
+    int m_autosaveDelay = 2000;
+    int m_autosaveMaxLatency = 10000;
+    QTimer* m_autosaveTimer = nullptr;    // 防抖定时器（单次，有未保存修改时才运行）
+    qint64 m_autosaveFirstChange = -1;    // 未保存修改中第一次修改的时间（m_clock），-1 = 没有
+    qint64 m_autosaveLastChange = -1;     // 最近一次修改的时间（m_clock）
+    QMetaObject::Connection m_autosaveRootConnection;  // 根节点 treeRevisionChanged 的连接
+    SplitPanelNode* m_autosavedRoot = nullptr;  // 上次自动保存时的根节点
+    quint64 m_autosavedRevision = 0;      // 上次自动保存时根节点的 treeRevision
+    double m_autosavedMinPanelSize = 0.0;
+    // 每个路径最后一次写入内容的哈希；只由保存工作线程访问（写入按提交顺序串行执行）
+    std::shared_ptr<QHash<QString, QByteArray>> m_writtenHashes = std::make_shared<QHash<QString, QByteArray>>();
+    
+    SplitHistory m_history;               // 撤销/重做栈
+    bool m_replayingHistory = false;      // 正在执行撤销/重做（期间不产生新记录）
+
 private slots:
+    /**
+     * 把本帧积压的预览比例写入容器
+     */
+    void flushLiveResize();
+    
+    /**
+     * 定时检查不可见的面板，休眠超过 hibernationDelay 的
+     */
+    void checkHiddenPanels();
+    
+    /**
+     * 防抖定时器到期：已空闲足够久或超过最大延迟时写入，否则顺延
+     */
+    void onAutosaveTimer();
+    
     /**
      * 处理延迟删除（已废弃）
      * 注：使用智能指针后，不再需要延迟删除机制
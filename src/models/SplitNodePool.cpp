@@ -0,0 +1,165 @@
+#include "SplitNodePool.hpp"
+#include <new>
+
+namespace {
+
+/**
+ * 每个线程的当前池（节点只在 GUI 线程创建，其他线程始终为 nullptr）
+ */
+thread_local SplitNodePool* t_currentPool = nullptr;
+
+} // namespace
+
+// ============================================================================
+// 生命周期
+// ============================================================================
+
+SplitNodePool* SplitNodePool::create()
+{
+    return new SplitNodePool();
+}
+
+void SplitNodePool::release()
+{
+    m_owned = false;
+    destroyIfUnused();
+}
+
+void SplitNodePool::destroyIfUnused() noexcept
+{
+    if (!m_owned && m_liveBlocks == 0) {
+        delete this;
+    }
+}
+
+// ============================================================================
+// 批量释放
+// ============================================================================
+
+bool SplitNodePool::reset()
+{
+    if (m_liveBlocks != 0) {
+        return false;
+    }
+
+    // 空闲链表中的块都位于 slab 内，回卷后整体作废
+    for (FreeBlock*& head : m_freeLists) {
+        head = nullptr;
+    }
+    m_bumpPtr = nullptr;
+    m_bumpEnd = nullptr;
+    m_nextSlab = 0;
+    return true;
+}
+
+bool SplitNodePool::trim()
+{
+    if (!reset()) {
+        return false;
+    }
+    m_slabs.clear();
+    m_slabs.shrink_to_fit();
+    return true;
+}
+
+// ============================================================================
+// 当前池
+// ============================================================================
+
+SplitNodePool* SplitNodePool::current()
+{
+    return t_currentPool;
+}
+
+SplitNodePool::Scope::Scope(SplitNodePool* pool)
+    : m_previous(t_currentPool)
+{
+    t_currentPool = pool;
+}
+
+SplitNodePool::Scope::~Scope()
+{
+    t_currentPool = m_previous;
+}
+
+// ============================================================================
+// 节点分配
+// ============================================================================
+
+void* SplitNodePool::allocateNode(std::size_t size)
+{
+    static_assert(sizeof(BlockHeader) == Granularity, "BlockHeader must occupy exactly one granule");
+
+    const std::size_t total = size + sizeof(BlockHeader);
+    SplitNodePool* pool = t_currentPool;
+    quint32 sizeClass = 0;
+    void* block = nullptr;
+
+    if (pool && total <= MaxBlockSize) {
+        sizeClass = static_cast<quint32>((total + Granularity - 1) / Granularity - 1);
+        block = pool->allocateBlock(sizeClass);
+    } else {
+        // 没有当前池或对象过大：走全局分配（默认对齐至少 16 字节）
+        pool = nullptr;
+        block = ::operator new(total);
+    }
+
+    auto* header = static_cast<BlockHeader*>(block);
+    header->pool = pool;
+    header->sizeClass = sizeClass;
+    header->magic = BlockMagic;
+    return header + 1;
+}
+
+void SplitNodePool::deallocateNode(void* ptr) noexcept
+{
+    if (!ptr) {
+        return;
+    }
+
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    Q_ASSERT_X(header->magic == BlockMagic, "SplitNodePool::deallocateNode",
+               "pointer was not allocated by SplitPanelNode::operator new");
+    header->magic = 0;
+
+    if (SplitNodePool* pool = header->pool) {
+        pool->releaseBlock(header, header->sizeClass);
+    } else {
+        ::operator delete(header);
+    }
+}
+
+void* SplitNodePool::allocateBlock(quint32 sizeClass)
+{
+    // 优先复用同级空闲块
+    if (FreeBlock* block = m_freeLists[sizeClass]) {
+        m_freeLists[sizeClass] = block->next;
+        ++m_liveBlocks;
+        return block;
+    }
+
+    // 从当前 slab 切分；剩余空间不足时启用下一块（reset 后保留的 slab 优先）
+    const std::size_t blockSize = (sizeClass + 1) * Granularity;
+    if (static_cast<std::size_t>(m_bumpEnd - m_bumpPtr) < blockSize) {
+        if (m_nextSlab == m_slabs.size()) {
+            m_slabs.push_back(std::unique_ptr<std::byte[]>(new std::byte[SlabSize]));
+        }
+        m_bumpPtr = m_slabs[m_nextSlab++].get();
+        m_bumpEnd = m_bumpPtr + SlabSize;
+    }
+
+    void* block = m_bumpPtr;
+    m_bumpPtr += blockSize;
+    ++m_liveBlocks;
+    return block;
+}
+
+void SplitNodePool::releaseBlock(void* block, quint32 sizeClass) noexcept
+{
+    auto* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = freeBlock;
+
+    --m_liveBlocks;
+    destroyIfUnused();
+}
@@ -0,0 +1,153 @@
+#ifndef SPLIT_NODE_POOL_HPP
+#define SPLIT_NODE_POOL_HPP
+
+#include <QtGlobal>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * ============================================================================
+ * SplitNodePool - 节点对象池（slab 分配）
+ * ============================================================================
+ *
+ * 作用：
+ *   PanelNode / ContainerNode 的对象内存从连续的大块（slab）中切分，
+ *   加载上千个节点时不再逐个 malloc/free
+ *
+ * 用法：
+ *   SplitPanelNode 重载了类级 operator new/delete，分配时使用当前线程的"当前池"：
+ *     SplitNodePool::Scope scope(m_nodePool);
+ *     auto panel = std::make_unique<PanelNode>(...);   // 内存来自 m_nodePool
+ *   没有设置当前池时退回全局 operator new，两种节点可以混在同一棵树里
+ *   释放一律经过 delete（unique_ptr、QObject 父对象析构、deleteLater 均可），
+ *   每个块前的块头记录了所属的池，不需要知道当前池
+ *
+ * 内存布局：
+ *   [BlockHeader 16 字节][节点对象]，按 16 字节分级（最大 MaxBlockSize）
+ *   同级的空闲块串成单链表复用；超过 MaxBlockSize 的对象走全局分配
+ *
+ * 批量释放：
+ *   reset() 在没有存活节点时一次性清空所有空闲链表并把 slab 回卷到开头，
+ *   下一次加载的布局重新从第一块 slab 连续分配；trim() 另外归还 slab 内存
+ *
+ * 生命周期：
+ *   池由 create() 创建、所有者（SplitManager）析构时 release()
+ *   所有者释放后池仍会等到最后一个节点被 delete 才销毁，
+ *   因此比 SplitManager 活得更久的节点（如 QML 持有的 createPanel() 结果）也能安全释放
+ *
+ * 注意：
+ *   - 池本身不加锁，节点只能在 GUI 线程创建和销毁（与 SplitManager 一致）
+ *   - 只管理节点对象本身；QObject 的 d 指针和 QString 仍由 Qt 自行分配
+ */
+class SplitNodePool {
+public:
+    static constexpr std::size_t SlabSize = 64 * 1024;   // 每块 slab 的字节数
+    static constexpr std::size_t Granularity = 16;       // 分级粒度（也是块的对齐）
+    static constexpr std::size_t MaxBlockSize = 512;     // 池内分配的最大块（含块头）
+
+    /**
+     * 创建池，调用方持有一个所有者引用
+     */
+    static SplitNodePool* create();
+
+    /**
+     * 释放所有者引用；没有存活节点时立即销毁，否则由最后一个节点销毁
+     */
+    void release();
+
+    SplitNodePool(const SplitNodePool&) = delete;
+    SplitNodePool& operator=(const SplitNodePool&) = delete;
+
+    // ========================================================================
+    // 批量释放
+    // ========================================================================
+
+    /**
+     * 没有存活节点时回卷所有 slab（保留内存供下次加载复用）
+     * 返回：是否执行了回卷
+     */
+    bool reset();
+
+    /**
+     * 没有存活节点时归还全部 slab 内存
+     * 返回：是否执行了归还
+     */
+    bool trim();
+
+    // ========================================================================
+    // 统计
+    // ========================================================================
+
+    std::size_t liveBlocks() const { return m_liveBlocks; }
+    std::size_t slabCount() const { return m_slabs.size(); }
+    std::size_t reservedBytes() const { return m_slabs.size() * SlabSize; }
+
+    // ========================================================================
+    // 当前池
+    // ========================================================================
+
+    /**
+     * 当前线程的当前池（没有时为 nullptr）
+     */
+    static SplitNodePool* current();
+
+    /**
+     * 作用域内把指定池设为当前池，析构时恢复之前的值（可嵌套）
+     */
+    class Scope {
+    public:
+        explicit Scope(SplitNodePool* pool);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        SplitNodePool* m_previous;
+    };
+
+    // ========================================================================
+    // 节点分配入口（供 SplitPanelNode::operator new/delete 使用）
+    // ========================================================================
+
+    static void* allocateNode(std::size_t size);
+    static void deallocateNode(void* ptr) noexcept;
+
+private:
+    /**
+     * 块头：位于每个节点对象之前，保证对象按 Granularity 对齐
+     */
+    struct alignas(Granularity) BlockHeader {
+        SplitNodePool* pool;    // 所属的池（全局分配时为 nullptr）
+        quint32 sizeClass;      // 分级下标（块大小 = (sizeClass + 1) * Granularity）
+        quint32 magic;          // 校验值，捕获非本分配器分配的指针
+    };
+
+    /**
+     * 空闲块（复用块自身的内存串成链表）
+     */
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr quint32 BlockMagic = 0x534e5042;   // "SNPB"
+    static constexpr std::size_t SizeClassCount = MaxBlockSize / Granularity;
+
+    SplitNodePool() = default;
+    ~SplitNodePool() = default;
+
+    void* allocateBlock(quint32 sizeClass);
+    void releaseBlock(void* block, quint32 sizeClass) noexcept;
+    void destroyIfUnused() noexcept;
+
+    std::vector<std::unique_ptr<std::byte[]>> m_slabs;
+    FreeBlock* m_freeLists[SizeClassCount] = {};
+    std::byte* m_bumpPtr = nullptr;       // 当前 slab 的下一个可分配位置
+    std::byte* m_bumpEnd = nullptr;       // 当前 slab 的末尾
+    std::size_t m_nextSlab = 0;           // 下一块要启用的 slab（reset 后从 0 开始复用）
+    std::size_t m_liveBlocks = 0;         // 池内存活的节点数
+    bool m_owned = true;                  // 所有者是否还持有引用
+};
+
+#endif // SPLIT_NODE_POOL_HPP
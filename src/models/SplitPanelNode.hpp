@@ -2,11 +2,17 @@
 #define SPLIT_PANEL_NODE_HPP
 
 #include <QObject>
+#include <QRectF>
+#include <QSizeF>
 #include <QString>
 #include <QVariantMap>
-#include <QtQml/qqmlregistration.h>
 #include <QtMath>
 #include <memory>
+#include <utility>
+#include <vector>
+#include "SplitNodePool.hpp"
+#include "SplitPanelTypeRegistry.hpp"
+#include "../utils/SplitProfiler.hpp"
 
 // ============================================================================
 // 内联辅助函数（原CommonHelpers中的函数）
@@ -68,6 +74,8 @@ inline double validateMinSize(double size) {
 
 } // namespace DockingNodeHelpers
 
+class ContainerNode;
+
 /**
  * 统一的停靠节点类 - 消除双节点系统冗余
  * 
@@ -79,12 +87,12 @@ inline double validateMinSize(double size) {
  */
 class SplitPanelNode : public QObject {
     Q_OBJECT
-    QML_ELEMENT
-    QML_UNCREATABLE("SplitPanelNod is abstract - use PanelNode or ContainerNode")
     
     Q_PROPERTY(NodeType nodeType READ nodeType CONSTANT)
     Q_PROPERTY(QString nodeId READ nodeId CONSTANT)
     Q_PROPERTY(double minSize READ minSize WRITE setMinSize NOTIFY minSizeChanged)
+    Q_PROPERTY(QRectF layoutRect READ layoutRect NOTIFY layoutGeometryChanged)
+    Q_PROPERTY(QSizeF layoutMinimumSize READ layoutMinimumSize NOTIFY layoutGeometryChanged)
     
 public:
     enum NodeType { Panel, Container };
@@ -97,26 +105,165 @@ public:
     void setMinSize(double size) {
         double validatedSize = SplitPanelNodeHelpers::validateMinSize(size);
         if (SplitPanelNodeHelpers::safeSetValue(m_minSize, validatedSize)) {
-            emit minSizeChanged();
+            touchRevision();
+            if (!deferSignal(MinSizeSignal)) emit minSizeChanged();
         }
     }
     
     virtual QVariantMap toVariant() const = 0;
     
+    // ========================================================================
+    // 树结构（C++ 接口）
+    // ========================================================================
+    
+    /**
+     * 所在的容器（根节点和已从容器取下的节点为 nullptr）
+     * 由 ContainerNode 挂接/取下子节点时维护，不经过 QObject 父对象和 qobject_cast
+     */
+    ContainerNode* parentContainer() const;
+    
+    /**
+     * 子树版本号
+     * 本节点或任一后代的可序列化状态（结构、比例、方向、最小尺寸、标题、面板类型）
+     * 变化时更新为新的全局序号；根节点的版本号不变说明整棵树没有变化
+     * 用途：SplitManager::flatTree() 的缓存判断、自动保存的脏检查
+     */
+    quint64 treeRevision() const { return m_treeRevision; }
+    
+    // ========================================================================
+    // 布局几何（由 SplitLayoutSolver 写入）
+    // ========================================================================
+    
+    /**
+     * 节点在所在容器内容区中的矩形（根节点相对视口）；尚未求解时为空矩形
+     * QML 直接绑定它作为 SplitView 的首选尺寸，不再逐个 Loader 用 JS 计算
+     */
+    QRectF layoutRect() const { return m_layoutRect; }
+    
+    /**
+     * 子树的最小尺寸：所有后代的 minSize 约束汇总（含分割条和标签栏）
+     */
+    QSizeF layoutMinimumSize() const { return m_layoutMinimum; }
+    
+    // ========================================================================
+    // 信号延迟（批量修改，由 SplitManager::beginBatch/commitBatch 驱动）
+    // ========================================================================
+    
+    /**
+     * 开启/关闭信号延迟
+     * 开启后属性和子节点变化只记录在 m_pendingSignals 中，不立即发送
+     * 注意：关闭时不会补发，补发请调用 flushDeferredSignals()
+     */
+    void setSignalsDeferred(bool deferred) { m_signalsDeferred = deferred; }
+    bool signalsDeferred() const { return m_signalsDeferred; }
+    
+    /**
+     * 结束延迟并补发积压的信号
+     * 同一种信号无论积压多少次只发送一次
+     */
+    void flushDeferredSignals() {
+        m_signalsDeferred = false;
+        const quint32 pending = std::exchange(m_pendingSignals, 0u);
+        if (pending) {
+            emitDeferredSignals(pending);
+        }
+    }
+    
     // 优化: 虚析构函数确保正确清理
     virtual ~SplitPanelNode() = default;
     
+    // ========================================================================
+    // 内存分配（SplitNodePool）
+    // ========================================================================
+    
+    /**
+     * 节点内存来自当前池（SplitNodePool::Scope），没有当前池时走全局分配
+     * 虚析构保证 delete 基类指针时也调用这里的 operator delete，
+     * unique_ptr / QObject 父子析构 / deleteLater 都无需区分节点来源
+     */
+    static void* operator new(std::size_t size) { return SplitNodePool::allocateNode(size); }
+    static void operator delete(void* ptr) noexcept { SplitNodePool::deallocateNode(ptr); }
+    
 signals:
     void minSizeChanged();
     
+    /**
+     * 子树版本号变化（只由最顶层的节点发送，即 SplitManager 的根节点）
+     * 不延迟：批量修改期间每次修改都会发送，接收方应只做标记
+     */
+    void treeRevisionChanged();
+    
+    /**
+     * layoutRect / layoutMinimumSize 变化（不延迟：求解器只在批量修改提交后运行）
+     */
+    void layoutGeometryChanged();
+    
 protected:
     explicit SplitPanelNode(NodeType type, const QString& id, QObject* parent = nullptr)
         : QObject(parent), m_type(type), m_id(id) {}
     
+    /**
+     * 可延迟的信号位（子类共用一套编号）
+     */
+    enum DeferredSignal : quint32 {
+        MinSizeSignal     = 1u << 0,
+        TitleSignal       = 1u << 1,
+        QmlSourceSignal   = 1u << 2,
+        OrientationSignal = 1u << 3,
+        SplitRatioSignal  = 1u << 4,
+        ChildrenSignal    = 1u << 5,
+        HibernatedSignal  = 1u << 6,
+        CurrentIndexSignal = 1u << 7
+    };
+    
+    /**
+     * 尝试延迟一个信号
+     * 返回：true 表示已记录待发（调用方不要再 emit），false 表示应立即发送
+     */
+    bool deferSignal(DeferredSignal bit) {
+        if (!m_signalsDeferred) return false;
+        m_pendingSignals |= bit;
+        return true;
+    }
+    
+    /**
+     * 补发积压的信号（子类重写以处理自己的信号位，并调用基类版本）
+     */
+    virtual void emitDeferredSignals(quint32 pending) {
+        if (pending & MinSizeSignal) emit minSizeChanged();
+    }
+    
+    /**
+     * 可序列化状态变化：本节点和所有祖先的版本号更新为新序号（O(深度)）
+     */
+    void touchRevision() {
+        const quint64 revision = ++s_revisionCounter;
+        SplitPanelNode* top = this;
+        for (SplitPanelNode* node = this; node; node = node->m_parentNode) {
+            node->m_treeRevision = revision;
+            top = node;
+        }
+        emit top->treeRevisionChanged();
+    }
+    
 private:
+    friend class ContainerNode;  // 维护 m_parentNode
+    friend class SplitLayoutSolver;  // 写入几何和求解缓存
+    
+    static inline quint64 s_revisionCounter = 0;  // 全局递增（节点只在 GUI 线程修改）
+    
     NodeType m_type;
     QString m_id;
     double m_minSize = 150.0;
+    bool m_signalsDeferred = false;  // 是否处于批量修改中
+    quint32 m_pendingSignals = 0;    // 积压的信号位（DeferredSignal 组合）
+    SplitPanelNode* m_parentNode = nullptr;         // 所在的容器（见 parentContainer()）
+    quint64 m_treeRevision = ++s_revisionCounter;   // 新节点取新序号，复用的地址不会与旧缓存混淆
+    
+    QRectF m_layoutRect;              // 求解结果（见 layoutRect()）
+    QSizeF m_layoutMinimum;           // 子树最小尺寸（见 layoutMinimumSize()）
+    quint64 m_layoutRevision = 0;     // 上次放置子节点时的 treeRevision（0 = 从未求解）
+    quint64 m_minimumRevision = 0;    // 上次计算 m_layoutMinimum 时的 treeRevision
 };
 
 // ============================================================================
@@ -142,7 +289,6 @@ private:
  */
 class PanelNode : public SplitPanelNode {
     Q_OBJECT
-    QML_ELEMENT
     
     // ========================================================================
     // QML 属性
@@ -151,9 +297,15 @@ class PanelNode : public SplitPanelNode {
     // title - 面板标题
     Q_PROPERTY(QString title READ title WRITE setTitle NOTIFY titleChanged)
     
-    // qmlSource - QML 内容文件路径
+    // qmlSource - QML 内容文件路径（来自面板类型）
     Q_PROPERTY(QString qmlSource READ qmlSource WRITE setQmlSource NOTIFY qmlSourceChanged)
     
+    // panelType - 已注册的面板类型键（匿名类型为空，见 SplitPanelTypeRegistry）
+    Q_PROPERTY(QString panelType READ panelType NOTIFY qmlSourceChanged)
+    
+    // hibernated - 是否休眠（内容已卸载，由 SplitManager 的休眠策略控制）
+    Q_PROPERTY(bool hibernated READ hibernated NOTIFY hibernatedChanged)
+    
 public:
     /**
      * 构造函数
@@ -172,14 +324,42 @@ public:
     QString title() const { return m_title; }
     void setTitle(const QString& title) {
         if (SplitPanelNodeHelpers::safeSetValue(m_title, title)) {
-            emit titleChanged();
+            touchRevision();
+            if (!deferSignal(TitleSignal)) emit titleChanged();
+        }
+    }
+    
+    QString qmlSource() const { return m_type ? m_type->qmlSource : QString(); }
+    QString panelType() const { return m_type ? m_type->key : QString(); }
+    
+    /**
+     * 面板类型句柄（同类面板共享，SplitManager 通过类型注册表分配）
+     */
+    const SplitPanelType& type() const { return m_type; }
+    void setType(const SplitPanelType& type) {
+        if (m_type != type) {
+            m_type = type;
+            touchRevision();
+            if (!deferSignal(QmlSourceSignal)) emit qmlSourceChanged();
         }
     }
     
-    QString qmlSource() const { return m_qmlSource; }
+    /**
+     * 直接指定内容路径（不经过注册表，得到一个本节点独有的匿名类型）
+     */
     void setQmlSource(const QString& source) {
-        if (SplitPanelNodeHelpers::safeSetValue(m_qmlSource, source)) {
-            emit qmlSourceChanged();
+        if (panelType().isEmpty() && qmlSource() == source) return;
+        setType(SplitPanelTypeRegistry::makeAnonymous(source));
+    }
+    
+    /**
+     * 休眠状态（只在运行时有效，不写入布局文件）
+     * 休眠时视图卸载内容，内容状态由 SplitManager::storePanelState 暂存
+     */
+    bool hibernated() const { return m_hibernated; }
+    void setHibernated(bool hibernated) {
+        if (SplitPanelNodeHelpers::safeSetValue(m_hibernated, hibernated)) {
+            if (!deferSignal(HibernatedSignal)) emit hibernatedChanged();
         }
     }
     
@@ -194,68 +374,254 @@ public:
      *   type: "panel",
      *   id: "welcome_panel",
      *   title: "欢迎面板",
-     *   qmlSource: "qrc:/qml/...",
+     *   panelType: "content",          ← 已注册类型
+     *   qmlSource: "qrc:/qml/...",     ← 匿名类型（二者只写其一）
      *   minSize: 150
      * }
      */
     QVariantMap toVariant() const override {
-        return {
+        QVariantMap map{
             {"type", "panel"},
             {"id", nodeId()},
             {"title", m_title},
-            {"qmlSource", m_qmlSource},
             {"minSize", minSize()}
         };
+        if (SplitPanelTypeRegistry::isRegistered(m_type)) {
+            map.insert("panelType", m_type->key);
+        } else {
+            map.insert("qmlSource", qmlSource());
+        }
+        return map;
     }
     
 signals:
     void titleChanged();      // 标题改变信号
     void qmlSourceChanged();  // QML 源文件改变信号
+    void hibernatedChanged(); // 休眠状态改变信号
+    
+protected:
+    void emitDeferredSignals(quint32 pending) override {
+        SplitPanelNode::emitDeferredSignals(pending);
+        if (pending & TitleSignal) emit titleChanged();
+        if (pending & QmlSourceSignal) emit qmlSourceChanged();
+        if (pending & HibernatedSignal) emit hibernatedChanged();
+    }
     
 private:
     QString m_title;          // 面板标题
-    QString m_qmlSource;      // QML 内容文件路径
+    SplitPanelType m_type;    // 面板类型（qmlSource 等共享数据）
+    bool m_hibernated = false; // 是否休眠
 };
 
 // ============================================================================
 // 容器节点 - 替代原来的 SplitContainerNode
 // ============================================================================
+/**
+ * 作用：
+ *   把 N 个子节点沿同一方向排列（N >= 2；构建过程中可能暂时少于 2 个）
+ *   五个并排的面板只需一个容器，而不是四层嵌套的二分容器
+ * 
+ * 尺寸：
+ *   sizes[i] 是第 i 个子节点占容器的比例，总和为 1
+ *   splitRatio 等于 sizes[0]（兼容两个子节点的用法和 2.1 以前的布局文件）
+ * 
+ * 规范化：
+ *   相邻的同方向容器由 SplitManager 合并（mergeChild），
+ *   因此子容器的方向总是与父容器不同
+ * 
+ * 标签页（Stacked）：
+ *   子节点叠放在同一块区域，只显示 currentIndex 指向的一个（QML 只为它创建视图）
+ *   sizes 照常维护（切换回分割方向时沿用），不影响显示
+ */
 class ContainerNode : public SplitPanelNode {
     Q_OBJECT
-    QML_ELEMENT
     
     Q_PROPERTY(Orientation orientation READ orientation WRITE setOrientation NOTIFY orientationChanged)
     Q_PROPERTY(qreal splitRatio READ splitRatio WRITE setSplitRatio NOTIFY splitRatioChanged)
-    Q_PROPERTY(SplitPanelNode* firstChild READ firstChild NOTIFY childrenChanged)
-    Q_PROPERTY(SplitPanelNode* secondChild READ secondChild NOTIFY childrenChanged)
+    Q_PROPERTY(QList<qreal> sizes READ sizes WRITE setSizes NOTIFY sizesChanged)
+    Q_PROPERTY(QList<qreal> previewSizes READ previewSizes NOTIFY previewSizesChanged)
+    Q_PROPERTY(bool resizing READ resizing NOTIFY resizingChanged)
+    Q_PROPERTY(int childCount READ childCount NOTIFY childrenChanged)
+    Q_PROPERTY(QVariantList childNodes READ childNodes NOTIFY childrenChanged)
+    Q_PROPERTY(int currentIndex READ currentIndex WRITE setCurrentIndex NOTIFY currentIndexChanged)
     
 public:
-    enum Orientation { Horizontal, Vertical };
+    enum Orientation { Horizontal, Vertical, Stacked };
     Q_ENUM(Orientation)
     
+    /**
+     * 单个子节点的最小比例（拖动或加载得到的比例低于此值时被抬高）
+     */
+    static constexpr double MinChildShare = 0.02;
+    
     explicit ContainerNode(const QString& id, Orientation orient = Horizontal, QObject* parent = nullptr)
         : SplitPanelNode(NodeType::Container, id, parent), m_orientation(orient) {}
     
     // 优化: 析构时清理子节点
     ~ContainerNode() override {
-        // 智能指针会自动清理，但显式重置确保顺序
-        m_firstChild.reset();
-        m_secondChild.reset();
+        // 智能指针会自动清理，但显式按顺序释放
+        m_children.clear();
     }
     
     Orientation orientation() const { return m_orientation; }
     void setOrientation(Orientation orient) {
         if (SplitPanelNodeHelpers::safeSetValue(m_orientation, orient)) {
-            emit orientationChanged();
+            touchRevision();
+            if (!deferSignal(OrientationSignal)) {
+                countSignals(1);
+                emit orientationChanged();
+            }
         }
     }
     
-    qreal splitRatio() const { return m_splitRatio; }
+    /**
+     * 方向的布局文件名称（"horizontal" / "vertical" / "stacked"）
+     * 无法识别的名称按 Vertical 处理（与旧版本的读取方式相同）
+     */
+    static QString orientationName(Orientation orient) {
+        switch (orient) {
+        case Horizontal: return QStringLiteral("horizontal");
+        case Stacked:    return QStringLiteral("stacked");
+        case Vertical:   break;
+        }
+        return QStringLiteral("vertical");
+    }
+    static Orientation orientationFromName(const QString& name) {
+        if (name == QLatin1String("horizontal")) return Horizontal;
+        if (name == QLatin1String("stacked")) return Stacked;
+        return Vertical;
+    }
+    
+    // ========================================================================
+    // 标签页（Stacked）
+    // ========================================================================
+    
+    /**
+     * 当前显示的子节点（标签页容器使用；没有子节点时为 -1）
+     * 跟随子节点本身：前面插入或删除子节点后仍指向同一个；
+     * 当前子节点被取下时改为原位置上的下一个（末尾时为上一个）
+     */
+    int currentIndex() const {
+        if (m_children.empty()) return -1;
+        const int index = indexOf(m_currentChild);
+        return index >= 0 ? index : qBound(0, m_currentHint, childCount() - 1);
+    }
+    void setCurrentIndex(int index) {
+        if (index < 0 || index >= childCount()) return;
+        const int before = currentIndex();
+        m_currentChild = m_children[size_t(index)].get();
+        m_currentHint = index;
+        if (before != index) {
+            touchRevision();
+            notifyCurrentIndexChanged();
+        }
+    }
+    
+    // ========================================================================
+    // 尺寸比例
+    // ========================================================================
+    
+    /**
+     * 第一个子节点的比例
+     * 子节点少于 2 个时返回预设比例（第二个子节点加入时生效）
+     */
+    qreal splitRatio() const { return m_sizes.size() >= 2 ? m_sizes.first() : m_initialRatio; }
+    
+    /**
+     * 设置第一个子节点的比例（限制在 0.1 - 0.9）
+     * 两个子节点：sizes = [ratio, 1 - ratio]
+     * 多个子节点：其余子节点按原比例分配剩下的空间
+     */
     void setSplitRatio(qreal ratio) {
-        double validatedRatio = SplitPanelNodeHelpers::validateSplitRatio(ratio);
-        if (SplitPanelNodeHelpers::safeSetValue(m_splitRatio, validatedRatio)) {
-            emit splitRatioChanged();
+        const double validatedRatio = SplitPanelNodeHelpers::validateSplitRatio(ratio);
+        if (m_sizes.size() < 2) {
+            if (SplitPanelNodeHelpers::safeSetValue(m_initialRatio, validatedRatio)) {
+                notifySizesChanged();
+            }
+            return;
+        }
+        
+        QList<qreal> sizes = m_sizes;
+        const double rest = 1.0 - sizes.first();
+        for (qsizetype i = 1; i < sizes.size(); ++i) {
+            sizes[i] = rest > 0 ? sizes[i] / rest * (1.0 - validatedRatio)
+                                : (1.0 - validatedRatio) / (sizes.size() - 1);
         }
+        sizes[0] = validatedRatio;
+        applySizes(sizes);
+    }
+    
+    /**
+     * 全部子节点的比例（长度等于 childCount，总和为 1）
+     */
+    QList<qreal> sizes() const { return m_sizes; }
+    
+    /**
+     * 设置全部子节点的比例
+     * 长度与子节点数不一致时忽略；非正数按平均值处理，然后归一化
+     * 返回：比例是否发生变化
+     */
+    bool setSizes(const QList<qreal>& sizes) {
+        if (sizes.size() != m_sizes.size()) return false;
+        return applySizes(normalizedSizes(sizes));
+    }
+    
+    // ========================================================================
+    // 实时拖动（预览比例）
+    // ========================================================================
+    
+    /**
+     * 预览比例：拖动期间为拖动中的比例，否则等于 sizes
+     * 用途：拖动时需要跟随比例的界面（如比例提示）绑定此属性，
+     *       sizes 只在松开时提交一次，嵌套布局不会按输入事件频率重排
+     */
+    QList<qreal> previewSizes() const { return m_resizing ? m_previewSizes : m_sizes; }
+    
+    /**
+     * 是否正在实时拖动
+     */
+    bool resizing() const { return m_resizing; }
+    
+    /**
+     * 开始拖动：预览比例从当前 sizes 开始
+     */
+    void beginResize() {
+        if (m_resizing) return;
+        m_resizing = true;
+        m_previewSizes = m_sizes;
+        countSignals(1);
+        emit resizingChanged();
+    }
+    
+    /**
+     * 更新预览比例（仅拖动期间有效，不触发 sizesChanged）
+     */
+    void setPreviewSizes(const QList<qreal>& sizes) {
+        if (!m_resizing || sizes.size() != m_sizes.size()) return;
+        const QList<qreal> normalized = normalizedSizes(sizes);
+        if (!sameSizes(m_previewSizes, normalized)) {
+            m_previewSizes = normalized;
+            countSignals(1);
+            emit previewSizesChanged();
+        }
+    }
+    
+    /**
+     * 结束拖动
+     * 参数：commit - true 把预览比例提交为 sizes，false 放弃（恢复拖动前的比例）
+     * 返回：sizes 是否发生变化
+     */
+    bool endResize(bool commit = true) {
+        if (!m_resizing) return false;
+        m_resizing = false;
+        
+        const bool changed = commit && m_previewSizes.size() == m_sizes.size()
+                             && applySizes(m_previewSizes);
+        m_previewSizes.clear();
+        countSignals(2);
+        emit resizingChanged();
+        emit previewSizesChanged();
+        return changed;
     }
     
     // ========================================================================
@@ -263,98 +629,207 @@ public:
     // ========================================================================
     
     /**
-     * 获取第一个子节点
-     * 返回：原始指针（QML 可以直接使用）
-     * 用途：在 QML 中访问子节点（如 container.firstChild）
+     * 获取子节点数量
      */
-    SplitPanelNode* firstChild() const { return m_firstChild.get(); }
+    int childCount() const { return int(m_children.size()); }
     
     /**
-     * 获取第二个子节点
-     * 返回：原始指针（QML 可以直接使用）
+     * 按索引获取子节点
+     * 返回：对应的子节点指针，无效索引返回 nullptr
+     * 用途：C++ 遍历（QML 使用 childNodes）
      */
-    SplitPanelNode* secondChild() const { return m_secondChild.get(); }
+    SplitPanelNode* child(int index) const {
+        return (index >= 0 && index < childCount()) ? m_children[size_t(index)].get() : nullptr;
+    }
+    
+    /**
+     * 所有子节点（QML 中用 container.childNodes[index] 访问）
+     */
+    QVariantList childNodes() const {
+        QVariantList result;
+        result.reserve(childCount());
+        for (const auto& node : m_children) {
+            result.append(QVariant::fromValue(node.get()));
+        }
+        return result;
+    }
+    
+    /**
+     * 子节点的索引（不是本容器的子节点时返回 -1）
+     */
+    int indexOf(const SplitPanelNode* node) const {
+        for (size_t i = 0; i < m_children.size(); ++i) {
+            if (m_children[i].get() == node) return int(i);
+        }
+        return -1;
+    }
     
     // ========================================================================
     // 子节点管理（C++ 接口 - 使用智能指针）
     // ========================================================================
     
     /**
-     * 设置第一个子节点
-     * 参数：child - 智能指针（所有权转移）
-     * 用途：添加面板、重组树时调用
-     * 
-     * 重要：使用 std::move() 转移所有权
-     * 示例：container->setFirstChild(std::move(panelNode))
+     * 在末尾追加子节点（所有权转移）
+     * 比例：第二个子节点加入时使用 splitRatio，之后新子节点平分
+     * 用途：创建容器、加载布局（加载完子节点后再 setSizes）
      */
-    void setFirstChild(std::unique_ptr<SplitPanelNode> child) {
-        m_firstChild = std::move(child);  // 所有权转移
-        if (m_firstChild) {
-            m_firstChild->setParent(this);  // 设置 Qt 父对象（内存管理）
+    void appendChild(std::unique_ptr<SplitPanelNode> child) {
+        if (!child) return;
+        
+        const qsizetype count = m_sizes.size();
+        if (count == 0) {
+            m_sizes = {1.0};
+        } else if (count == 1) {
+            m_sizes = {m_initialRatio, 1.0 - m_initialRatio};
+        } else {
+            const double share = 1.0 / double(count + 1);
+            for (qreal& size : m_sizes) size *= 1.0 - share;
+            m_sizes.append(share);
         }
-        // 立即发送信号，与 SplitManager::emitPanelRemovedSignals 保持同步
-        // 避免延迟导致 QML 绑定访问到不一致状态
-        emit childrenChanged();
+        adopt(child.get());
+        m_children.push_back(std::move(child));
+        notifyChildrenChanged();
+        notifySizesChanged();
     }
     
     /**
-     * 设置第二个子节点
-     * 参数：child - 智能指针（所有权转移）
+     * 在 index 处插入子节点，新子节点分走 donorIndex 处子节点一半的空间
+     * 参数：
+     *   index - 插入位置（0 ~ childCount）
+     *   child - 子节点（所有权转移）
+     *   donorIndex - 让出空间的子节点（插入前的索引），其余子节点尺寸不变
+     * 用途：在同方向容器中目标面板旁插入新面板
      */
-    void setSecondChild(std::unique_ptr<SplitPanelNode> child) {
-        m_secondChild = std::move(child);
-        if (m_secondChild) {
-            m_secondChild->setParent(this);
+    void insertChild(int index, std::unique_ptr<SplitPanelNode> child, int donorIndex) {
+        if (!child || index < 0 || index > childCount()) return;
+        if (donorIndex < 0 || donorIndex >= childCount()) {
+            appendChild(std::move(child));
+            return;
         }
-        // 立即发送信号，与 SplitManager::emitPanelRemovedSignals 保持同步
-        emit childrenChanged();
+        
+        const double half = m_sizes[donorIndex] / 2.0;
+        m_sizes[donorIndex] = half;
+        m_sizes.insert(index, half);
+        adopt(child.get());
+        m_children.insert(m_children.begin() + index, std::move(child));
+        notifyChildrenChanged();
+        notifySizesChanged();
     }
     
     /**
-     * 取出第一个子节点（移除并返回所有权）
-     * 返回：智能指针（所有权转移给调用者）
-     * 用途：移除面板、重组树时调用
-     * 
-     * 重要：调用后 m_firstChild 变为 nullptr
+     * 在 index 处插入子节点，新子节点占 share 的空间，其余子节点按比例缩小
+     * 用途：在整个同方向容器的一侧插入新面板（与"新建容器包住目标"得到相同的比例）
+     */
+    void insertChildWithShare(int index, std::unique_ptr<SplitPanelNode> child, double share) {
+        if (!child || index < 0 || index > childCount()) return;
+        if (m_sizes.isEmpty()) {
+            appendChild(std::move(child));
+            return;
+        }
+    
+        share = SplitPanelNodeHelpers::clampValue(share, MinChildShare, 1.0 - MinChildShare);
+        for (qreal& size : m_sizes) size *= 1.0 - share;
+        m_sizes.insert(index, share);
+        adopt(child.get());
+        m_children.insert(m_children.begin() + index, std::move(child));
+        notifyChildrenChanged();
+        notifySizesChanged();
+    }
+    
+    /**
+     * 取出子节点（移除并返回所有权）
+     * 比例：被移除的空间按比例分给其余子节点
+     * 注意：容器只剩一个子节点时应由 SplitManager 用该子节点替换容器
      */
-    std::unique_ptr<SplitPanelNode> takeFirstChild() {
-        auto child = std::move(m_firstChild);  // 所有权转出
+    std::unique_ptr<SplitPanelNode> takeChild(int index) {
+        if (index < 0 || index >= childCount()) return nullptr;
+        
+        auto child = std::move(m_children[size_t(index)]);
+        child->m_parentNode = nullptr;
+        if (m_currentChild == child.get()) {
+            m_currentChild = nullptr;  // 原位置上的下一个成为当前标签
+            m_currentHint = index;
+        }
+        m_children.erase(m_children.begin() + index);
+        m_sizes.removeAt(index);
+        m_sizes = normalizedSizes(m_sizes);
         // 立即发送信号，确保在 removePanel 流程中子节点状态实时更新
         // 避免 QML 绑定访问到已被 take 的悬空指针
-        emit childrenChanged();
+        notifyChildrenChanged();
+        notifySizesChanged();
         return child;
     }
     
     /**
-     * 取出第二个子节点（移除并返回所有权）
+     * 取出全部子节点（子节点的 Qt 父对象置空，容器变为空容器）
+     * 用途：SplitManager::applyLayout 重新挂接子节点列表发生变化的容器
      */
-    std::unique_ptr<SplitPanelNode> takeSecondChild() {
-        auto child = std::move(m_secondChild);
-        // 立即发送信号，确保在 removePanel 流程中子节点状态实时更新
-        emit childrenChanged();
-        return child;
+    std::vector<std::unique_ptr<SplitPanelNode>> takeChildren() {
+        m_currentHint = qMax(0, currentIndex());
+        m_currentChild = nullptr;
+        std::vector<std::unique_ptr<SplitPanelNode>> children = std::exchange(m_children, {});
+        m_sizes.clear();
+        for (const auto& child : children) {
+            // 取下的节点可能比本容器活得久，不能再作为 Qt 子对象被连带释放
+            child->setParent(nullptr);
+            child->m_parentNode = nullptr;
+        }
+        notifyChildrenChanged();
+        notifySizesChanged();
+        return children;
     }
     
     /**
-     * 获取子节点数量
-     * 返回：0, 1, 或 2
+     * 替换子节点（新子节点沿用旧子节点的比例）
+     * 返回：旧子节点（所有权转移给调用者），索引无效时返回 nullptr
      */
-    int childCount() const {
-        int count = 0;
-        if (m_firstChild) count++;
-        if (m_secondChild) count++;
-        return count;
+    std::unique_ptr<SplitPanelNode> replaceChild(int index, std::unique_ptr<SplitPanelNode> child) {
+        if (index < 0 || index >= childCount() || !child) return nullptr;
+        
+        adopt(child.get());
+        auto old = std::exchange(m_children[size_t(index)], std::move(child));
+        old->m_parentNode = nullptr;
+        if (m_currentChild == old.get()) {
+            m_currentChild = m_children[size_t(index)].get();  // 新子节点接替当前标签
+        }
+        // 立即发送信号，与 SplitManager::emitPanelRemovedSignals 保持同步
+        notifyChildrenChanged();
+        return old;
     }
     
     /**
-     * 按索引获取子节点
-     * 参数：index - 0 或 1
-     * 返回：对应的子节点指针，无效索引返回 nullptr
+     * 把 index 处的同方向子容器展开到本容器中
+     * 子容器的子节点按其比例瓜分子容器原来的空间
+     * 返回：已清空的子容器（调用方负责从索引中注销），不能合并时返回 nullptr
      */
-    SplitPanelNode* child(int index) const {
-        if (index == 0) return m_firstChild.get();
-        if (index == 1) return m_secondChild.get();
-        return nullptr;
+    std::unique_ptr<ContainerNode> mergeChild(int index) {
+        auto* inner = qobject_cast<ContainerNode*>(child(index));
+        if (!inner || inner->orientation() != m_orientation) return nullptr;
+        
+        std::unique_ptr<SplitPanelNode> taken = std::move(m_children[size_t(index)]);
+        m_children.erase(m_children.begin() + index);
+        const double share = m_sizes.takeAt(index);
+        
+        std::unique_ptr<ContainerNode> emptied(static_cast<ContainerNode*>(taken.release()));
+        emptied->m_parentNode = nullptr;
+        if (m_currentChild == emptied.get()) {
+            // 合并的是当前标签：改为它内部的当前标签
+            m_currentChild = emptied->child(emptied->currentIndex());
+            m_currentHint = index + qMax(0, emptied->currentIndex());
+        }
+        const QList<qreal> innerSizes = emptied->m_sizes;
+        for (int i = 0; i < int(emptied->m_children.size()); ++i) {
+            auto grandChild = std::move(emptied->m_children[size_t(i)]);
+            adopt(grandChild.get());
+            m_children.insert(m_children.begin() + index + i, std::move(grandChild));
+            m_sizes.insert(index + i, share * innerSizes.value(i));
+        }
+        emptied->m_children.clear();
+        emptied->m_sizes.clear();
+        
+        notifyChildrenChanged();
+        notifySizesChanged();
+        return emptied;
     }
     
     // ========================================================================
@@ -365,62 +840,174 @@ public:
      * 序列化为 QVariantMap（保存布局时调用）
      * 返回：包含容器和所有子节点信息的嵌套 Map
      * 
-     * 格式：{
+     * 格式（2.2）：{
      *   type: "container",
      *   id: "node_1",
-     *   orientation: "horizontal",
-     *   splitRatio: 0.3,
+     *   orientation: "vertical",
+     *   sizes: [0.2, 0.3, 0.5],
      *   minSize: 150,
-     *   first: {子节点的 toVariant()},    ← 递归！
-     *   second: {子节点的 toVariant()}   ← 递归！
+     *   children: [子节点的 toVariant(), ...]    ← 递归！
      * }
+     * 标签页容器（orientation: "stacked"）另有 currentIndex
      * 
-     * 递归示例：
-     *   Container
-     *   ├─ Panel A
-     *   └─ Container
-     *      ├─ Panel B
-     *      └─ Panel C
-     * 
-     * 生成：{
-     *   type: "container",
-     *   first: {type: "panel", id: "A", ...},
-     *   second: {
-     *     type: "container",
-     *     first: {type: "panel", id: "B", ...},
-     *     second: {type: "panel", id: "C", ...}
-     *   }
-     * }
+     * 2.1 以前的二分格式（splitRatio + first/second）仍可读取
      */
     QVariantMap toVariant() const override {
+        QVariantList sizes;
+        QVariantList children;
+        for (size_t i = 0; i < m_children.size(); ++i) {
+            sizes.append(m_sizes.value(qsizetype(i)));
+            children.append(m_children[i]->toVariant());
+        }
+        
         QVariantMap result{
             {"type", "container"},
             {"id", nodeId()},
-            {"orientation", m_orientation == Horizontal ? "horizontal" : "vertical"},
-            {"splitRatio", m_splitRatio},  // 保存分割比例（0.1-0.9）
-            {"minSize", minSize()}
+            {"orientation", orientationName(m_orientation)},
+            {"sizes", sizes},
+            {"minSize", minSize()},
+            {"children", children}
         };
+        if (m_orientation == Stacked) {
+            result["currentIndex"] = currentIndex();
+        }
+        return result;
+    }
+    
+    /**
+     * 比例列表规范化：非正数/非有限值按平均值处理，抬高到 MinChildShare，总和归一为 1
+     */
+    static QList<qreal> normalizedSizes(const QList<qreal>& sizes) {
+        QList<qreal> result = sizes;
+        if (result.isEmpty()) return result;
         
-        // 递归序列化子节点
-        if (m_firstChild) result["first"] = m_firstChild->toVariant();
-        if (m_secondChild) result["second"] = m_secondChild->toVariant();
+        const double fallback = 1.0 / double(result.size());
+        double total = 0.0;
+        for (qreal& size : result) {
+            if (!qIsFinite(size) || size <= 0.0) size = fallback;
+            total += size;
+        }
+        for (qreal& size : result) {
+            size = qMax(MinChildShare, size / total);
+        }
         
+        total = 0.0;
+        for (qreal size : result) total += size;
+        for (qreal& size : result) size /= total;
         return result;
     }
     
 signals:
     void orientationChanged();  // 方向改变信号
-    void splitRatioChanged();   // 比例改变信号（重要：触发界面重新布局）
+    void splitRatioChanged();   // 比例改变信号（与 sizesChanged 同时发送）
+    void sizesChanged();        // 子节点比例改变信号（重要：触发界面重新布局）
+    void previewSizesChanged(); // 预览比例改变信号（拖动期间每帧最多一次）
+    void resizingChanged();     // 拖动开始/结束信号
     void childrenChanged();     // 子节点改变信号
+    void currentIndexChanged(); // 当前标签改变信号（子节点变化时也会发送）
+    
+protected:
+    void emitDeferredSignals(quint32 pending) override {
+        SplitPanelNode::emitDeferredSignals(pending);
+        countSignals(((pending & OrientationSignal) ? 1 : 0) + ((pending & ChildrenSignal) ? 1 : 0));
+        if (pending & OrientationSignal) emit orientationChanged();
+        if (pending & SplitRatioSignal) emitSizesSignals();
+        if (pending & ChildrenSignal) emit childrenChanged();
+        if (pending & CurrentIndexSignal) emit currentIndexChanged();
+    }
     
 private:
-    Orientation m_orientation;   // 排列方向（Horizontal 或 Vertical）
-    qreal m_splitRatio = 0.5;    // 分割比例（默认 50%）
+    /**
+     * 比较两组比例（逐项模糊比较）
+     */
+    static bool sameSizes(const QList<qreal>& a, const QList<qreal>& b) {
+        if (a.size() != b.size()) return false;
+        for (qsizetype i = 0; i < a.size(); ++i) {
+            if (!qFuzzyCompare(1.0 + a[i], 1.0 + b[i])) return false;
+        }
+        return true;
+    }
+    
+    /**
+     * 写入已规范化的比例
+     */
+    bool applySizes(const QList<qreal>& sizes) {
+        if (sameSizes(m_sizes, sizes)) return false;
+        m_sizes = sizes;
+        notifySizesChanged();
+        return true;
+    }
+    
+    /**
+     * 接管子节点（Qt 父对象用于内存管理，m_parentNode 用于 parentContainer()）
+     */
+    void adopt(SplitPanelNode* node) {
+        node->setParent(this);
+        node->m_parentNode = this;
+    }
+    
+    /**
+     * 发送子节点改变信号（批量修改期间合并为一次）
+     */
+    void notifyChildrenChanged() {
+        touchRevision();
+        if (!deferSignal(ChildrenSignal)) {
+            countSignals(1);
+            emit childrenChanged();
+        }
+        // 子节点增删可能改变当前标签的索引（只有标签页容器关心）
+        if (m_orientation == Stacked) {
+            notifyCurrentIndexChanged();
+        }
+    }
+    
+    /**
+     * 发送当前标签改变信号（批量修改期间合并为一次）
+     */
+    void notifyCurrentIndexChanged() {
+        if (!deferSignal(CurrentIndexSignal)) {
+            countSignals(1);
+            emit currentIndexChanged();
+        }
+    }
+    
+    /**
+     * 发送比例改变信号（批量修改期间合并为一次）
+     */
+    void notifySizesChanged() {
+        touchRevision();
+        if (!deferSignal(SplitRatioSignal)) emitSizesSignals();
+    }
+    
+    void emitSizesSignals() {
+        countSignals(m_resizing ? 2 : 3);
+        emit splitRatioChanged();
+        emit sizesChanged();
+        if (!m_resizing) emit previewSizesChanged();
+    }
+    
+    /**
+     * 按容器统计发出的信号数（SplitProfiler 未开启时只有一次原子读取）
+     */
+    void countSignals(int count) const {
+        SPLITPANEL_PROFILE_NODE_SIGNALS(nodeId(), count);
+    }
+    
+    Orientation m_orientation;    // 排列方向（Horizontal / Vertical / Stacked）
+    QList<qreal> m_sizes;         // 子节点比例（与 m_children 一一对应）
+    qreal m_initialRatio = 0.5;   // 子节点少于 2 个时预设的 splitRatio
+    QList<qreal> m_previewSizes;  // 拖动中的预览比例（不序列化）
+    bool m_resizing = false;      // 是否正在实时拖动
+    const SplitPanelNode* m_currentChild = nullptr;  // 当前标签（只用于比较，取下时清空）
+    int m_currentHint = 0;        // 当前标签被取下后的回退位置
     
     // 智能指针管理子节点（自动释放内存）
-    std::unique_ptr<SplitPanelNode> m_firstChild;   // 第一个子节点
-    std::unique_ptr<SplitPanelNode> m_secondChild;  // 第二个子节点
+    std::vector<std::unique_ptr<SplitPanelNode>> m_children;
 };
 
-#endif // DOCKING_NODE_HPP
+inline ContainerNode* SplitPanelNode::parentContainer() const
+{
+    return static_cast<ContainerNode*>(m_parentNode);
+}
 
+#endif // DOCKING_NODE_HPP
@@ -0,0 +1,116 @@
+#include "SplitPanelTypeRegistry.hpp"
+#include "../utils/Logger.hpp"
+
+// ============================================================================
+// 注册
+// ============================================================================
+
+SplitPanelType SplitPanelTypeRegistry::registerType(const QString& key, const QString& qmlSource,
+                                                    const QString& defaultTitle, double defaultMinSize)
+{
+    if (key.isEmpty()) {
+        LOG_WARNING("SplitPanelTypeRegistry", "Panel type key must not be empty", {
+            {"qmlSource", qmlSource}
+        });
+        return SplitPanelType();
+    }
+
+    auto* data = new SplitPanelTypeData();
+    data->key = key;
+    data->qmlSource = qmlSource;
+    data->defaultTitle = defaultTitle;
+    data->defaultMinSize = defaultMinSize;
+    SplitPanelType type(data);
+
+    const SplitPanelType previous = m_types.value(key);
+    if (previous) {
+        LOG_WARNING("SplitPanelTypeRegistry", "Panel type re-registered", {
+            {"key", key},
+            {"qmlSource", qmlSource}
+        });
+        if (m_bySource.value(previous->qmlSource) == previous) {
+            m_bySource.remove(previous->qmlSource);
+        }
+    } else {
+        m_order.append(key);
+    }
+
+    m_types.insert(key, type);
+    m_unresolved.remove(key);
+
+    // 已注册类型优先于同路径的匿名类型；多个类型共用一个路径时保留先注册的
+    const SplitPanelType existing = m_bySource.value(qmlSource);
+    if (!qmlSource.isEmpty() && !isRegistered(existing)) {
+        m_bySource.insert(qmlSource, type);
+    }
+
+    LOG_DEBUG("SplitPanelTypeRegistry", "Panel type registered", {
+        {"key", key},
+        {"qmlSource", qmlSource}
+    });
+    return type;
+}
+
+SplitPanelType SplitPanelTypeRegistry::makeAnonymous(const QString& qmlSource)
+{
+    if (qmlSource.isEmpty()) {
+        return SplitPanelType();
+    }
+
+    auto* data = new SplitPanelTypeData();
+    data->qmlSource = qmlSource;
+    return SplitPanelType(data);
+}
+
+// ============================================================================
+// 查找
+// ============================================================================
+
+SplitPanelType SplitPanelTypeRegistry::typeForSource(const QString& qmlSource)
+{
+    if (qmlSource.isEmpty()) {
+        return SplitPanelType();
+    }
+
+    auto it = m_bySource.constFind(qmlSource);
+    if (it != m_bySource.constEnd()) {
+        return it.value();
+    }
+
+    // 驻留匿名类型：同一路径的面板共享一份 qmlSource
+    SplitPanelType type = makeAnonymous(qmlSource);
+    m_bySource.insert(qmlSource, type);
+    return type;
+}
+
+SplitPanelType SplitPanelTypeRegistry::resolve(const QString& typeOrSource)
+{
+    if (SplitPanelType registered = m_types.value(typeOrSource)) {
+        return registered;
+    }
+    return typeForSource(typeOrSource);
+}
+
+SplitPanelType SplitPanelTypeRegistry::resolve(const QString& key, const QString& qmlSource)
+{
+    if (!key.isEmpty()) {
+        if (SplitPanelType registered = m_types.value(key)) {
+            return registered;
+        }
+
+        // 未注册的类型键原样保留（保存时写回），避免类型注册晚于加载时丢失信息
+        SplitPanelType& placeholder = m_unresolved[key];
+        if (!placeholder) {
+            LOG_WARNING("SplitPanelTypeRegistry", "Unknown panel type in layout", {
+                {"key", key},
+                {"qmlSource", qmlSource}
+            });
+            auto* data = new SplitPanelTypeData();
+            data->key = key;
+            data->qmlSource = qmlSource;
+            placeholder = SplitPanelType(data);
+        }
+        return placeholder;
+    }
+    return typeForSource(qmlSource);
+}
@@ -0,0 +1,104 @@
+#ifndef SPLIT_PANEL_TYPE_REGISTRY_HPP
+#define SPLIT_PANEL_TYPE_REGISTRY_HPP
+
+#include <QExplicitlySharedDataPointer>
+#include <QHash>
+#include <QSharedData>
+#include <QString>
+#include <QStringList>
+
+/**
+ * 面板类型（不可变，多个面板节点共享同一份数据）
+ */
+struct SplitPanelTypeData : public QSharedData {
+    QString key;               // 类型键（如 "content"），匿名类型为空
+    QString qmlSource;         // QML 内容文件路径
+    QString defaultTitle;      // 新建面板的默认标题（为空时使用调用方给出的标题）
+    double defaultMinSize = 0; // 新建面板的默认最小尺寸（0 = 使用 SplitManager::minPanelSize）
+};
+
+/**
+ * 面板类型句柄：一个引用计数指针，拷贝不复制任何字符串
+ * 空句柄表示"没有内容"（qmlSource 为空）
+ */
+using SplitPanelType = QExplicitlySharedDataPointer<const SplitPanelTypeData>;
+
+/**
+ * ============================================================================
+ * SplitPanelTypeRegistry - 面板类型注册表
+ * ============================================================================
+ *
+ * 作用：
+ *   把面板内容（qmlSource）及默认标题/最小尺寸登记为命名类型，
+ *   PanelNode 只持有类型句柄，同类面板共享同一份字符串
+ *
+ * 类型来源：
+ *   - 已注册类型：registerType() 登记，布局文件中写 panelType 键
+ *   - 匿名类型：未注册的 qmlSource 按路径驻留（同一路径只有一份），
+ *     布局文件中仍写 qmlSource
+ *   旧布局（2.0）只有 qmlSource，加载时若路径与某个已注册类型相同则归入该类型
+ *
+ * 注意：
+ *   类型数据不可变；重复注册同一个键会替换注册表中的条目，
+ *   已存在的节点继续持有旧数据，因此类型应在加载布局之前注册
+ *   只在 GUI 线程使用（与 SplitManager 一致）
+ */
+class SplitPanelTypeRegistry {
+public:
+    /**
+     * 注册面板类型
+     * 参数：
+     *   key - 类型键（非空）
+     *   qmlSource - QML 内容文件路径
+     *   defaultTitle - 默认标题
+     *   defaultMinSize - 默认最小尺寸（0 = 使用全局最小面板尺寸）
+     * 返回：类型句柄（key 为空时返回空句柄）
+     */
+    SplitPanelType registerType(const QString& key, const QString& qmlSource,
+                                const QString& defaultTitle = QString(), double defaultMinSize = 0);
+
+    /**
+     * 按类型键查找已注册类型（不存在时返回空句柄）
+     */
+    SplitPanelType type(const QString& key) const { return m_types.value(key); }
+
+    /**
+     * 按内容路径取得类型：优先返回 qmlSource 相同的已注册类型，否则驻留为匿名类型
+     */
+    SplitPanelType typeForSource(const QString& qmlSource);
+
+    /**
+     * 解析调用方给出的字符串：已注册的类型键优先，否则当作 qmlSource
+     * 用于 addPanel(panelId, title, qmlSourceOrType)
+     */
+    SplitPanelType resolve(const QString& typeOrSource);
+
+    /**
+     * 解析布局文件中的面板：有 panelType 时使用该类型，否则按 qmlSource 取得类型
+     * 未注册的 panelType 驻留为占位类型（保留键，保存时原样写回）
+     */
+    SplitPanelType resolve(const QString& key, const QString& qmlSource);
+
+    /**
+     * 已注册的类型键（按注册顺序）
+     */
+    QStringList keys() const { return m_order; }
+
+    /**
+     * 句柄是否为已注册类型（布局文件写 panelType 而不是 qmlSource）
+     */
+    static bool isRegistered(const SplitPanelType& type) { return type && !type->key.isEmpty(); }
+
+    /**
+     * 创建不驻留的匿名类型（供没有注册表的 PanelNode::setQmlSource 使用）
+     */
+    static SplitPanelType makeAnonymous(const QString& qmlSource);
+
+private:
+    QHash<QString, SplitPanelType> m_types;     // 类型键 → 已注册类型
+    QHash<QString, SplitPanelType> m_bySource;  // qmlSource → 类型（已注册优先，其次匿名）
+    QHash<QString, SplitPanelType> m_unresolved; // 布局中出现但未注册的类型键 → 占位类型
+    QStringList m_order;                        // 注册顺序
+};
+
+#endif // SPLIT_PANEL_TYPE_REGISTRY_HPP
@@ -1,6 +1,5 @@
 #include "SplitTreeModel.hpp"
 #include "../utils/Logger.hpp"
-#include <QDebug>
 #include <algorithm>
 
 // ============================================================================
@@ -9,18 +8,11 @@
 
 SplitTreeModel::SplitTreeModel(QObject* parent)
     : QAbstractItemModel(parent)
+    , m_top(std::make_unique<Entry>())
 {
-    LOG_INFO("SplitTreeModel", "Tree model initialized");
 }
 
-void SplitTreeModel::setMinPanelSize(double size)
-{
-    double validated = qBound(50.0, size, 1000.0);
-    if (!qFuzzyCompare(m_minPanelSize, validated)) {
-        m_minPanelSize = validated;
-        emit minPanelSizeChanged();
-    }
-}
+SplitTreeModel::~SplitTreeModel() = default;
 
 // ============================================================================
 // QAbstractItemModel 接口实现
@@ -28,18 +20,14 @@ void SplitTreeModel::setMinPanelSize(double size)
 
 QModelIndex SplitTreeModel::index(int row, int column, const QModelIndex& parent) const
 {
-    if (!hasIndex(row, column, parent))
+    if (column != 0 || row < 0)
         return QModelIndex();
     
-    TreeNode* parentNode = parent.isValid() ? getNode(parent) : m_root.get();
-    if (!parentNode)
+    const Entry* parentEntry = entryOf(parent);
+    if (row >= int(parentEntry->children.size()))
         return QModelIndex();
     
-    TreeNode* childNode = parentNode->child(row);
-    if (childNode)
-        return createIndex(row, column, childNode);
-    
-    return QModelIndex();
+    return createIndex(row, column, parentEntry->children[size_t(row)].get());
 }
 
 QModelIndex SplitTreeModel::parent(const QModelIndex& child) const
@@ -47,15 +35,7 @@ QModelIndex SplitTreeModel::parent(const QModelIndex& child) const
     if (!child.isValid())
         return QModelIndex();
     
-    TreeNode* childNode = getNode(child);
-    if (!childNode || !childNode->parent)
-        return QModelIndex();
-    
-    TreeNode* parentNode = childNode->parent;
-    if (parentNode == m_root.get())
-        return QModelIndex();
-    
-    return createIndex(parentNode->row(), 0, parentNode);
+    return indexOf(entryOf(child)->parent);
 }
 
 int SplitTreeModel::rowCount(const QModelIndex& parent) const
@@ -63,8 +43,7 @@ int SplitTreeModel::rowCount(const QModelIndex& parent) const
     if (parent.column() > 0)
         return 0;
     
-    TreeNode* parentNode = parent.isValid() ? getNode(parent) : m_root.get();
-    return parentNode ? parentNode->childCount() : 0;
+    return int(entryOf(parent)->children.size());
 }
 
 int SplitTreeModel::columnCount(const QModelIndex& parent) const
@@ -73,46 +52,66 @@ int SplitTreeModel::columnCount(const QModelIndex& parent) const
     return 1;  // 单列树
 }
 
+bool SplitTreeModel::hasChildren(const QModelIndex& parent) const
+{
+    return rowCount(parent) > 0;
+}
+
 QVariant SplitTreeModel::data(const QModelIndex& index, int role) const
 {
     if (!index.isValid())
         return QVariant();
     
-    TreeNode* node = getNode(index);
+    // 已销毁但尚未同步的节点：行还在，没有数据
+    const Entry* entry = entryOf(index);
+    SplitPanelNode* node = entry->node;
     if (!node)
         return QVariant();
     
+    const bool isPanel = node->nodeType() == SplitPanelNode::Panel;
+    const auto* panel = isPanel ? static_cast<const PanelNode*>(node) : nullptr;
+    const auto* container = isPanel ? nullptr : static_cast<const ContainerNode*>(node);
+    
     switch (role) {
     case Qt::DisplayRole:
-        return node->type == SplitTreeModel::NodeType::Panel ? node->title : QString("Split[%1]").arg(node->id);
-        
+        return panel ? panel->title() : QString("Split[%1]").arg(node->nodeId());
+    
     case NodeTypeRole:
-        return static_cast<int>(node->type);
-        
+        return static_cast<int>(node->nodeType());
+    
     case NodeIdRole:
-        return node->id;
-        
+        return node->nodeId();
+    
+    case NodeRole:
+        return QVariant::fromValue(node);
+    
     case TitleRole:
-        return node->type == SplitTreeModel::NodeType::Panel ? node->title : QString();
-        
+        return panel ? panel->title() : QString();
+    
     case QmlSourceRole:
-        return node->type == SplitTreeModel::NodeType::Panel ? node->qmlSource : QString();
-        
-    case CanCloseRole:
-        return node->type == SplitTreeModel::NodeType::Panel ? node->canClose : false;
-        
+        return panel ? panel->qmlSource() : QString();
+    
+    case PanelTypeRole:
+        return panel ? panel->panelType() : QString();
+    
+    case HibernatedRole:
+        return panel ? panel->hibernated() : false;
+    
     case OrientationRole:
-        return node->type == SplitTreeModel::NodeType::Split ? static_cast<int>(node->orientation) : -1;
-        
+        return container ? static_cast<int>(container->orientation()) : -1;
+    
+    case SizesRole:
+        return container ? QVariant::fromValue(container->sizes()) : QVariant();
+    
     case SplitRatioRole:
-        return node->type == SplitTreeModel::NodeType::Split ? node->splitRatio : 0.5;
-        
+        return container ? container->splitRatio() : 0.5;
+    
     case MinSizeRole:
-        return node->minSize;
-        
+        return node->minSize();
+    
     case HasChildrenRole:
-        return node->childCount() > 0;
-        
+        return !entry->children.empty();
+    
     default:
         return QVariant();
     }
@@ -120,59 +119,16 @@ QVariant SplitTreeModel::data(const QModelIndex& index, int role) const
 
 bool SplitTreeModel::setData(const QModelIndex& index, const QVariant& value, int role)
 {
-    if (!index.isValid())
+    if (!index.isValid() || (role != TitleRole && role != Qt::EditRole))
         return false;
     
-    TreeNode* node = getNode(index);
-    if (!node)
+    // 只有面板标题可编辑；修改直接写入节点，dataChanged 由 titleChanged 触发
+    SplitPanelNode* node = entryOf(index)->node;
+    if (!node || node->nodeType() != SplitPanelNode::Panel)
         return false;
     
-    bool changed = false;
-    
-    switch (role) {
-    case TitleRole:
-        if (node->type == SplitTreeModel::NodeType::Panel) {
-            node->title = value.toString();
-            changed = true;
-        }
-        break;
-        
-    case QmlSourceRole:
-        if (node->type == SplitTreeModel::NodeType::Panel) {
-            node->qmlSource = value.toString();
-            changed = true;
-        }
-        break;
-        
-    case CanCloseRole:
-        if (node->type == SplitTreeModel::NodeType::Panel) {
-            node->canClose = value.toBool();
-            changed = true;
-        }
-        break;
-        
-    case SplitRatioRole:
-        if (node->type == SplitTreeModel::NodeType::Split) {
-            node->splitRatio = qBound(0.1, value.toDouble(), 0.9);
-            changed = true;
-        }
-        break;
-        
-    case MinSizeRole:
-        node->minSize = qBound(50.0, value.toDouble(), 1000.0);
-        changed = true;
-        break;
-        
-    default:
-        break;
-    }
-    
-    if (changed) {
-        emit dataChanged(index, index, {role});
-        return true;
-    }
-    
-    return false;
+    static_cast<PanelNode*>(node)->setTitle(value.toString());
+    return true;
 }
 
 Qt::ItemFlags SplitTreeModel::flags(const QModelIndex& index) const
@@ -180,7 +136,13 @@ Qt::ItemFlags SplitTreeModel::flags(const QModelIndex& index) const
     if (!index.isValid())
         return Qt::NoItemFlags;
     
-    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsEditable;
+    const SplitPanelNode* node = entryOf(index)->node;
+    Qt::ItemFlags result = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    if (node && node->nodeType() == SplitPanelNode::Panel)
+        result |= Qt::ItemIsEditable;
+    if (!hasChildren(index))
+        result |= Qt::ItemNeverHasChildren;
+    return result;
 }
 
 QHash<int, QByteArray> SplitTreeModel::roleNames() const
@@ -189,10 +151,13 @@ QHash<int, QByteArray> SplitTreeModel::roleNames() const
     roles[Qt::DisplayRole] = "display";
     roles[NodeTypeRole] = "nodeType";
     roles[NodeIdRole] = "nodeId";
+    roles[NodeRole] = "node";
     roles[TitleRole] = "title";
     roles[QmlSourceRole] = "qmlSource";
-    roles[CanCloseRole] = "canClose";
+    roles[PanelTypeRole] = "panelType";
+    roles[HibernatedRole] = "hibernated";
     roles[OrientationRole] = "orientation";
+    roles[SizesRole] = "sizes";
     roles[SplitRatioRole] = "splitRatio";
     roles[MinSizeRole] = "minSize";
     roles[HasChildrenRole] = "hasChildren";
@@ -200,587 +165,342 @@ QHash<int, QByteArray> SplitTreeModel::roleNames() const
 }
 
 // ============================================================================
-// 面板管理操作
+// 数据源
 // ============================================================================
 
-bool SplitTreeModel::addPanel(const QString& panelId, const QString& title, const QString& qmlSource)
+void SplitTreeModel::setManager(SplitManager* manager)
 {
-    if (panelId.isEmpty()) {
-        LOG_ERROR("SplitTreeModel", "Panel ID cannot be empty");
-        return false;
-    }
-    
-    // 检查面板是否已存在
-    if (findNodeById(m_root.get(), panelId)) {
-        LOG_ERROR("SplitTreeModel", "Panel already exists");
-        return false;
-    }
+    if (m_manager == manager)
+        return;
     
-    auto panel = createPanelNode(panelId, title, qmlSource);
+    if (m_manager)
+        QObject::disconnect(m_manager, nullptr, this, nullptr);
     
-    // 如果没有根节点，直接设置为根
-    if (!m_root) {
-        beginResetModel();
-        m_root = std::move(panel);
-        endResetModel();
-        
-        updatePanelCount();
-        emit rootChanged();
-        emit panelAdded(panelId);
-        emit layoutChanged();
-        
-        LOG_INFO("SplitTreeModel", "Panel set as root");
-        return true;
+    m_manager = manager;
+    if (m_manager) {
+        connect(m_manager, &SplitManager::rootNodeChanged, this, &SplitTreeModel::markRootDirty);
+        connect(m_manager, &QObject::destroyed, this, &SplitTreeModel::resetModel);
     }
     
-    // 查找最右侧的面板作为目标
-    TreeNode* target = findRightmostPanel(m_root.get());
-    if (!target)
-        target = m_root.get();
-    
-    // 默认停靠到底部
-    return insertPanelAt(std::move(panel), target, DropZone::Bottom);
+    resetModel();
+    emit managerChanged();
 }
 
-bool SplitTreeModel::addPanelAt(const QString& panelId, const QString& title, const QString& qmlSource,
-                                   const QString& targetId, int dropZone)
+QModelIndex SplitTreeModel::findNodeIndex(const QString& nodeId) const
 {
-    if (panelId.isEmpty()) {
-        LOG_ERROR("SplitTreeModel", "Panel ID cannot be empty");
-        return false;
-    }
-    
-    // 检查面板是否已存在
-    if (findNodeById(m_root.get(), panelId)) {
-        LOG_ERROR("SplitTreeModel", "Panel already exists");
-        return false;
-    }
-    
-    auto panel = createPanelNode(panelId, title, qmlSource);
-    
-    // 如果没有根节点，直接设置为根
-    if (!m_root) {
-        beginResetModel();
-        m_root = std::move(panel);
-        endResetModel();
-        
-        updatePanelCount();
-        emit rootChanged();
-        emit panelAdded(panelId);
-        emit layoutChanged();
-        
-        return true;
-    }
-    
-    // 查找目标节点
-    TreeNode* target = findNodeById(m_root.get(), targetId);
-    if (!target)
-        target = m_root.get();
-    
-    return insertPanelAt(std::move(panel), target, static_cast<DropZone>(dropZone));
+    return m_manager ? indexForNode(m_manager->findNode(nodeId)) : QModelIndex();
 }
 
-bool SplitTreeModel::removePanel(const QString& panelId)
+QModelIndex SplitTreeModel::indexForNode(const SplitPanelNode* node) const
 {
-    TreeNode* node = findNodeById(m_root.get(), panelId);
-    if (!node || node->type != SplitTreeModel::NodeType::Panel) {
-        LOG_ERROR("SplitTreeModel", "Panel not found");
-        return false;
-    }
-    
-    // 如果是根节点
-    if (node == m_root.get()) {
-        beginResetModel();
-        m_root.reset();
-        endResetModel();
-        
-        updatePanelCount();
-        emit rootChanged();
-        emit panelRemoved(panelId);
-        emit layoutChanged();
-        
-        return true;
-    }
-    
-    // 获取父节点
-    TreeNode* parent = node->parent;
-    if (!parent || parent->type != SplitTreeModel::NodeType::Split) {
-        LOG_ERROR("SplitTreeModel", "Invalid parent node");
-        return false;
-    }
-    
-    // 获取兄弟节点
-    std::unique_ptr<TreeNode> sibling;
-    if (parent->firstChild.get() == node) {
-        sibling = std::move(parent->secondChild);
-    } else {
-        sibling = std::move(parent->firstChild);
-    }
-    
-    // 移除当前节点
-    if (parent->firstChild.get() == node) {
-        parent->firstChild.reset();
-    } else {
-        parent->secondChild.reset();
-    }
-    
-    // 如果父节点是根节点
-    if (parent == m_root.get()) {
-        beginResetModel();
-        if (sibling) {
-            sibling->parent = nullptr;
-            m_root = std::move(sibling);
-        } else {
-            m_root.reset();
-        }
-        endResetModel();
-    } else {
-        // 父节点不是根节点，需要用兄弟节点替换父节点
-        TreeNode* grandParent = parent->parent;
-        if (grandParent && sibling) {
-            beginResetModel();
-            sibling->parent = grandParent;
-            
-            if (grandParent->firstChild.get() == parent) {
-                grandParent->firstChild = std::move(sibling);
-            } else {
-                grandParent->secondChild = std::move(sibling);
-            }
-            endResetModel();
-        }
-    }
-    
-    updatePanelCount();
-    emit panelRemoved(panelId);
-    emit layoutChanged();
-    
-    return true;
+    return node ? indexOf(m_entries.value(node)) : QModelIndex();
 }
 
-QModelIndex SplitTreeModel::findPanelIndex(const QString& panelId) const
+// ============================================================================
+// 增量同步
+// ============================================================================
+
+void SplitTreeModel::markDirty(SplitPanelNode* container)
 {
-    TreeNode* node = findNodeById(m_root.get(), panelId);
-    if (!node)
-        return QModelIndex();
-    
-    return createIndexForNode(node);
+    m_dirty.insert(container);
+    scheduleSync();
 }
 
-bool SplitTreeModel::updateSplitRatio(const QString& containerId, double ratio)
+void SplitTreeModel::markRootDirty()
 {
-    TreeNode* node = findNodeById(m_root.get(), containerId);
-    if (!node || node->type != SplitTreeModel::NodeType::Split) {
-        return false;
-    }
-    
-    QModelIndex idx = createIndexForNode(node);
-    return setData(idx, ratio, SplitRatioRole);
+    m_rootDirty = true;
+    scheduleSync();
 }
 
-void SplitTreeModel::clear()
+void SplitTreeModel::scheduleSync()
 {
-    if (!m_root)
+    // 一次修改（尤其是批量修改）会触发多个容器的 childrenChanged，合并到事件循环中处理
+    if (m_syncScheduled)
         return;
-    
-    beginResetModel();
-    m_root.reset();
-    endResetModel();
-    
-    updatePanelCount();
-    emit rootChanged();
-    emit layoutChanged();
+    m_syncScheduled = true;
+    QMetaObject::invokeMethod(this, &SplitTreeModel::sync, Qt::QueuedConnection);
 }
 
-// ============================================================================
-// 布局序列化
-// ============================================================================
-
-QVariantMap SplitTreeModel::saveLayout() const
+void SplitTreeModel::sync()
 {
-    QVariantMap layout;
-    layout["version"] = "2.0";  // 新版本标识
-    layout["model"] = "DockingTreeModel";
-    layout["minPanelSize"] = m_minPanelSize;
+    m_syncScheduled = false;
+    if (m_dirty.isEmpty() && !m_rootDirty)
+        return;
     
-    if (m_root) {
-        layout["root"] = m_root->toVariantMap();
+    // 先处理靠近根的容器：被整棵移除的子树不必再逐个同步
+    QVector<QPair<int, const QObject*>> pending;
+    pending.reserve(m_dirty.size() + 1);
+    if (m_rootDirty)
+        pending.append({0, nullptr});
+    for (const QObject* node : std::as_const(m_dirty)) {
+        int depth = 1;
+        for (const Entry* entry = m_entries.value(node); entry && entry->parent; entry = entry->parent) {
+            ++depth;
+        }
+        pending.append({depth, node});
+    }
+    m_dirty.clear();
+    m_rootDirty = false;
+    std::sort(pending.begin(), pending.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    
+    for (const auto& item : std::as_const(pending)) {
+        // 前面的同步可能已经释放了这个容器的骨架
+        Entry* entry = item.second ? m_entries.value(item.second) : m_top.get();
+        if (!entry)
+            continue;
+        if (!syncChildren(entry)) {
+            LOG_WARNING("SplitTreeModel", "Tree changed beyond incremental update, resetting model");
+            resetModel();
+            return;
+        }
     }
-    
-    return layout;
 }
 
-bool SplitTreeModel::loadLayout(const QVariantMap& layout)
+bool SplitTreeModel::syncChildren(Entry* entry)
 {
-    if (layout.isEmpty()) {
-        LOG_ERROR("SplitTreeModel", "Layout data is empty");
-        return false;
-    }
-    
-    QString version = layout.value("version").toString();
-    if (version != "2.0") {
-        LOG_ERROR("SplitTreeModel", "Unsupported layout version");
-        return false;
-    }
-    
-    beginResetModel();
-    m_root.reset();
-    
-    if (layout.contains("minPanelSize")) {
-        m_minPanelSize = layout.value("minPanelSize").toDouble();
-    }
+    const QVector<SplitPanelNode*> live = liveChildren(entry);
+    const QSet<const SplitPanelNode*> liveSet(live.cbegin(), live.cend());
     
-    if (layout.contains("root")) {
-        QVariantMap rootData = layout.value("root").toMap();
-        m_root = loadNodeFromVariant(rootData, nullptr);
+    // 1. 删除：已销毁或不再属于此容器的行（连续的行合并为一次）
+    auto isStale = [&](int row) {
+        const Entry* child = entry->children[size_t(row)].get();
+        return !child->node || !liveSet.contains(child->node);
+    };
+    for (int last = int(entry->children.size()) - 1; last >= 0; --last) {
+        if (!isStale(last))
+            continue;
+        int first = last;
+        while (first > 0 && isStale(first - 1)) {
+            --first;
+        }
+        removeEntries(entry, first, last);
+        last = first;
+    }
+    
+    // 2. 移动和插入：此时剩下的行都在 live 中，逐位对齐
+    for (int i = 0; i < live.size(); ++i) {
+        if (i < int(entry->children.size()) && entry->children[size_t(i)]->node == live[i])
+            continue;
+        
+        Entry* existing = m_entries.value(live[i]);
+        if (existing && existing->parent == entry) {
+            const int from = existing->row;
+            const QModelIndex parentIndex = indexOf(entry);
+            beginMoveRows(parentIndex, from, from, parentIndex, i);
+            std::unique_ptr<Entry> moved = std::move(entry->children[size_t(from)]);
+            entry->children.erase(entry->children.begin() + from);
+            entry->children.insert(entry->children.begin() + i, std::move(moved));
+            renumber(entry, i);
+            endMoveRows();
+            continue;
+        }
+        
+        // 连续的新行一次插入
+        int count = 1;
+        while (i + count < live.size()) {
+            const Entry* next = m_entries.value(live[i + count]);
+            if (next && next->parent == entry)
+                break;
+            ++count;
+        }
+        
+        // 新子树中已在骨架其他位置出现的节点（从别的容器移来）先从原位置移除
+        QVector<SplitPanelNode*> stack(live.cbegin() + i, live.cbegin() + i + count);
+        while (!stack.isEmpty()) {
+            SplitPanelNode* node = stack.takeLast();
+            if (!detachExisting(node, entry))
+                return false;
+            if (node->nodeType() == SplitPanelNode::Container) {
+                const auto* container = static_cast<const ContainerNode*>(node);
+                for (int c = 0; c < container->childCount(); ++c) {
+                    stack.append(container->child(c));
+                }
+            }
+        }
+        
+        beginInsertRows(indexOf(entry), i, i + count - 1);
+        for (int c = 0; c < count; ++c) {
+            entry->children.insert(entry->children.begin() + i + c, buildEntry(live[i + c], entry));
+        }
+        renumber(entry, i);
+        endInsertRows();
+        i += count - 1;
     }
     
-    endResetModel();
-    
-    updatePanelCount();
-    emit rootChanged();
-    emit minPanelSizeChanged();
-    emit layoutChanged();
-    
-    LOG_INFO("SplitTreeModel", "Layout loaded successfully");
-    return true;
-}
-
-// ============================================================================
-// 调试辅助
-// ============================================================================
-
-QString SplitTreeModel::dumpTree() const
-{
-    if (!m_root)
-        return "Empty tree";
-    
-    return dumpNode(m_root.get(), 0);
+    return int(entry->children.size()) == live.size();
 }
 
-QVariantList SplitTreeModel::getFlatPanelList() const
+QVector<SplitPanelNode*> SplitTreeModel::liveChildren(const Entry* entry) const
 {
-    QVariantList panels;
-    collectPanels(m_root.get(), panels);
-    return panels;
-}
-
-// ============================================================================
-// TreeNode 序列化
-// ============================================================================
-
-QVariantMap SplitTreeModel::TreeNode::toVariantMap() const
-{
-    QVariantMap map;
-    
-    if (type == SplitTreeModel::NodeType::Panel) {
-        map["type"] = "panel";
-        map["id"] = id;
-        map["title"] = title;
-        map["qmlSource"] = qmlSource;
-        map["canClose"] = canClose;
-        map["minSize"] = minSize;
-    } else {
-        map["type"] = "split";
-        map["id"] = id;
-        map["orientation"] = (orientation == Orientation::Horizontal) ? "horizontal" : "vertical";
-        map["splitRatio"] = splitRatio;
-        map["minSize"] = minSize;
-        
-        if (firstChild)
-            map["firstChild"] = firstChild->toVariantMap();
-        if (secondChild)
-            map["secondChild"] = secondChild->toVariantMap();
+    QVector<SplitPanelNode*> result;
+    if (entry == m_top.get()) {
+        if (m_manager && m_manager->rootNode())
+            result.append(m_manager->rootNode());
+        return result;
     }
     
-    return map;
+    if (!entry->node || entry->node->nodeType() != SplitPanelNode::Container)
+        return result;
+    
+    const auto* container = static_cast<const ContainerNode*>(entry->node);
+    result.reserve(container->childCount());
+    for (int i = 0; i < container->childCount(); ++i) {
+        result.append(container->child(i));
+    }
+    return result;
 }
 
-// ============================================================================
-// 辅助方法实现
-// ============================================================================
-
-SplitTreeModel::TreeNode* SplitTreeModel::getNode(const QModelIndex& index) const
+bool SplitTreeModel::detachExisting(SplitPanelNode* node, const Entry* target)
 {
-    if (index.isValid()) {
-        return static_cast<TreeNode*>(index.internalPointer());
+    Entry* existing = m_entries.value(node);
+    if (!existing)
+        return true;
+    
+    for (const Entry* ancestor = target; ancestor; ancestor = ancestor->parent) {
+        if (ancestor == existing)
+            return false;
     }
-    return nullptr;
+    removeEntries(existing->parent, existing->row, existing->row);
+    return true;
 }
 
-QModelIndex SplitTreeModel::createIndexForNode(TreeNode* node) const
+void SplitTreeModel::removeEntries(Entry* entry, int first, int last)
 {
-    if (!node || node == m_root.get())
-        return QModelIndex();
-    
-    return createIndex(node->row(), 0, node);
+    beginRemoveRows(indexOf(entry), first, last);
+    for (int row = first; row <= last; ++row) {
+        releaseEntry(entry->children[size_t(row)].get());
+    }
+    entry->children.erase(entry->children.begin() + first, entry->children.begin() + last + 1);
+    renumber(entry, first);
+    endRemoveRows();
 }
 
-SplitTreeModel::TreeNode* SplitTreeModel::findNodeById(TreeNode* node, const QString& nodeId) const
+void SplitTreeModel::renumber(Entry* entry, int from)
 {
-    if (!node || nodeId.isEmpty())
-        return nullptr;
-    
-    if (node->id == nodeId)
-        return node;
-    
-    if (node->type == SplitTreeModel::NodeType::Split) {
-        if (auto* found = findNodeById(node->firstChild.get(), nodeId))
-            return found;
-        if (auto* found = findNodeById(node->secondChild.get(), nodeId))
-            return found;
+    for (size_t row = size_t(from); row < entry->children.size(); ++row) {
+        entry->children[row]->row = int(row);
     }
-    
-    return nullptr;
 }
 
-SplitTreeModel::TreeNode* SplitTreeModel::findRightmostPanel(TreeNode* node) const
+void SplitTreeModel::resetModel()
 {
-    if (!node)
-        return nullptr;
-    
-    if (node->type == SplitTreeModel::NodeType::Panel)
-        return node;
-    
-    // 优先查找右侧/底部
-    if (node->secondChild) {
-        if (auto* panel = findRightmostPanel(node->secondChild.get()))
-            return panel;
+    beginResetModel();
+    for (const auto& child : m_top->children) {
+        releaseEntry(child.get());
     }
-    
-    if (node->firstChild) {
-        return findRightmostPanel(node->firstChild.get());
+    m_top->children.clear();
+    m_dirty.clear();
+    m_rootDirty = false;
+    if (m_manager && m_manager->rootNode()) {
+        m_top->children.push_back(buildEntry(m_manager->rootNode(), m_top.get()));
     }
-    
-    return nullptr;
+    endResetModel();
 }
 
-std::unique_ptr<SplitTreeModel::TreeNode> SplitTreeModel::createPanelNode(
-    const QString& panelId, const QString& title, const QString& qmlSource)
-{
-    auto node = std::make_unique<TreeNode>(SplitTreeModel::NodeType::Panel, panelId);
-    node->title = title;
-    node->qmlSource = qmlSource;
-    node->canClose = true;
-    node->minSize = m_minPanelSize;
-    return node;
-}
+// ============================================================================
+// 骨架构建与节点信号
+// ============================================================================
 
-std::unique_ptr<SplitTreeModel::TreeNode> SplitTreeModel::createSplitNode(
-    const QString& nodeId, Orientation orientation)
+std::unique_ptr<SplitTreeModel::Entry> SplitTreeModel::buildEntry(SplitPanelNode* node, Entry* parent)
 {
-    auto node = std::make_unique<TreeNode>(SplitTreeModel::NodeType::Split, nodeId);
-    node->orientation = orientation;
-    node->splitRatio = 0.5;
-    node->minSize = m_minPanelSize;
-    return node;
+    auto entry = std::make_unique<Entry>();
+    entry->node = node;
+    entry->parent = parent;
+    m_entries.insert(node, entry.get());
+    connectNode(node);
+    
+    if (node->nodeType() == SplitPanelNode::Container) {
+        const auto* container = static_cast<const ContainerNode*>(node);
+        entry->children.reserve(size_t(container->childCount()));
+        for (int i = 0; i < container->childCount(); ++i) {
+            entry->children.push_back(buildEntry(container->child(i), entry.get()));
+            entry->children.back()->row = i;
+        }
+    }
+    return entry;
 }
 
-bool SplitTreeModel::insertPanelAt(std::unique_ptr<TreeNode> panel, TreeNode* targetNode, DropZone zone)
+void SplitTreeModel::releaseEntry(Entry* entry)
 {
-    if (!panel || !targetNode) {
-        LOG_ERROR("SplitTreeModel", "Invalid panel or target node");
-        return false;
+    if (entry->node) {
+        m_entries.remove(entry->node);
+        QObject::disconnect(entry->node, nullptr, this, nullptr);
     }
-    
-    // 确定分割方向
-    Orientation orientation;
-    bool reverseOrder = false;
-    
-    switch (zone) {
-    case DropZone::Left:
-        orientation = Orientation::Vertical;
-        reverseOrder = true;
-        break;
-    case DropZone::Right:
-        orientation = Orientation::Vertical;
-        reverseOrder = false;
-        break;
-    case DropZone::Top:
-        orientation = Orientation::Horizontal;
-        reverseOrder = true;
-        break;
-    case DropZone::Bottom:
-        orientation = Orientation::Horizontal;
-        reverseOrder = false;
-        break;
-    default:
-        LOG_ERROR("SplitTreeModel", "Invalid drop zone");
-        return false;
+    for (const auto& child : entry->children) {
+        releaseEntry(child.get());
     }
-    
-    // 创建新的分割容器
-    QString splitId = generateNodeId();
-    auto container = createSplitNode(splitId, orientation);
-    
-    beginResetModel();
-    
-    // 如果目标是根节点
-    if (targetNode == m_root.get()) {
-        auto oldRoot = std::move(m_root);
-        oldRoot->parent = container.get();
-        panel->parent = container.get();
-        
-        if (reverseOrder) {
-            container->firstChild = std::move(panel);
-            container->secondChild = std::move(oldRoot);
-        } else {
-            container->firstChild = std::move(oldRoot);
-            container->secondChild = std::move(panel);
-        }
-        
-        m_root = std::move(container);
-    } else {
-        // 目标不是根节点
-        TreeNode* parent = targetNode->parent;
-        if (!parent) {
-            endResetModel();
-            LOG_ERROR("SplitTreeModel", "Target node has no parent");
-            return false;
-        }
-        
-        container->parent = parent;
-        panel->parent = container.get();
-        
-        std::unique_ptr<TreeNode> targetOwnership;
-        if (parent->firstChild.get() == targetNode) {
-            targetOwnership = std::move(parent->firstChild);
-        } else {
-            targetOwnership = std::move(parent->secondChild);
-        }
-        
-        targetOwnership->parent = container.get();
-        
-        if (reverseOrder) {
-            container->firstChild = std::move(panel);
-            container->secondChild = std::move(targetOwnership);
-        } else {
-            container->firstChild = std::move(targetOwnership);
-            container->secondChild = std::move(panel);
-        }
-        
-        if (parent->firstChild.get() == nullptr) {
-            parent->firstChild = std::move(container);
-        } else {
-            parent->secondChild = std::move(container);
-        }
-    }
-    
-    endResetModel();
-    
-    updatePanelCount();
-    emit panelAdded(panel->id);
-    emit layoutChanged();
-    
-    return true;
 }
 
-std::unique_ptr<SplitTreeModel::TreeNode> SplitTreeModel::loadNodeFromVariant(
-    const QVariantMap& data, TreeNode* parent)
+void SplitTreeModel::connectNode(SplitPanelNode* node)
 {
-    QString type = data.value("type").toString();
-    QString id = data.value("id").toString();
-    
-    if (type == "panel") {
-        auto node = std::make_unique<TreeNode>(SplitTreeModel::NodeType::Panel, id, parent);
-        node->title = data.value("title").toString();
-        node->qmlSource = data.value("qmlSource").toString();
-        node->canClose = data.value("canClose", true).toBool();
-        node->minSize = data.value("minSize", m_minPanelSize).toDouble();
-        return node;
-    }
+    connect(node, &QObject::destroyed, this, &SplitTreeModel::onNodeDestroyed);
+    connect(node, &SplitPanelNode::minSizeChanged, this, [this, node]() {
+        emitDataChanged(node, {MinSizeRole});
+    });
     
-    if (type == "split") {
-        QString orientationStr = data.value("orientation").toString();
-        Orientation orientation = (orientationStr == "horizontal") 
-            ? Orientation::Horizontal 
-            : Orientation::Vertical;
-        
-        auto node = std::make_unique<TreeNode>(SplitTreeModel::NodeType::Split, id, parent);
-        node->orientation = orientation;
-        node->splitRatio = data.value("splitRatio", 0.5).toDouble();
-        node->minSize = data.value("minSize", m_minPanelSize).toDouble();
-        
-        if (data.contains("firstChild")) {
-            node->firstChild = loadNodeFromVariant(data.value("firstChild").toMap(), node.get());
-        }
-        
-        if (data.contains("secondChild")) {
-            node->secondChild = loadNodeFromVariant(data.value("secondChild").toMap(), node.get());
-        }
-        
-        return node;
+    if (node->nodeType() == SplitPanelNode::Panel) {
+        auto* panel = static_cast<PanelNode*>(node);
+        connect(panel, &PanelNode::titleChanged, this, [this, node]() {
+            emitDataChanged(node, {Qt::DisplayRole, TitleRole});
+        });
+        connect(panel, &PanelNode::qmlSourceChanged, this, [this, node]() {
+            emitDataChanged(node, {QmlSourceRole, PanelTypeRole});
+        });
+        connect(panel, &PanelNode::hibernatedChanged, this, [this, node]() {
+            emitDataChanged(node, {HibernatedRole});
+        });
+        return;
     }
     
-    return nullptr;
+    auto* container = static_cast<ContainerNode*>(node);
+    connect(container, &ContainerNode::childrenChanged, this, [this, node]() {
+        markDirty(node);
+    });
+    connect(container, &ContainerNode::orientationChanged, this, [this, node]() {
+        emitDataChanged(node, {OrientationRole});
+    });
+    connect(container, &ContainerNode::sizesChanged, this, [this, node]() {
+        emitDataChanged(node, {SizesRole, SplitRatioRole});
+    });
 }
 
-QString SplitTreeModel::generateNodeId()
+void SplitTreeModel::emitDataChanged(const SplitPanelNode* node, const QList<int>& roles)
 {
-    return QString("node_%1").arg(++m_nodeIdCounter);
+    const QModelIndex index = indexForNode(node);
+    if (index.isValid())
+        emit dataChanged(index, index, roles);
 }
 
-void SplitTreeModel::updatePanelCount()
+void SplitTreeModel::onNodeDestroyed(QObject* object)
 {
-    int oldCount = m_panelCount;
-    m_panelCount = countPanels(m_root.get());
+    // 节点正在析构：只用指针做键，不再访问节点
+    // 行保留到所在容器同步时移除（容器随后会发送 childrenChanged，这里再标记一次以防万一）
+    Entry* entry = m_entries.take(object);
+    if (!entry)
+        return;
     
-    if (oldCount != m_panelCount) {
-        emit panelCountChanged();
+    entry->node = nullptr;
+    m_dirty.remove(object);
+    if (entry->parent == m_top.get()) {
+        markRootDirty();
+    } else if (entry->parent && entry->parent->node) {
+        markDirty(entry->parent->node);
     }
 }
 
-int SplitTreeModel::countPanels(TreeNode* node) const
-{
-    if (!node)
-        return 0;
-    
-    if (node->type == SplitTreeModel::NodeType::Panel)
-        return 1;
-    
-    return countPanels(node->firstChild.get()) + countPanels(node->secondChild.get());
-}
+// ============================================================================
+// 辅助方法
+// ============================================================================
 
-QString SplitTreeModel::dumpNode(TreeNode* node, int indent) const
+SplitTreeModel::Entry* SplitTreeModel::entryOf(const QModelIndex& index) const
 {
-    if (!node)
-        return "";
-    
-    QString result;
-    QString indentStr = QString("  ").repeated(indent);
-    
-    if (node->type == SplitTreeModel::NodeType::Panel) {
-        result = QString("%1Panel[%2]: %3\n").arg(indentStr).arg(node->id).arg(node->title);
-    } else {
-        QString orientStr = (node->orientation == Orientation::Horizontal) ? "H" : "V";
-        result = QString("%1Split[%2] %3 (%.2f):\n")
-            .arg(indentStr)
-            .arg(node->id)
-            .arg(orientStr)
-            .arg(node->splitRatio);
-        
-        if (node->firstChild)
-            result += dumpNode(node->firstChild.get(), indent + 1);
-        if (node->secondChild)
-            result += dumpNode(node->secondChild.get(), indent + 1);
-    }
-    
-    return result;
+    return index.isValid() ? static_cast<Entry*>(index.internalPointer()) : m_top.get();
 }
 
-void SplitTreeModel::collectPanels(TreeNode* node, QVariantList& panels) const
+QModelIndex SplitTreeModel::indexOf(const Entry* entry) const
 {
-    if (!node)
-        return;
-    
-    if (node->type == SplitTreeModel::NodeType::Panel) {
-        QVariantMap panelData;
-        panelData["id"] = node->id;
-        panelData["title"] = node->title;
-        panelData["qmlSource"] = node->qmlSource;
-        panels.append(panelData);
-    } else {
-        collectPanels(node->firstChild.get(), panels);
-        collectPanels(node->secondChild.get(), panels);
-    }
+    if (!entry || entry == m_top.get())
+        return QModelIndex();
+    return createIndex(entry->row, 0, const_cast<Entry*>(entry));
 }
-
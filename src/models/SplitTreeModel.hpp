@@ -2,80 +2,67 @@
 #define SPLIT_TREE_MODEL_HPP
 
 #include <QAbstractItemModel>
-#include <QtQml/qqmlregistration.h>
+#include <QHash>
+#include <QPointer>
+#include <QSet>
 #include <QString>
-#include <QVariantMap>
 #include <memory>
 #include <vector>
+#include "SplitManager.hpp"
 
 /**
- * 停靠系统树形模型 - 使用QAbstractItemModel架构
- * 
- * 优点：
- * 1. 标准Qt MVC架构
- * 2. 自动内存管理（智能指针）
- * 3. 信号自动通知视图更新
- * 4. 易于测试和调试
+ * ============================================================================
+ * SplitTreeModel - SplitManager 节点树的 QAbstractItemModel 适配器
+ * ============================================================================
+ *
+ * 作用：
+ *   给大纲视图、面板列表（TreeView / ListView）提供标准 Qt 模型接口，
+ *   数据直接读取 SplitManager 中的活节点，不复制面板或容器的属性
+ *
+ * 结构：
+ *   模型只维护一份指针骨架（每个节点一个 Entry：节点指针、父 Entry、子 Entry 列表），
+ *   rowCount/index/parent 按骨架回答，data() 读活节点
+ *   顶层只有一行：根节点（树为空时没有行）
+ *
+ * 增量更新：
+ *   - 属性变化（标题、内容、方向、比例、最小尺寸、休眠）→ 立即发送 dataChanged
+ *   - 结构变化（容器 childrenChanged、根节点替换、节点销毁）→ 标记容器，
+ *     在事件循环中统一对比骨架和活节点的子节点列表，
+ *     发送 rowsRemoved / rowsMoved / rowsInserted，不重置模型
+ *   - 只有更换 manager 或骨架无法按行对齐时（节点被移到自己的后代之下）才重置
+ *
+ * 使用：
+ *   SplitTreeModel { manager: splitManager }
+ *   C++ 中立即同步：model.sync()
  */
 class SplitTreeModel : public QAbstractItemModel
 {
     Q_OBJECT
-    QML_ELEMENT
-    
-    Q_PROPERTY(int panelCount READ panelCount NOTIFY panelCountChanged)
-    Q_PROPERTY(bool hasRoot READ hasRoot NOTIFY rootChanged)
-    Q_PROPERTY(double minPanelSize READ minPanelSize WRITE setMinPanelSize NOTIFY minPanelSizeChanged)
     
+    Q_PROPERTY(SplitManager* manager READ manager WRITE setManager NOTIFY managerChanged)
+
 public:
-    /**
-     * 节点类型枚举
-     */
-    enum class NodeType {
-        Panel,      // 面板节点（叶节点）
-        Split       // 分割容器节点（分支节点）
-    };
-    Q_ENUM(NodeType)
-    
-    /**
-     * 分割方向枚举
-     */
-    enum class Orientation {
-        Horizontal,  // 水平分割（上下）
-        Vertical     // 垂直分割（左右）
-    };
-    Q_ENUM(Orientation)
-    
-    /**
-     * 停靠位置枚举
-     */
-    enum class DropZone {
-        None,
-        Left,
-        Right,
-        Top,
-        Bottom,
-        Center
-    };
-    Q_ENUM(DropZone)
-    
     /**
      * 数据角色
      */
     enum DataRole {
-        NodeTypeRole = Qt::UserRole + 1,  // 节点类型
+        NodeTypeRole = Qt::UserRole + 1,  // 节点类型（SplitPanelNode::NodeType）
         NodeIdRole,                        // 节点ID
-        TitleRole,                         // 标题（仅面板）
+        NodeRole,                          // 节点对象（SplitPanelNode*）
+        TitleRole,                         // 标题（仅面板，可编辑）
         QmlSourceRole,                     // QML源文件路径（仅面板）
-        CanCloseRole,                      // 是否可关闭（仅面板）
+        PanelTypeRole,                     // 已注册的面板类型键（仅面板）
+        HibernatedRole,                    // 是否休眠（仅面板）
         OrientationRole,                   // 分割方向（仅容器）
-        SplitRatioRole,                    // 分割比例（仅容器）
+        SizesRole,                         // 子节点比例（仅容器）
+        SplitRatioRole,                    // 第一个子节点的比例（仅容器）
         MinSizeRole,                       // 最小尺寸
         HasChildrenRole                    // 是否有子节点
     };
     Q_ENUM(DataRole)
     
     explicit SplitTreeModel(QObject* parent = nullptr);
-    ~SplitTreeModel() override = default;
+    ~SplitTreeModel() override;
     
     // ========================================
     // QAbstractItemModel 接口实现
@@ -85,183 +72,95 @@ public:
     QModelIndex parent(const QModelIndex& child) const override;
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
     Qt::ItemFlags flags(const QModelIndex& index) const override;
     QHash<int, QByteArray> roleNames() const override;
     
     // ========================================
-    // 公开属性访问器
+    // 数据源
     // ========================================
     
-    int panelCount() const { return m_panelCount; }
-    bool hasRoot() const { return m_root != nullptr; }
-    double minPanelSize() const { return m_minPanelSize; }
-    void setMinPanelSize(double size);
-    
-    // ========================================
-    // 面板管理操作
-    // ========================================
+    SplitManager* manager() const { return m_manager; }
+    void setManager(SplitManager* manager);
     
     /**
-     * 添加面板（自动选择位置）
+     * 按节点 ID 查找索引（O(1)，不存在返回无效索引）
      */
-    Q_INVOKABLE bool addPanel(const QString& panelId, const QString& title, const QString& qmlSource = "");
+    Q_INVOKABLE QModelIndex findNodeIndex(const QString& nodeId) const;
     
     /**
-     * 在指定位置添加面板
+     * 节点对应的索引（C++ 接口）
      */
-    Q_INVOKABLE bool addPanelAt(const QString& panelId, const QString& title, const QString& qmlSource,
-                                 const QString& targetId, int dropZone);
+    QModelIndex indexForNode(const SplitPanelNode* node) const;
     
     /**
-     * 移除面板
+     * 立即处理积压的结构变化（通常由事件循环自动调用）
      */
-    Q_INVOKABLE bool removePanel(const QString& panelId);
-    
+    void sync();
+
+signals:
+    void managerChanged();
+
+private:
     /**
-     * 查找面板节点的QModelIndex
+     * 骨架节点：只保存指针和行号，属性一律从 node 读取
+     * 节点销毁后 node 置空，该行保留到下一次同步时移除
      */
-    Q_INVOKABLE QModelIndex findPanelIndex(const QString& panelId) const;
+    struct Entry {
+        SplitPanelNode* node = nullptr;
+        Entry* parent = nullptr;
+        int row = 0;
+        std::vector<std::unique_ptr<Entry>> children;
+    };
+    
+    Entry* entryOf(const QModelIndex& index) const;
+    QModelIndex indexOf(const Entry* entry) const;
     
     /**
-     * 更新分割比例
+     * 骨架的子节点列表对齐到活节点（发送行删除/移动/插入信号）
+     * 返回：false 表示无法按行对齐，需要重置
      */
-    Q_INVOKABLE bool updateSplitRatio(const QString& containerId, double ratio);
+    bool syncChildren(Entry* entry);
     
     /**
-     * 清空所有节点
+     * 活节点的子节点列表（顶层为根节点）
      */
-    Q_INVOKABLE void clear();
-    
-    // ========================================
-    // 布局序列化
-    // ========================================
-    
-    Q_INVOKABLE QVariantMap saveLayout() const;
-    Q_INVOKABLE bool loadLayout(const QVariantMap& layout);
+    QVector<SplitPanelNode*> liveChildren(const Entry* entry) const;
     
-    // ========================================
-    // 调试辅助
-    // ========================================
-    
-    Q_INVOKABLE QString dumpTree() const;
-    Q_INVOKABLE QVariantList getFlatPanelList() const;
-    
-signals:
-    void panelCountChanged();
-    void rootChanged();
-    void minPanelSizeChanged();
-    void panelAdded(const QString& panelId);
-    void panelRemoved(const QString& panelId);
-    void layoutChanged();
-    
-private:
     /**
-     * 树节点结构 - 使用智能指针自动管理内存
+     * 为活节点子树创建骨架并连接节点信号
      */
-    struct TreeNode {
-        NodeType type;
-        QString id;
-        TreeNode* parent = nullptr;  // 不拥有所有权，仅引用
-        
-        // 面板节点属性
-        QString title;
-        QString qmlSource;
-        bool canClose = true;
-        
-        // 容器节点属性
-        Orientation orientation = Orientation::Horizontal;
-        double splitRatio = 0.5;
-        std::unique_ptr<TreeNode> firstChild;
-        std::unique_ptr<TreeNode> secondChild;
-        
-        // 通用属性
-        double minSize = 150.0;
-        
-        explicit TreeNode(NodeType t, const QString& nodeId, TreeNode* p = nullptr)
-            : type(t), id(nodeId), parent(p) {}
-        
-        ~TreeNode() = default;
-        
-        // 禁止拷贝
-        TreeNode(const TreeNode&) = delete;
-        TreeNode& operator=(const TreeNode&) = delete;
-        
-        // 允许移动
-        TreeNode(TreeNode&&) = default;
-        TreeNode& operator=(TreeNode&&) = default;
-        
-        /**
-         * 获取子节点数量
-         */
-        int childCount() const {
-            if (type == NodeType::Panel) return 0;
-            int count = 0;
-            if (firstChild) count++;
-            if (secondChild) count++;
-            return count;
-        }
-        
-        /**
-         * 获取第n个子节点
-         */
-        TreeNode* child(int n) const {
-            if (type == NodeType::Panel) return nullptr;
-            if (n == 0 && firstChild) return firstChild.get();
-            if (n == 1 && secondChild) return secondChild.get();
-            return nullptr;
-        }
-        
-        /**
-         * 获取当前节点在父节点中的行号
-         */
-        int row() const {
-            if (!parent) return 0;
-            if (parent->firstChild.get() == this) return 0;
-            if (parent->secondChild.get() == this) return 1;
-            return 0;
-        }
-        
-        /**
-         * 序列化为QVariantMap
-         */
-        QVariantMap toVariantMap() const;
-    };
-    
-    // ========================================
-    // 辅助方法
-    // ========================================
+    std::unique_ptr<Entry> buildEntry(SplitPanelNode* node, Entry* parent);
     
-    TreeNode* getNode(const QModelIndex& index) const;
-    QModelIndex createIndexForNode(TreeNode* node) const;
-    TreeNode* findNodeById(TreeNode* node, const QString& nodeId) const;
-    TreeNode* findRightmostPanel(TreeNode* node) const;
-    
-    std::unique_ptr<TreeNode> createPanelNode(const QString& panelId, const QString& title, const QString& qmlSource);
-    std::unique_ptr<TreeNode> createSplitNode(const QString& nodeId, Orientation orientation);
-    
-    bool insertPanelAt(std::unique_ptr<TreeNode> panel, TreeNode* targetNode, DropZone zone);
-    std::unique_ptr<TreeNode> removeNode(TreeNode* node);
-    
-    std::unique_ptr<TreeNode> loadNodeFromVariant(const QVariantMap& data, TreeNode* parent);
-    QString generateNodeId();
-    
-    void updatePanelCount();
-    int countPanels(TreeNode* node) const;
-    
-    QString dumpNode(TreeNode* node, int indent = 0) const;
-    void collectPanels(TreeNode* node, QVariantList& panels) const;
-    
-    // ========================================
-    // 成员变量
-    // ========================================
+    /**
+     * 释放骨架子树（断开信号、移出查找表）
+     */
+    void releaseEntry(Entry* entry);
     
-    std::unique_ptr<TreeNode> m_root;
-    int m_panelCount = 0;
-    double m_minPanelSize = 150.0;
-    int m_nodeIdCounter = 0;
+    /**
+     * 把骨架中已有的节点从原位置移除（节点被移动到别的容器时）
+     * 返回：false 表示该节点是 target 自身或其祖先
+     */
+    bool detachExisting(SplitPanelNode* node, const Entry* target);
+    
+    void removeEntries(Entry* entry, int first, int last);
+    void renumber(Entry* entry, int from);
+    void connectNode(SplitPanelNode* node);
+    void emitDataChanged(const SplitPanelNode* node, const QList<int>& roles);
+    void onNodeDestroyed(QObject* object);
+    void markDirty(SplitPanelNode* container);
+    void markRootDirty();
+    void scheduleSync();
+    void resetModel();
+    
+    QPointer<SplitManager> m_manager;
+    std::unique_ptr<Entry> m_top;                       // 虚拟顶层（node 为空，子节点为根节点）
+    QHash<const QObject*, Entry*> m_entries;            // 活节点 → 骨架
+    QSet<const QObject*> m_dirty;                       // 子节点列表待同步的容器
+    bool m_rootDirty = false;
+    bool m_syncScheduled = false;
 };
 
-#endif // DOCKING_TREE_MODEL_HPP
-
+#endif // SPLIT_TREE_MODEL_HPP
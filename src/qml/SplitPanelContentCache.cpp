@@ -0,0 +1,335 @@
+/**
+ * @file SplitPanelContentCache.cpp
+ * @brief 面板内容组件缓存与异步实例化实现
+ */
+
+#include "SplitPanelContentCache.hpp"
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QQmlIncubator>
+#include <QQuickItem>
+#include <QStringList>
+#include "utils/Logger.hpp"
+#include "utils/SplitFrameScheduler.hpp"
+
+namespace {
+
+QString errorsToString(const QList<QQmlError>& errors)
+{
+    QStringList messages;
+    for (const QQmlError& error : errors) {
+        messages.append(error.toString());
+    }
+    return messages.join('\n');
+}
+
+} // namespace
+
+// ============================================================================
+// 请求与孵化器
+// ============================================================================
+
+/**
+ * 一个宿主的内容请求
+ * 由 shared_ptr 持有：孵化器回调中完成的请求延迟到事件循环中释放，
+ * 避免在 QQmlIncubator::statusChanged() 内部销毁孵化器自身
+ */
+struct SplitPanelContentCache::Request {
+    QQuickItem* key = nullptr;                    // m_requests 中的键（宿主销毁后仍用于查找）
+    QPointer<QQuickItem> host;                    // 宿主（销毁后为空）
+    QUrl source;
+    QVariantMap initialProperties;
+    double priority = 0.0;
+    quint64 sequence = 0;
+    QMetaObject::Connection hostDestroyed;
+    std::unique_ptr<ContentIncubator> incubator;  // 开始孵化后非空
+};
+
+class SplitPanelContentCache::ContentIncubator : public QQmlIncubator
+{
+public:
+    ContentIncubator(SplitPanelContentCache* cache, Request* request)
+        : QQmlIncubator(QQmlIncubator::Asynchronous), m_cache(cache), m_request(request) {}
+
+protected:
+    /**
+     * 在绑定求值之前设置初始属性并挂到宿主上（anchors.fill: parent 等绑定可以立即生效）
+     */
+    void setInitialState(QObject* object) override {
+        const QMetaObject* metaObject = object->metaObject();
+        for (auto it = m_request->initialProperties.cbegin(); it != m_request->initialProperties.cend(); ++it) {
+            if (metaObject->indexOfProperty(it.key().toUtf8().constData()) >= 0) {
+                object->setProperty(it.key().toUtf8().constData(), it.value());
+            }
+        }
+
+        if (QQuickItem* host = m_request->host) {
+            object->setParent(host);
+            if (auto* item = qobject_cast<QQuickItem*>(object)) {
+                item->setParentItem(host);
+            }
+        }
+    }
+
+    void statusChanged(Status status) override {
+        if (status == QQmlIncubator::Ready || status == QQmlIncubator::Error) {
+            m_cache->onIncubationFinished(m_request);
+        }
+    }
+
+private:
+    SplitPanelContentCache* m_cache;
+    Request* m_request;
+};
+
+/**
+ * 引擎的增量孵化控制器：有对象在孵化时向调度器提交一个任务，
+ * 每步推进 1 毫秒，直到没有正在孵化的对象
+ */
+class SplitPanelContentCache::IncubationController : public QQmlIncubationController
+{
+public:
+    explicit IncubationController(SplitPanelContentCache* cache) : m_cache(cache) {}
+
+protected:
+    void incubatingObjectCountChanged(int count) override {
+        if (count == 0 || m_posted) return;
+
+        m_posted = true;
+        SplitFrameScheduler::instance()->post(m_cache, [this]() {
+            incubateFor(1);
+            if (incubatingObjectCount() > 0) return false;
+            m_posted = false;
+            return true;
+        }, count);
+    }
+
+private:
+    SplitPanelContentCache* m_cache;
+    bool m_posted = false;  // 调度器中已有孵化任务
+};
+
+// ============================================================================
+// 构造/析构
+// ============================================================================
+
+SplitPanelContentCache::SplitPanelContentCache(QQmlEngine* engine, QObject* parent)
+    : QObject(parent)
+    , m_engine(engine)
+    , m_incubationController(std::make_unique<IncubationController>(this))
+{
+    // 替换窗口安装的控制器：引擎同一时刻只有一个控制器
+    if (m_engine) {
+        m_engine->setIncubationController(m_incubationController.get());
+    }
+}
+
+SplitPanelContentCache::~SplitPanelContentCache()
+{
+    // 孵化器引用本对象，先取消全部请求（正在创建的对象随孵化器一起丢弃）
+    for (const auto& request : std::as_const(m_requests)) {
+        QObject::disconnect(request->hostDestroyed);
+        if (request->incubator) {
+            request->incubator->clear();
+        }
+    }
+    m_requests.clear();
+
+    if (m_engine && m_engine->incubationController() == m_incubationController.get()) {
+        m_engine->setIncubationController(nullptr);
+    }
+}
+
+// ============================================================================
+// 组件缓存
+// ============================================================================
+
+void SplitPanelContentCache::preload(const QList<QUrl>& sources)
+{
+    for (const QUrl& source : sources) {
+        if (source.isValid()) {
+            component(source);
+        }
+    }
+}
+
+bool SplitPanelContentCache::isReady(const QUrl& source) const
+{
+    QQmlComponent* cached = m_components.value(source);
+    return cached && cached->isReady();
+}
+
+QQmlComponent* SplitPanelContentCache::component(const QUrl& source)
+{
+    QQmlComponent*& cached = m_components[source];
+    if (!cached) {
+        // 异步编译：类型加载线程中解析和编译，完成后在 GUI 线程通知
+        cached = new QQmlComponent(m_engine, source, QQmlComponent::Asynchronous, this);
+        QQmlComponent* created = cached;
+        connect(created, &QQmlComponent::statusChanged, this, [this, created]() {
+            onComponentStatusChanged(created);
+        });
+        LOG_DEBUG("SplitPanelContentCache", "Compiling panel content", {
+            {"source", source.toString()}
+        });
+    }
+    return cached;
+}
+
+void SplitPanelContentCache::onComponentStatusChanged(QQmlComponent* component)
+{
+    if (component->isError()) {
+        LOG_ERROR("SplitPanelContentCache", "Failed to compile panel content", {
+            {"source", component->url().toString()},
+            {"error", errorsToString(component->errors())}
+        });
+    }
+    schedule();
+}
+
+// ============================================================================
+// 请求
+// ============================================================================
+
+void SplitPanelContentCache::request(QQuickItem* host, const QUrl& source,
+                                     const QVariantMap& initialProperties, double priority)
+{
+    if (!host) return;
+
+    cancel(host);
+    if (!m_engine || !source.isValid()) {
+        finishWithError(host, QString("Invalid content source: %1").arg(source.toString()));
+        return;
+    }
+
+    auto request = std::make_shared<Request>();
+    request->key = host;
+    request->host = host;
+    request->source = source;
+    request->initialProperties = initialProperties;
+    request->priority = priority;
+    request->sequence = ++m_sequence;
+    request->hostDestroyed = connect(host, &QObject::destroyed, this, [this, host]() {
+        cancel(host);
+    });
+    m_requests.insert(host, request);
+
+    component(source);
+    schedule();
+}
+
+void SplitPanelContentCache::setPriority(QQuickItem* host, double priority)
+{
+    auto it = m_requests.find(host);
+    if (it != m_requests.end()) {
+        it.value()->priority = priority;
+    }
+}
+
+void SplitPanelContentCache::cancel(QQuickItem* host)
+{
+    std::shared_ptr<Request> request = m_requests.take(host);
+    if (!request) return;
+
+    QObject::disconnect(request->hostDestroyed);
+    if (request->incubator) {
+        if (request->incubator->isLoading()) {
+            --m_activeCount;
+        }
+        request->incubator->clear();
+    }
+
+    // 可能在孵化器回调链中被调用（如初始属性触发的 QML 处理函数），延迟释放
+    QMetaObject::invokeMethod(this, [request]() {}, Qt::QueuedConnection);
+    schedule();
+}
+
+// ============================================================================
+// 调度
+// ============================================================================
+
+void SplitPanelContentCache::schedule()
+{
+    while (m_activeCount < MaxActiveIncubations) {
+        // 在组件已编译好的等待请求中选优先级最高的（同优先级先到先得）
+        Request* best = nullptr;
+        QQmlComponent* bestComponent = nullptr;
+        QList<QQuickItem*> failed;
+
+        for (const auto& request : std::as_const(m_requests)) {
+            if (request->incubator) continue;
+
+            QQmlComponent* cached = m_components.value(request->source);
+            if (!cached || cached->isLoading()) continue;
+            if (cached->isError()) {
+                failed.append(request->key);
+                continue;
+            }
+            if (!best || request->priority > best->priority
+                || (request->priority == best->priority && request->sequence < best->sequence)) {
+                best = request.get();
+                bestComponent = cached;
+            }
+        }
+
+        for (QQuickItem* key : std::as_const(failed)) {
+            std::shared_ptr<Request> request = m_requests.take(key);
+            QObject::disconnect(request->hostDestroyed);
+            finishWithError(request->host, errorsToString(m_components.value(request->source)->errors()));
+        }
+
+        if (!best) break;
+        startIncubation(best, bestComponent);
+    }
+}
+
+void SplitPanelContentCache::startIncubation(Request* request, QQmlComponent* component)
+{
+    QQmlContext* context = request->host ? qmlContext(request->host) : nullptr;
+    if (!context && m_engine) {
+        context = m_engine->rootContext();
+    }
+
+    request->incubator = std::make_unique<ContentIncubator>(this, request);
+    ++m_activeCount;
+    component->create(*request->incubator, context);
+}
+
+void SplitPanelContentCache::onIncubationFinished(Request* request)
+{
+    // 先确认表中仍是这个请求：同一宿主的新请求已替换它时（旧请求已在 cancel 中计数），不能取走新请求
+    auto it = m_requests.find(request->key);
+    if (it == m_requests.end() || it.value().get() != request) return;
+
+    // 从表中取出，回调返回后再释放（当前仍处于孵化器的 statusChanged 中）
+    std::shared_ptr<Request> keep = std::move(it.value());
+    m_requests.erase(it);
+    --m_activeCount;
+    QObject::disconnect(request->hostDestroyed);
+    QMetaObject::invokeMethod(this, [keep]() {}, Qt::QueuedConnection);
+
+    ContentIncubator* incubator = request->incubator.get();
+    if (incubator->isReady()) {
+        QObject* object = incubator->object();
+        if (QQuickItem* host = request->host) {
+            QMetaObject::invokeMethod(host, "attachContent", Q_ARG(QVariant, QVariant::fromValue(object)));
+        } else {
+            delete object;  // 宿主在孵化期间被销毁
+        }
+    } else {
+        finishWithError(request->host, errorsToString(incubator->errors()));
+    }
+
+    schedule();
+}
+
+void SplitPanelContentCache::finishWithError(QQuickItem* host, const QString& message)
+{
+    LOG_WARNING("SplitPanelContentCache", "Failed to create panel content", {
+        {"error", message}
+    });
+    if (host) {
+        QMetaObject::invokeMethod(host, "contentFailed", Q_ARG(QVariant, QVariant(message)));
+    }
+}
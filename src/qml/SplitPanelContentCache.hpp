@@ -0,0 +1,110 @@
+#ifndef SPLIT_PANEL_CONTENT_CACHE_HPP
+#define SPLIT_PANEL_CONTENT_CACHE_HPP
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QUrl>
+#include <QVariantMap>
+#include <memory>
+
+class QQmlComponent;
+class QQmlEngine;
+class QQuickItem;
+
+/**
+ * ============================================================================
+ * SplitPanelContentCache - 面板内容组件缓存与异步实例化
+ * ============================================================================
+ *
+ * 作用：
+ *   1. 按 URL 缓存编译好的 QQmlComponent（异步编译），同类面板共用一个组件
+ *   2. 面板内容用 QQmlIncubator 异步实例化，引擎的增量孵化控制器由本对象接管：
+ *      孵化经 SplitFrameScheduler 推进，与节点创建、信号补发共用每片的 frameBudget，
+ *      窗口首帧不必等所有面板内容创建完
+ *   3. 按优先级（可见面积）排队：可见的大面板先创建，
+ *      不可见或很小的面板在之后的帧中陆续填充
+ *
+ * QML 用法（单例 PanelContentCache）：
+ *   Main.qml 预热：异步加载读完布局文件时（SplitManager::layoutContentSourcesRead）
+ *             PanelContentCache.preload(qmlSources.map(Qt.resolvedUrl))
+ *   面板视图：PanelContentCache.request(contentArea, Qt.resolvedUrl(qmlSource), { panelNode: panel }, priority)
+ *             内容就绪后回调宿主的 attachContent(item)，失败回调 contentFailed(message)
+ *             尺寸/可见性变化时 PanelContentCache.setPriority(contentArea, priority)
+ *             视图销毁或换内容时 PanelContentCache.cancel(contentArea)
+ *
+ * 注意：
+ *   - 内容对象的 Qt 父对象和视觉父对象都是宿主，随宿主一起销毁
+ *   - 初始属性只设置内容组件中存在的属性（与原 Loader 版本的 try/catch 行为一致）
+ *   - 同时进行的孵化数量有上限，后到的高优先级请求能插到尚未开始的请求之前
+ */
+class SplitPanelContentCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SplitPanelContentCache(QQmlEngine* engine, QObject* parent = nullptr);
+    ~SplitPanelContentCache() override;
+
+    /**
+     * 同时进行的异步孵化数量上限
+     */
+    static constexpr int MaxActiveIncubations = 4;
+
+    /**
+     * 预先编译组件（异步加载时用布局文件中面板用到的内容组件预热）
+     */
+    Q_INVOKABLE void preload(const QList<QUrl>& sources);
+
+    /**
+     * 组件是否已编译完成
+     */
+    Q_INVOKABLE bool isReady(const QUrl& source) const;
+
+    /**
+     * 请求为宿主创建内容（同一宿主的旧请求会被取消）
+     * 参数：
+     *   host - 内容的父 Item，需提供 attachContent(item) / contentFailed(message) 函数
+     *   source - 内容 QML 文件的绝对 URL（QML 中用 Qt.resolvedUrl）
+     *   initialProperties - 创建时设置的属性（内容组件中不存在的属性会被忽略）
+     *   priority - 优先级，越大越先创建（一般为可见面积，不可见时为 0）
+     */
+    Q_INVOKABLE void request(QQuickItem* host, const QUrl& source,
+                             const QVariantMap& initialProperties, double priority);
+
+    /**
+     * 更新尚未完成的请求的优先级
+     */
+    Q_INVOKABLE void setPriority(QQuickItem* host, double priority);
+
+    /**
+     * 取消宿主的请求（正在孵化的对象会被丢弃）
+     */
+    Q_INVOKABLE void cancel(QQuickItem* host);
+
+    /**
+     * 等待中和正在孵化的请求数量
+     */
+    Q_INVOKABLE int pendingCount() const { return int(m_requests.size()); }
+
+private:
+    class ContentIncubator;
+    class IncubationController;
+    struct Request;
+
+    QQmlComponent* component(const QUrl& source);
+    void onComponentStatusChanged(QQmlComponent* component);
+    void schedule();
+    void startIncubation(Request* request, QQmlComponent* component);
+    void onIncubationFinished(Request* request);
+    void finishWithError(QQuickItem* host, const QString& message);
+
+    QPointer<QQmlEngine> m_engine;
+    QHash<QUrl, QQmlComponent*> m_components;                // URL → 组件（本对象持有）
+    QHash<QQuickItem*, std::shared_ptr<Request>> m_requests; // 宿主 → 请求
+    quint64 m_sequence = 0;                                   // 请求序号（同优先级先到先得）
+    int m_activeCount = 0;                                    // 正在孵化的请求数
+    std::unique_ptr<IncubationController> m_incubationController;  // 安装到引擎上的孵化控制器
+};
+
+#endif // SPLIT_PANEL_CONTENT_CACHE_HPP
@@ -0,0 +1,46 @@
+/**
+ * @file SplitPanelQml.cpp
+ * @brief QML 类型注册实现
+ */
+
+#include "SplitPanelQml.hpp"
+#include "SplitPanelContentCache.hpp"
+#include <QQmlEngine>
+#include "utils/Logger.hpp"
+#include "utils/SplitFrameScheduler.hpp"
+#include "models/SplitLayoutStore.hpp"
+#include "models/SplitManager.hpp"
+#include "models/SplitPanelNode.hpp"
+#include "models/SplitTreeModel.hpp"
+
+namespace SplitPanelQml {
+
+void registerTypes(const char* uri)
+{
+    // Logger 使用进程级单例，QML 引擎不能接管其所有权
+    qmlRegisterSingletonType<Logger>(uri, 1, 0, "Logger",
+        [](QQmlEngine* engine, QJSEngine* scriptEngine) -> QObject* {
+            Q_UNUSED(engine)
+            Q_UNUSED(scriptEngine)
+            QQmlEngine::setObjectOwnership(Logger::instance(), QQmlEngine::CppOwnership);
+            return Logger::instance();
+        });
+    
+    // 内容缓存按引擎创建，由引擎持有
+    qmlRegisterSingletonType<SplitPanelContentCache>(uri, 1, 0, "PanelContentCache",
+        [](QQmlEngine* engine, QJSEngine* scriptEngine) -> QObject* {
+            Q_UNUSED(scriptEngine)
+            return new SplitPanelContentCache(engine);
+        });
+    
+    qmlRegisterType<SplitManager>(uri, 1, 0, "SplitManager");
+    qmlRegisterUncreatableType<SplitPanelNode>(uri, 1, 0, "SplitPanelNode", "Abstract type");
+    // 节点由 SplitManager 创建（内存来自其节点池），QML 中只能使用，不能直接实例化
+    qmlRegisterUncreatableType<PanelNode>(uri, 1, 0, "PanelNode", "Create panels via SplitManager");
+    qmlRegisterUncreatableType<ContainerNode>(uri, 1, 0, "ContainerNode", "Containers are created by SplitManager");
+    qmlRegisterType<SplitTreeModel>(uri, 1, 0, "SplitTreeModel");
+    qmlRegisterUncreatableType<SplitFrameScheduler>(uri, 1, 0, "SplitFrameScheduler", "Use SplitManager.scheduler");
+    qmlRegisterType<SplitLayoutStore>(uri, 1, 0, "SplitLayoutStore");
+}
+
+} // namespace SplitPanelQml
@@ -0,0 +1,36 @@
+#ifndef SPLIT_PANEL_QML_HPP
+#define SPLIT_PANEL_QML_HPP
+
+/**
+ * ============================================================================
+ * SplitPanelQml - QML 类型注册层
+ * ============================================================================
+ *
+ * 作用：
+ *   布局引擎（SplitPanelCore 库）只依赖 Qt6::Core，不包含任何 QML 注册宏
+ *   本层把引擎中的类型注册到 QML 模块，只在 GUI 程序中编译
+ *
+ * 注册的类型（URI 默认为 "SplitPanel" 1.0）：
+ *   - Logger          单例（与 C++ 的 Logger::instance() 为同一对象）
+ *   - PanelContentCache 单例（每个引擎一个，面板内容组件缓存与异步实例化）
+ *   - SplitManager    可创建
+ *   - SplitPanelNode  不可创建（抽象基类）
+ *   - PanelNode / ContainerNode
+ *   - SplitTreeModel  可创建（节点树的 QAbstractItemModel 适配器，设置 manager 后使用）
+ *   - SplitLayoutStore 可创建（布局预设库，open(path) 后使用）
+ *   - SplitFrameScheduler 不可创建（通过 SplitManager.scheduler 访问）
+ *
+ * 使用：
+ *   在加载任何 QML 之前调用 SplitPanelQml::registerTypes()
+ */
+namespace SplitPanelQml {
+
+/**
+ * 注册布局引擎的 QML 类型
+ * 参数：uri - QML 模块 URI
+ */
+void registerTypes(const char* uri = "SplitPanel");
+
+} // namespace SplitPanelQml
+
+#endif // SPLIT_PANEL_QML_HPP
@@ -8,14 +8,15 @@
  * - 文件输出
  * - 时间戳格式化
  * - 上下文信息
+ * - 异步模式 (无锁队列 + 后台写入线程批量写入)
  */
 
 #include "Logger.hpp"
 #include <QDebug>
 #include <QDir>
 #include <QCoreApplication>
-#include <QQmlEngine>
-#include <QJSEngine>
+#include <QThread>
+#include <QMutexLocker>
 
 // 静态成员变量初始化
 Logger* Logger::s_instance = nullptr;
@@ -34,19 +35,6 @@ Logger* Logger::instance()
     return s_instance;
 }
 
-/**
- * @brief QML单例创建方法
- * 
- * 此方法由QML引擎调用以创建Logger单例实例
- * 参数engine和scriptEngine由QML系统传入,这里未使用但必须保留
- */
-Logger* Logger::create(QQmlEngine* engine, QJSEngine* scriptEngine)
-{
-    Q_UNUSED(engine);
-    Q_UNUSED(scriptEngine);
-    return instance();
-}
-
 /**
  * @brief Logger构造函数
  * 
@@ -88,6 +76,9 @@ Logger::Logger(QObject* parent)
  */
 Logger::~Logger()
 {
+    // 先写完异步队列, 再关闭文件
+    setAsyncEnabled(false);
+    
     if (m_logFile.isOpen()) {
         m_logFile.close();
     }
@@ -133,8 +124,8 @@ void Logger::error(const QString& category, const QString& message, const QVaria
  */
 void Logger::setLogLevel(LogLevel level)
 {
-    QMutexLocker locker(&m_mutex);  // 自动加锁/解锁
-    m_logLevel = level;
+    // 原子写入, log() 入口无需加锁即可读取
+    s_logLevel.store(level, std::memory_order_relaxed);
 }
 
 /**
@@ -196,6 +187,185 @@ void Logger::setLogFilePath(const QString& path)
     }
 }
 
+// ========================================
+// 异步模式
+// ========================================
+
+/**
+ * @brief 启用或禁用异步日志
+ * 
+ * 启用: 创建队列 (仅首次) 并启动写入线程
+ * 禁用: 通知写入线程退出, 等它写完队列, 再由当前线程取走退出前最后入队的记录
+ */
+void Logger::setAsyncEnabled(bool enabled)
+{
+    QMutexLocker control(&m_controlMutex);
+    
+    if (enabled) {
+        if (m_writerThread) {
+            return;
+        }
+        if (!m_queue) {
+            // 队列一旦创建便不再释放, 并发的 log() 即使看到旧的启用状态也能安全入队
+            m_queue = std::make_unique<MpscRingBuffer<LogRecord>>(AsyncQueueCapacity);
+        }
+        {
+            QMutexLocker locker(&m_writerMutex);
+            m_writerStopping = false;
+            m_writerWakeupPending = false;
+        }
+        m_writerThread.reset(QThread::create([this]() { writerLoop(); }));
+        m_writerThread->setObjectName("LoggerWriter");
+        m_writerThread->start(QThread::LowPriority);
+        m_asyncEnabled.store(true, std::memory_order_release);
+        return;
+    }
+    
+    if (!m_writerThread) {
+        return;
+    }
+    
+    m_asyncEnabled.store(false);
+    {
+        QMutexLocker locker(&m_writerMutex);
+        m_writerStopping = true;
+        m_writerWakeup.wakeAll();
+    }
+    m_writerThread->wait();
+    m_writerThread.reset();
+    
+    // 在关闭前读到启用状态的生产者可能仍在入队: 等它们全部离开后再取走最后的记录
+    while (m_activeProducers.load() > 0) {
+        QThread::yieldCurrentThread();
+    }
+    
+    // 写入线程已退出, 当前线程成为唯一消费者
+    drainQueue();
+}
+
+void Logger::setFlushInterval(int msec)
+{
+    m_flushIntervalMs.store(qMax(1, msec), std::memory_order_relaxed);
+}
+
+/**
+ * @brief 立即写入已记录的日志
+ * 
+ * 异步模式下记下调用时的入队总数, 唤醒写入线程并等待写入计数追上
+ */
+void Logger::flush()
+{
+    QMutexLocker control(&m_controlMutex);
+    
+    if (m_writerThread) {
+        const quint64 target = m_enqueuedCount.load(std::memory_order_acquire);
+        QMutexLocker locker(&m_writerMutex);
+        while (m_writtenCount.load(std::memory_order_acquire) < target) {
+            m_writerWakeupPending = true;
+            m_writerWakeup.wakeOne();
+            m_batchWritten.wait(&m_writerMutex, m_flushIntervalMs.load(std::memory_order_relaxed));
+        }
+        return;
+    }
+    
+    QMutexLocker locker(&m_mutex);
+    if (m_logFile.isOpen()) {
+        m_logFile.flush();
+    }
+}
+
+/**
+ * @brief 写入线程主循环
+ * 
+ * drainQueue() 一直 tryPop 到失败, 之后最多等待一个刷新间隔; 生产者在队列过半或遇到Error时提前唤醒
+ * 不按 sizeApprox() 判断是否等待: 已占位但尚未发布的槽位会让它大于0而 tryPop 失败, 写入线程会空转
+ * 每写完一批通知等待中的 flush()
+ */
+void Logger::writerLoop()
+{
+    QMutexLocker locker(&m_writerMutex);
+    while (!m_writerStopping) {
+        // 唤醒标志和退出标志都在 m_writerMutex 下检查, 生产者持同一把锁置位后才通知:
+        // 写入期间到达的唤醒不会丢失, 虚假唤醒则回到等待
+        while (!m_writerWakeupPending && !m_writerStopping) {
+            if (!m_writerWakeup.wait(&m_writerMutex, m_flushIntervalMs.load(std::memory_order_relaxed))) {
+                break;  // 超时: 按刷新间隔写一次
+            }
+        }
+        m_writerWakeupPending = false;
+        
+        locker.unlock();
+        drainQueue();
+        locker.relock();
+        
+        m_batchWritten.wakeAll();
+    }
+    
+    // 退出前写完剩余记录
+    locker.unlock();
+    drainQueue();
+    locker.relock();
+    m_batchWritten.wakeAll();
+}
+
+/**
+ * @brief 批量写入队列中的记录
+ * 
+ * 格式化和控制台输出不持有 m_mutex; 每批文件内容只加锁写入一次并刷新一次
+ */
+void Logger::drainQueue()
+{
+    if (!m_queue) {
+        return;
+    }
+    
+    constexpr int MaxBatchSize = 256;
+    LogRecord record;
+    
+    for (;;) {
+        QString batch;
+        int count = 0;
+        
+        while (count < MaxBatchSize && m_queue->tryPop(record)) {
+            const QString logLine = formatRecord(record);
+            writeToConsole(record.level, logLine);
+            batch += logLine;
+            batch += QLatin1Char('\n');
+            ++count;
+        }
+        
+        const quint64 dropped = m_droppedCount.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            LogRecord notice;
+            notice.level = LogLevel::Warning;
+            notice.timestamp = QDateTime::currentMSecsSinceEpoch();
+            notice.category = "Logger";
+            notice.message = QString("Async queue full, %1 log records dropped").arg(dropped);
+            const QString logLine = formatRecord(notice);
+            writeToConsole(notice.level, logLine);
+            batch += logLine;
+            batch += QLatin1Char('\n');
+        }
+        
+        if (!batch.isEmpty()) {
+            QMutexLocker locker(&m_mutex);
+            if (m_fileLoggingEnabled && m_logFile.isOpen()) {
+                m_logFile.write(batch.toUtf8());
+                m_logFile.flush();
+            }
+        }
+        
+        if (count == 0) {
+            break;
+        }
+        m_writtenCount.fetch_add(quint64(count), std::memory_order_release);
+    }
+}
+
+// ========================================
+// 日志记录
+// ========================================
+
 /**
  * @brief 核心日志记录方法
  * 
@@ -205,46 +375,100 @@ void Logger::setLogFilePath(const QString& path)
  * @param context 上下文信息(可选)
  * 
  * 工作流程:
- * 1. 检查日志级别,低于设定级别的直接返回
- * 2. 格式化日志消息 (包含时间戳、级别、分类、消息、上下文)
- * 3. 根据级别输出到控制台 (使用Qt的qDebug/qInfo/qWarning/qCritical)
- * 4. 如果启用了文件日志,写入文件
+ * 1. 检查日志级别 (isLevelEnabled, 不加锁), 低于设定级别的直接返回
+ * 2. 记录时间戳, 组装日志记录
+ * 3. 异步模式: 入队后立即返回, 由写入线程完成后续步骤
+ * 4. 同步模式: 格式化, 加锁输出到控制台和文件
  * 5. 发射信号通知其他组件
  */
 void Logger::log(LogLevel level, const QString& category, const QString& message, const QVariantMap& context)
 {
-    QMutexLocker locker(&m_mutex);  // 线程安全保护
+    // 级别过滤: 低于编译期或运行时最低级别的直接返回 (QML 调用同样受编译期级别约束)
+    if (!isLevelEnabled(level)) {
+        return;
+    }
+    
+    LogRecord record{level, QDateTime::currentMSecsSinceEpoch(), category, message, context};
     
-    // 级别过滤: 如果当前消息级别低于设定的最低级别,直接返回
-    if (level < m_logLevel) {
+    // ========================================
+    // 异步模式: 无锁入队
+    // ========================================
+    // 读取启用状态到入队完成之间计入 m_activeProducers, setAsyncEnabled(false) 等它归零后才做最后一次 drainQueue
+    // (计数和启用状态都用 seq_cst: 要么这里看到已关闭, 要么关闭方看到计数)
+    m_activeProducers.fetch_add(1);
+    const bool async = m_asyncEnabled.load();
+    const bool queued = async && m_queue->tryPush(std::move(record));
+    if (queued) {
+        m_enqueuedCount.fetch_add(1, std::memory_order_release);
+    }
+    m_activeProducers.fetch_sub(1, std::memory_order_release);
+    
+    if (queued) {
+        // 队列过半或出现错误时提前唤醒写入线程 (持 m_writerMutex 置位再通知, 避免丢失唤醒)
+        if (level == LogLevel::Error || m_queue->sizeApprox() >= m_queue->capacity() / 2) {
+            QMutexLocker locker(&m_writerMutex);
+            m_writerWakeupPending = true;
+            m_writerWakeup.wakeOne();
+        }
+        emit logMessageEmitted(level, category, message);
+        return;
+    }
+        
+    // 队列已满: 非Error级别丢弃并计数, Error级别退回同步写入
+    if (async && level != LogLevel::Error) {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
         return;
     }
     
     // ========================================
-    // 格式化日志消息
+    // 同步模式: 格式化并输出
+    // ========================================
+    // tryPush 只在成功时移走记录, 失败时 record 仍然完整
+    const QString logLine = formatRecord(record);
+    
+    {
+        QMutexLocker locker(&m_mutex);  // 保证多线程输出不交错
+        writeToConsole(level, logLine);
+        if (m_fileLoggingEnabled) {
+            writeToFile(logLine);
+        }
+    }
+    
     // ========================================
+    // 发射信号 (供QML或其他C++组件监听)
+    // ========================================
+    emit logMessageEmitted(level, category, message);
+}
+
+/**
+ * @brief 格式化日志记录
+ * 
+ * 最终日志格式: [时间戳] [级别] [分类] 消息 | 上下文
+ * 示例: [2025-10-23 14:18:59.880] [INFO ] [Application] Starting app | version=1.0
+ */
+QString Logger::formatRecord(const LogRecord& record)
+{
     // 时间戳格式: "2025-10-23 14:18:59.880"
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss.zzz");
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(record.timestamp).toString("yyyy-MM-dd HH:mm:ss.zzz");
     
     // 日志级别字符串: "DEBUG", "INFO ", "WARN ", "ERROR"
-    QString levelStr = levelToString(level);
+    QString levelStr = levelToString(record.level);
     
     // 上下文信息格式化: "key1=value1, key2=value2"
-    QString contextStr = formatContext(context);
+    QString contextStr = formatContext(record.context);
     
-    // 最终日志格式: [时间戳] [级别] [分类] 消息 | 上下文
-    // 示例: [2025-10-23 14:18:59.880] [INFO ] [Application] Starting app | version=1.0
-    QString logLine = QString("[%1] [%2] [%3] %4%5")
-                          .arg(timestamp)
-                          .arg(levelStr)
-                          .arg(category)
-                          .arg(message)
-                          .arg(contextStr.isEmpty() ? "" : " | " + contextStr);
-    
-    // ========================================
-    // 输出到控制台
-    // ========================================
-    // 根据不同级别使用不同的Qt日志函数
+    return QString("[%1] [%2] [%3] %4%5")
+        .arg(timestamp, levelStr, record.category, record.message,
+             contextStr.isEmpty() ? QString() : " | " + contextStr);
+}
+
+/**
+ * @brief 输出到控制台
+ * 
+ * 根据不同级别使用不同的Qt日志函数
+ */
+void Logger::writeToConsole(LogLevel level, const QString& logLine)
+{
     switch (level) {
         case LogLevel::Debug:
             qDebug().noquote() << logLine;    // 调试信息 (可能在Release版本被禁用)
@@ -259,18 +483,6 @@ void Logger::log(LogLevel level, const QString& category, const QString& message
             qCritical().noquote() << logLine; // 错误信息
             break;
     }
-    
-    // ========================================
-    // 写入文件 (如果已启用)
-    // ========================================
-    if (m_fileLoggingEnabled) {
-        writeToFile(logLine);
-    }
-    
-    // ========================================
-    // 发射信号 (供QML或其他C++组件监听)
-    // ========================================
-    emit logMessageEmitted(level, category, message);
 }
 
 /**
@@ -278,15 +490,15 @@ void Logger::log(LogLevel level, const QString& category, const QString& message
  * 
  * @param logLine 格式化好的日志行
  * 
- * 使用QTextStream进行文本写入,并立即刷新缓冲区
+ * 同步模式下每行立即刷新缓冲区
  * 确保日志及时写入磁盘,即使程序崩溃也能保留日志
  */
 void Logger::writeToFile(const QString& logLine)
 {
     if (m_logFile.isOpen()) {
-        QTextStream stream(&m_logFile);
-        stream << logLine << "\n";  // 写入日志行并添加换行符
-        stream.flush();              // 立即刷新到文件,不等待缓冲区满
+        m_logFile.write(logLine.toUtf8());
+        m_logFile.write("\n");
+        m_logFile.flush();              // 立即刷新到文件,不等待缓冲区满
     }
 }
 
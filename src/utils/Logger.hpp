@@ -5,14 +5,25 @@
 #include <QString>
 #include <QVariantMap>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QFile>
-#include <QTextStream>
 #include <QDateTime>
-#include <QtQml/qqmlregistration.h>
+#include <atomic>
+#include <memory>
+#include "MpscRingBuffer.hpp"
+
+/**
+ * @brief 编译期最低日志级别
+ * 
+ * 由 CMake 选项 SPLITPANEL_LOG_MIN_LEVEL 设置 (0=Debug, 1=Info, 2=Warning, 3=Error, 4=全部关闭)
+ * 低于此级别的 LOG_* 宏直接编译为空语句, 参数表达式不会出现在二进制中
+ */
+#ifndef SPLITPANEL_LOG_MIN_LEVEL
+#define SPLITPANEL_LOG_MIN_LEVEL 0
+#endif
 
 // Forward declarations
-class QQmlEngine;
-class QJSEngine;
+class QThread;
 
 /**
  * @brief 日志系统类 - 单例模式
@@ -22,7 +33,8 @@ class QJSEngine;
  * - 支持多个日志级别 (Debug, Info, Warning, Error)
  * - 可同时输出到控制台和文件
  * - 线程安全 (使用互斥锁保护)
- * - 支持在QML中使用 (通过QML_ELEMENT和QML_SINGLETON)
+ * - 可选异步模式: 调用方只把日志记录放入无锁队列, 由后台写入线程批量格式化和写文件
+ * - 支持在QML中使用 (由 SplitPanelQml::registerTypes() 注册为QML单例)
  * - 支持上下文信息 (通过QVariantMap传递额外参数)
  * 
  * 使用示例:
@@ -31,12 +43,15 @@ class QJSEngine;
  * 
  * QML:
  *   Logger.info("MyCategory", "Something happened", {key: "value"})
+ * 
+ * 异步模式:
+ *   Logger::instance()->setAsyncEnabled(true);   // 启动写入线程
+ *   Logger::instance()->flush();                 // 崩溃/退出路径: 等待队列写完
+ *   Logger::instance()->setAsyncEnabled(false);  // 写完队列后停止写入线程
  */
 class Logger : public QObject
 {
     Q_OBJECT
-    QML_ELEMENT      // 使此类可在QML中作为类型使用
-    QML_SINGLETON    // 将此类注册为QML单例
     
 public:
     /**
@@ -60,16 +75,6 @@ public:
      */
     static Logger* instance();
     
-    /**
-     * @brief QML单例创建方法
-     * @param engine QML引擎指针
-     * @param scriptEngine JS引擎指针
-     * @return Logger* Logger单例实例
-     * 
-     * 此方法是为了满足QML_SINGLETON的要求而添加的
-     */
-    static Logger* create(QQmlEngine* engine, QJSEngine* scriptEngine);
-    
     // ========================================
     // 日志记录方法 (QML可调用)
     // ========================================
@@ -121,7 +126,19 @@ public:
      * @brief 获取当前日志级别
      * @return LogLevel 当前的日志级别
      */
-    Q_INVOKABLE LogLevel logLevel() const { return m_logLevel; }
+    Q_INVOKABLE LogLevel logLevel() const { return s_logLevel.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief 快速判断某级别是否会被记录 (静态、无锁)
+     * @param level 日志级别
+     * @return bool 同时满足编译期最低级别和运行时级别时返回 true
+     * 
+     * LOG_* 宏在求值任何参数之前调用此方法, 被过滤的日志只花费一次原子读取和一次比较
+     */
+    static bool isLevelEnabled(LogLevel level) {
+        return static_cast<int>(level) >= SPLITPANEL_LOG_MIN_LEVEL
+            && level >= s_logLevel.load(std::memory_order_relaxed);
+    }
     
     /**
      * @brief 启用或禁用文件日志
@@ -147,6 +164,45 @@ public:
      */
     Q_INVOKABLE QString logFilePath() const { return m_logFilePath; }
     
+    // ========================================
+    // 异步模式 (QML可调用)
+    // ========================================
+    
+    /**
+     * @brief 启用或禁用异步日志
+     * @param enabled true=启动后台写入线程, false=写完队列中的记录后停止线程
+     * 
+     * 异步模式下 debug()/info() 等方法只做级别判断和入队 (无锁, 不格式化, 不写文件),
+     * 时间戳在调用时记录, 格式化、控制台输出和文件写入都在写入线程中批量完成
+     * 队列满时丢弃记录并计数 (Error 级别改为同步写入, 保证不丢), 丢弃数量会写入日志
+     */
+    Q_INVOKABLE void setAsyncEnabled(bool enabled);
+    
+    /**
+     * @brief 检查异步日志是否已启用
+     */
+    Q_INVOKABLE bool isAsyncEnabled() const { return m_asyncEnabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief 设置异步模式下的刷新间隔
+     * @param msec 写入线程最长等待时间 (毫秒, 最小1), 即异步日志落盘的最大延迟
+     */
+    Q_INVOKABLE void setFlushInterval(int msec);
+    
+    /**
+     * @brief 获取异步模式下的刷新间隔 (毫秒)
+     */
+    Q_INVOKABLE int flushInterval() const { return m_flushIntervalMs.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief 立即把已记录的日志写入文件
+     * 
+     * 异步模式: 阻塞直到调用前入队的记录全部写入并刷新到文件
+     * 同步模式: 刷新文件缓冲区
+     * 用于崩溃处理和程序退出路径
+     */
+    Q_INVOKABLE void flush();
+    
 signals:
     /**
      * @brief 日志消息发出信号
@@ -179,11 +235,46 @@ private:
     void log(LogLevel level, const QString& category, const QString& message, const QVariantMap& context);
     
     /**
-     * @brief 将日志写入文件
+     * @brief 待写入的日志记录 (异步模式下在队列中传递)
+     */
+    struct LogRecord {
+        LogLevel level{LogLevel::Info};
+        qint64 timestamp{0};        ///< 记录时间 (自纪元起的毫秒数)
+        QString category;
+        QString message;
+        QVariantMap context;
+    };
+    
+    /**
+     * @brief 格式化日志记录为一行文本
+     * @param record 日志记录
+     * @return QString 格式: [时间戳] [级别] [分类] 消息 | 上下文
+     */
+    QString formatRecord(const LogRecord& record);
+    
+    /**
+     * @brief 输出到控制台 (根据级别选择qDebug/qInfo/qWarning/qCritical)
+     * @param level 日志级别
+     * @param logLine 格式化后的日志行
+     */
+    void writeToConsole(LogLevel level, const QString& logLine);
+    
+    /**
+     * @brief 将日志写入文件 (调用方需持有 m_mutex)
      * @param logLine 格式化后的日志行
      */
     void writeToFile(const QString& logLine);
     
+    /**
+     * @brief 写入线程主循环: 按刷新间隔或被唤醒时批量写入
+     */
+    void writerLoop();
+    
+    /**
+     * @brief 取出队列中的全部记录并批量写入 (只能由当前唯一的消费者调用)
+     */
+    void drainQueue();
+    
     /**
      * @brief 格式化上下文信息为字符串
      * @param context 上下文映射
@@ -218,11 +309,29 @@ private:
     // ========================================
     static Logger* s_instance;           ///< 单例实例指针
     
-    LogLevel m_logLevel{LogLevel::Info}; ///< 当前日志级别
+    static inline std::atomic<LogLevel> s_logLevel{LogLevel::Info}; ///< 当前日志级别 (单例共享, 宏中无锁读取)
     bool m_fileLoggingEnabled{false};    ///< 是否启用文件日志
     QString m_logFilePath;               ///< 日志文件路径
-    QMutex m_mutex;                      ///< 互斥锁,保证线程安全
+    QMutex m_mutex;                      ///< 互斥锁,保护日志文件和输出
     QFile m_logFile;                     ///< 日志文件对象
+    
+    // 异步模式
+    std::atomic<bool> m_asyncEnabled{false};                ///< 是否启用异步日志
+    std::atomic<int> m_flushIntervalMs{100};                ///< 写入线程最长等待时间
+    std::unique_ptr<MpscRingBuffer<LogRecord>> m_queue;     ///< 日志记录队列 (首次启用时创建)
+    std::unique_ptr<QThread> m_writerThread;                ///< 后台写入线程
+    QMutex m_controlMutex;                                  ///< 串行化启停和 flush
+    QMutex m_writerMutex;                                   ///< 配合条件变量使用
+    QWaitCondition m_writerWakeup;                          ///< 唤醒写入线程
+    QWaitCondition m_batchWritten;                          ///< 写入线程完成一批
+    bool m_writerStopping{false};                           ///< 写入线程退出标志 (m_writerMutex 保护)
+    bool m_writerWakeupPending{false};                      ///< 有未处理的提前唤醒 (m_writerMutex 保护)
+    std::atomic<quint64> m_enqueuedCount{0};                ///< 已入队记录数
+    std::atomic<quint64> m_writtenCount{0};                 ///< 已写入记录数
+    std::atomic<quint64> m_droppedCount{0};                 ///< 队列满时丢弃的记录数
+    std::atomic<int> m_activeProducers{0};                  ///< 正在入队的 log() 调用数 (关闭异步时等待归零)
+    
+    static constexpr std::size_t AsyncQueueCapacity = 8192; ///< 异步队列容量
 };
 
 /**
@@ -232,12 +341,46 @@ private:
  *   LOG_DEBUG("Network", "Connection established");
  *   LOG_INFO("Application", "Starting up...");
  *   LOG_WARNING("Database", "Connection timeout, retrying...");
- *   LOG_ERROR("FileSystem", "Failed to open file");
+ *   LOG_ERROR("FileSystem", "Failed to open file", {{"path", path}});
+ * 
+ * 开销说明:
+ *   - 低于编译期最低级别 (SPLITPANEL_LOG_MIN_LEVEL) 的宏展开为空语句
+ *   - 其余宏先做 Logger::isLevelEnabled() 判断, 通过后才构造消息和上下文参数,
+ *     因此 QString("...%1").arg(...) 这类参数在级别被过滤时不会被求值
+ *   - 上下文参数可直接写花括号初始化列表 (宏使用可变参数, 其中的逗号不影响展开)
  */
-#define LOG_DEBUG(category, message)   Logger::instance()->debug(category, message)
-#define LOG_INFO(category, message)    Logger::instance()->info(category, message)
-#define LOG_WARNING(category, message) Logger::instance()->warning(category, message)
-#define LOG_ERROR(category, message)   Logger::instance()->error(category, message)
+#define SPLITPANEL_LOG_IF(level, method, category, ...)                     \
+    do {                                                                    \
+        if (Logger::isLevelEnabled(level)) {                                \
+            Logger::instance()->method(category, __VA_ARGS__);              \
+        }                                                                   \
+    } while (false)
+
+#define SPLITPANEL_LOG_DISABLED() do {} while (false)
+
+#if SPLITPANEL_LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG(category, ...)   SPLITPANEL_LOG_IF(Logger::LogLevel::Debug, debug, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...)   SPLITPANEL_LOG_DISABLED()
+#endif
+
+#if SPLITPANEL_LOG_MIN_LEVEL <= 1
+#define LOG_INFO(category, ...)    SPLITPANEL_LOG_IF(Logger::LogLevel::Info, info, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...)    SPLITPANEL_LOG_DISABLED()
+#endif
+
+#if SPLITPANEL_LOG_MIN_LEVEL <= 2
+#define LOG_WARNING(category, ...) SPLITPANEL_LOG_IF(Logger::LogLevel::Warning, warning, category, __VA_ARGS__)
+#else
+#define LOG_WARNING(category, ...) SPLITPANEL_LOG_DISABLED()
+#endif
+
+#if SPLITPANEL_LOG_MIN_LEVEL <= 3
+#define LOG_ERROR(category, ...)   SPLITPANEL_LOG_IF(Logger::LogLevel::Error, error, category, __VA_ARGS__)
+#else
+#define LOG_ERROR(category, ...)   SPLITPANEL_LOG_DISABLED()
+#endif
 
 #endif // LOGGER_HPP
 
@@ -0,0 +1,141 @@
+#ifndef MPSC_RING_BUFFER_HPP
+#define MPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief 有界无锁多生产者单消费者环形队列
+ *
+ * 功能说明:
+ * - 任意线程可并发调用 tryPush() (多生产者)
+ * - 只允许一个线程调用 tryPop() (单消费者, 如日志写入线程)
+ * - 容量固定, 构造时向上取整为2的幂; 队列满时 tryPush() 返回 false, 绝不阻塞
+ *
+ * 实现说明:
+ * - 基于 Dmitry Vyukov 的有界 MPMC 队列, 每个槽位带一个序号
+ * - 生产者仅在入队位置上做一次 CAS, 槽位写完后以 release 语义发布序号
+ * - 消费者只有一个, 出队位置无需原子操作
+ * - 入队/出队位置分属不同缓存行, 避免伪共享
+ *
+ * 使用示例:
+ *   MpscRingBuffer<LogRecord> queue(4096);
+ *   queue.tryPush(std::move(record));   // 任意线程
+ *   while (queue.tryPop(record)) {...}  // 写入线程
+ */
+template<typename T>
+class MpscRingBuffer
+{
+public:
+    explicit MpscRingBuffer(std::size_t capacity)
+        : m_capacity(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity))
+        , m_mask(m_capacity - 1)
+        , m_cells(new Cell[m_capacity])
+    {
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    /**
+     * @brief 入队 (线程安全, 无锁)
+     * @param value 要入队的元素 (成功时被移走)
+     * @return bool true=成功, false=队列已满
+     */
+    bool tryPush(T&& value)
+    {
+        Cell* cell = nullptr;
+        std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                // 槽位空闲, 抢占入队位置
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // 槽位尚未被消费者释放: 队列已满
+                return false;
+            } else {
+                // 其他生产者已抢先, 重新读取入队位置
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 出队 (只能由唯一的消费者线程调用)
+     * @param out 输出元素
+     * @return bool true=成功, false=队列为空
+     */
+    bool tryPop(T& out)
+    {
+        Cell* cell = &m_cells[m_dequeuePos & m_mask];
+        const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(m_dequeuePos + 1);
+        if (diff < 0) {
+            return false;
+        }
+
+        out = std::move(cell->data);
+        cell->data = T();  // 立即释放槽位持有的资源 (如字符串缓冲区)
+        cell->sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+        ++m_dequeuePos;
+        m_dequeueCount.store(m_dequeuePos, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief 队列容量 (2的幂)
+     */
+    std::size_t capacity() const { return m_capacity; }
+
+    /**
+     * @brief 当前元素数量的近似值 (并发写入时仅供参考, 如判断是否需要唤醒消费者)
+     */
+    std::size_t sizeApprox() const
+    {
+        const std::size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+        const std::size_t dequeued = m_dequeueCount.load(std::memory_order_relaxed);
+        return enqueued >= dequeued ? enqueued - dequeued : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T data{};
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    static constexpr std::size_t CacheLineSize = 64;
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+
+    alignas(CacheLineSize) std::atomic<std::size_t> m_enqueuePos{0};  ///< 生产者共享
+    alignas(CacheLineSize) std::size_t m_dequeuePos{0};               ///< 仅消费者访问
+    std::atomic<std::size_t> m_dequeueCount{0};                       ///< 出队位置的只读镜像 (供 sizeApprox)
+};
+
+#endif // MPSC_RING_BUFFER_HPP
@@ -0,0 +1,183 @@
+/**
+ * @file SplitFrameScheduler.cpp
+ * @brief 按帧预算分片执行的协作式调度器实现
+ */
+
+#include "SplitFrameScheduler.hpp"
+#include "SplitProfiler.hpp"
+#include <QTimer>
+
+SplitFrameScheduler* SplitFrameScheduler::s_instance = nullptr;
+
+SplitFrameScheduler* SplitFrameScheduler::instance()
+{
+    // 与 Logger 相同：GUI 线程中第一次使用时创建，进程退出时不销毁
+    if (!s_instance) {
+        s_instance = new SplitFrameScheduler();
+    }
+    return s_instance;
+}
+
+// ============================================================================
+// 构造/析构
+// ============================================================================
+
+SplitFrameScheduler::SplitFrameScheduler(QObject* parent)
+    : QObject(parent)
+{
+    m_sliceTimer = new QTimer(this);
+    m_sliceTimer->setSingleShot(true);
+    m_sliceTimer->setInterval(0);
+    connect(m_sliceTimer, &QTimer::timeout, this, &SplitFrameScheduler::runSlice);
+}
+
+SplitFrameScheduler::~SplitFrameScheduler()
+{
+    if (s_instance == this) {
+        s_instance = nullptr;
+    }
+}
+
+// ============================================================================
+// 属性
+// ============================================================================
+
+void SplitFrameScheduler::setFrameBudget(int budgetMs)
+{
+    budgetMs = qMax(1, budgetMs);
+    if (m_frameBudget == budgetMs) return;
+    m_frameBudget = budgetMs;
+    emit frameBudgetChanged();
+}
+
+double SplitFrameScheduler::progress() const
+{
+    if (m_totalSteps <= 0) return isBusy() ? 0.0 : 1.0;
+    return qBound(0.0, double(m_completedSteps) / double(m_totalSteps), 1.0);
+}
+
+int SplitFrameScheduler::remainingBudget() const
+{
+    if (!m_sliceClock.isValid()) return m_frameBudget;
+    return int(qMax<qint64>(0, m_frameBudget - m_sliceClock.elapsed()));
+}
+
+// ============================================================================
+// 任务
+// ============================================================================
+
+void SplitFrameScheduler::post(QObject* context, Step step, int estimatedSteps)
+{
+    if (!step) return;
+
+    auto task = std::make_shared<Task>();
+    task->context = context ? context : this;
+    task->step = std::move(step);
+    task->estimatedSteps = qMax(1, estimatedSteps);
+
+    const bool wasIdle = m_tasks.isEmpty();
+    m_tasks.append(std::move(task));
+    m_totalSteps += qMax(1, estimatedSteps);
+    scheduleSlice();
+
+    if (wasIdle) {
+        emit busyChanged();
+    }
+    emit progressChanged();
+}
+
+void SplitFrameScheduler::cancel(QObject* context)
+{
+    const qsizetype before = m_tasks.size();
+    m_tasks.removeIf([this, context](const std::shared_ptr<Task>& task) {
+        if (task->context && task->context != context) return false;
+        // 未执行的估计步数从总数中扣除，进度不倒退
+        m_totalSteps -= qMax(0, task->estimatedSteps - task->steps);
+        return true;
+    });
+    if (m_tasks.size() == before) return;
+
+    emit progressChanged();
+    finishIfIdle();
+}
+
+void SplitFrameScheduler::flush()
+{
+    if (m_running || m_tasks.isEmpty()) return;
+
+    m_sliceTimer->stop();
+    while (!m_tasks.isEmpty()) {
+        runStep();
+    }
+    emit progressChanged();
+    finishIfIdle();
+}
+
+// ============================================================================
+// 执行
+// ============================================================================
+
+void SplitFrameScheduler::scheduleSlice()
+{
+    // 零间隔定时器：先让事件循环处理完已到达的输入和绘制请求，再执行下一片
+    if (!m_sliceTimer->isActive()) {
+        m_sliceTimer->start();
+    }
+}
+
+void SplitFrameScheduler::runSlice()
+{
+    if (m_tasks.isEmpty()) return;
+    SPLITPANEL_PROFILE_SCOPE(FrameSlice);
+
+    const qint64 budgetNs = qint64(m_frameBudget) * 1000000;
+    m_sliceClock.start();
+    // 至少执行一步：单步超过预算时也能推进
+    do {
+        runStep();
+    } while (!m_tasks.isEmpty() && m_sliceClock.nsecsElapsed() < budgetNs);
+    m_sliceClock.invalidate();
+
+    emit progressChanged();
+    if (!m_tasks.isEmpty()) {
+        scheduleSlice();
+    } else {
+        finishIfIdle();
+    }
+}
+
+void SplitFrameScheduler::runStep()
+{
+    if (m_tasks.isEmpty()) return;
+
+    // 持有一份引用：Step 中可能提交新任务或取消自己
+    std::shared_ptr<Task> task = m_tasks.first();
+    bool done = true;
+    if (task->context) {
+        m_running = true;
+        done = task->step();
+        m_running = false;
+    }
+    if (m_tasks.isEmpty() || m_tasks.first() != task) {
+        return;  // 执行期间被取消（计数已在 cancel 中处理）
+    }
+
+    if (++task->steps <= task->estimatedSteps) {
+        ++m_completedSteps;
+    }
+    if (done) {
+        m_completedSteps += qMax(0, task->estimatedSteps - task->steps);
+        m_tasks.removeOne(task);
+    }
+}
+
+void SplitFrameScheduler::finishIfIdle()
+{
+    if (!m_tasks.isEmpty()) return;
+
+    m_sliceTimer->stop();
+    m_totalSteps = 0;
+    m_completedSteps = 0;
+    emit busyChanged();
+    emit progressChanged();
+}
@@ -0,0 +1,137 @@
+#ifndef SPLIT_FRAME_SCHEDULER_HPP
+#define SPLIT_FRAME_SCHEDULER_HPP
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include <functional>
+#include <memory>
+
+class QTimer;
+
+/**
+ * ============================================================================
+ * SplitFrameScheduler - 按帧预算分片执行的协作式调度器（GUI 线程）
+ * ============================================================================
+ *
+ * 作用：
+ *   大的结构性操作（恢复几百个面板的布局、批量删除后的信号补发、面板内容孵化）
+ *   拆成许多小步，每次事件循环只执行不超过 frameBudget 毫秒，
+ *   两片之间事件循环照常处理输入和绘制，界面保持响应
+ *
+ * 任务：
+ *   一个任务是反复调用的一步（Step），返回 true 表示任务完成
+ *   任务按提交顺序执行，前一个完成后才开始下一个
+ *   每一步之后检查一次时钟，单步应远小于预算（如创建一个节点、发送一条信号）
+ *
+ * 进度：
+ *   提交时给出任务的估计步数，progress = 已完成步数 / 总步数（一直忙碌期间累计）
+ *   队列清空后计数归零
+ *
+ * 使用：
+ *   SplitFrameScheduler::instance()->post(this, [state]() { return state->step(); }, nodeCount);
+ *   QML：splitManager.scheduler.busy / progress / frameBudget
+ *
+ * 注意：
+ *   - 帧预算针对整个 GUI 线程，所有管理器和内容缓存共用 instance()
+ *   - 提交时的 context 对象销毁后，其任务直接丢弃（不再调用）
+ *   - flush() 同步执行完全部任务（退出前、测试和基准中使用）
+ */
+class SplitFrameScheduler : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int frameBudget READ frameBudget WRITE setFrameBudget NOTIFY frameBudgetChanged)
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(int pendingTasks READ pendingTasks NOTIFY progressChanged)
+
+public:
+    /**
+     * 一步工作：返回 true 表示任务已完成
+     */
+    using Step = std::function<bool()>;
+
+    static constexpr int DefaultFrameBudget = 4;
+
+    /**
+     * GUI 线程共用的调度器（第一次调用时创建）
+     */
+    static SplitFrameScheduler* instance();
+
+    explicit SplitFrameScheduler(QObject* parent = nullptr);
+    ~SplitFrameScheduler() override;
+
+    /**
+     * 每片的时间预算（毫秒，最小 1）
+     */
+    int frameBudget() const { return m_frameBudget; }
+    void setFrameBudget(int budgetMs);
+
+    bool isBusy() const { return !m_tasks.isEmpty(); }
+    double progress() const;
+    int pendingTasks() const { return int(m_tasks.size()); }
+
+    /**
+     * 提交任务（在下一次事件循环中开始执行）
+     * 参数：
+     *   context - 任务的所属对象，销毁后任务被丢弃
+     *   step - 一步工作
+     *   estimatedSteps - 估计步数（只用于进度）
+     */
+    void post(QObject* context, Step step, int estimatedSteps = 1);
+
+    /**
+     * 丢弃 context 提交的全部任务
+     */
+    void cancel(QObject* context);
+
+    /**
+     * 当前片剩余的预算（毫秒，片外为 frameBudget）
+     */
+    int remainingBudget() const;
+
+    /**
+     * 同步执行完全部任务
+     */
+    Q_INVOKABLE void flush();
+
+signals:
+    void frameBudgetChanged();
+    void busyChanged();
+    void progressChanged();
+
+private:
+    struct Task {
+        QPointer<QObject> context;
+        Step step;
+        int estimatedSteps = 1;
+        int steps = 0;
+    };
+
+    /**
+     * 执行一片（不超过 frameBudget），还有任务时安排下一片
+     */
+    void runSlice();
+
+    /**
+     * 执行当前任务的一步，任务完成或被丢弃时出队
+     */
+    void runStep();
+    void scheduleSlice();
+    void finishIfIdle();
+
+    static SplitFrameScheduler* s_instance;
+
+    // 待执行任务（队首为当前任务）；shared_ptr 使一步执行期间提交或取消任务不影响正在执行的 Step
+    QVector<std::shared_ptr<Task>> m_tasks;
+    QTimer* m_sliceTimer = nullptr;       // 下一片（零间隔单次）
+    QElapsedTimer m_sliceClock;           // 当前片开始时间（片外无效）
+    int m_frameBudget = DefaultFrameBudget;
+    qint64 m_totalSteps = 0;              // 本次忙碌期间提交的估计步数
+    qint64 m_completedSteps = 0;          // 本次忙碌期间已完成的步数
+    bool m_running = false;               // 正在执行一步（防止 flush 重入）
+};
+
+#endif // SPLIT_FRAME_SCHEDULER_HPP
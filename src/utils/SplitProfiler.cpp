@@ -0,0 +1,269 @@
+#include "SplitProfiler.hpp"
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <utility>
+
+namespace {
+
+struct SectionStats {
+    quint64 calls = 0;
+    qint64 totalNs = 0;
+    qint64 maxNs = 0;
+};
+
+struct TraceEvent {
+    qint64 startNs = 0;
+    qint64 durationNs = 0;
+    int thread = 0;
+    SplitProfiler::Section section = SplitProfiler::InsertPanel;
+};
+
+/**
+ * 全部统计状态（计数器用原子量，其余由 mutex 保护）
+ */
+struct ProfilerState {
+    QMutex mutex;
+    std::array<SectionStats, SplitProfiler::SectionCount> sections{};
+    std::array<std::atomic<quint64>, SplitProfiler::CounterCount> counters{};
+    QHash<QString, quint64> nodeSignals;
+    QVector<TraceEvent> trace;
+    quint64 droppedTraceEvents = 0;
+    QHash<Qt::HANDLE, int> threads;     // 线程 → trace 中的 tid（从 1 开始）
+    qint64 epochNs = 0;                 // trace 时间零点（开启 trace 时设置）
+};
+
+ProfilerState& state()
+{
+    static ProfilerState instance;
+    return instance;
+}
+
+} // namespace
+
+// ============================================================================
+// 开关
+// ============================================================================
+
+void SplitProfiler::setEnabled(bool enabled)
+{
+#if SPLITPANEL_PROFILING
+    s_enabled.store(enabled, std::memory_order_relaxed);
+#else
+    Q_UNUSED(enabled)
+#endif
+}
+
+void SplitProfiler::setTraceEnabled(bool enabled)
+{
+    if (enabled && !s_traceEnabled.load(std::memory_order_relaxed)) {
+        ProfilerState& s = state();
+        QMutexLocker locker(&s.mutex);
+        if (s.trace.isEmpty()) {
+            s.epochNs = nowNs();
+        }
+    }
+    s_traceEnabled.store(enabled, std::memory_order_relaxed);
+    if (enabled) {
+        setEnabled(true);
+    }
+}
+
+qint64 SplitProfiler::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ============================================================================
+// 记录
+// ============================================================================
+
+void SplitProfiler::addSample(Section section, qint64 startNs, qint64 durationNs)
+{
+    if (section >= SectionCount) return;
+
+    ProfilerState& s = state();
+    QMutexLocker locker(&s.mutex);
+
+    SectionStats& entry = s.sections[section];
+    ++entry.calls;
+    entry.totalNs += durationNs;
+    entry.maxNs = qMax(entry.maxNs, durationNs);
+
+    if (!isTraceEnabled()) return;
+    if (s.trace.size() >= MaxTraceEvents) {
+        ++s.droppedTraceEvents;
+        return;
+    }
+
+    const Qt::HANDLE thread = QThread::currentThreadId();
+    auto it = s.threads.find(thread);
+    if (it == s.threads.end()) {
+        it = s.threads.insert(thread, int(s.threads.size()) + 1);
+    }
+    s.trace.append(TraceEvent{startNs, durationNs, it.value(), section});
+}
+
+void SplitProfiler::count(Counter counter, quint64 n)
+{
+    if (counter >= CounterCount) return;
+    state().counters[counter].fetch_add(n, std::memory_order_relaxed);
+}
+
+void SplitProfiler::countNodeSignals(const QString& nodeId, int n)
+{
+    if (n <= 0) return;
+
+    ProfilerState& s = state();
+    s.counters[NodeSignals].fetch_add(quint64(n), std::memory_order_relaxed);
+
+    QMutexLocker locker(&s.mutex);
+    s.nodeSignals[nodeId] += quint64(n);
+}
+
+// ============================================================================
+// 汇总
+// ============================================================================
+
+const char* SplitProfiler::sectionName(Section section)
+{
+    switch (section) {
+    case InsertPanel:         return "insertPanelAt";
+    case RemovePanel:         return "removePanel";
+    case LoadLayout:          return "loadLayout";
+    case ApplyLayout:         return "applyLayout";
+    case SaveLayoutToFile:    return "saveLayoutToFile";
+    case SaveLayoutWrite:     return "saveLayoutAsync.write";
+    case FrameSlice:          return "frameScheduler.slice";
+    case SolveLayout:         return "layoutSolver.solve";
+    case CompactLoadedTree:   return "compactLoadedTree";
+    case SectionCount:        break;
+    }
+    return "unknown";
+}
+
+const char* SplitProfiler::counterName(Counter counter)
+{
+    switch (counter) {
+    case NodeSignals:       return "nodeSignals";
+    case DelegateCreated:   return "delegatesCreated";
+    case DelegateDestroyed: return "delegatesDestroyed";
+    case DelegateLoaded:    return "delegatesLoaded";
+    case CounterCount:      break;
+    }
+    return "unknown";
+}
+
+QVariantMap SplitProfiler::stats()
+{
+    ProfilerState& s = state();
+    QVariantMap result;
+    result["enabled"] = isEnabled();
+    result["traceEnabled"] = isTraceEnabled();
+
+    QVariantMap counters;
+    for (int i = 0; i < CounterCount; ++i) {
+        counters[counterName(Counter(i))] = s.counters[i].load(std::memory_order_relaxed);
+    }
+    counters["delegatesAlive"] = qint64(s.counters[DelegateCreated].load(std::memory_order_relaxed))
+                                 - qint64(s.counters[DelegateDestroyed].load(std::memory_order_relaxed));
+    result["counters"] = counters;
+
+    QMutexLocker locker(&s.mutex);
+
+    QVariantMap sections;
+    for (int i = 0; i < SectionCount; ++i) {
+        const SectionStats& section = s.sections[i];
+        if (section.calls == 0) continue;
+        sections[sectionName(Section(i))] = QVariantMap{
+            {"calls", section.calls},
+            {"totalMs", section.totalNs / 1e6},
+            {"avgMs", section.totalNs / 1e6 / double(section.calls)},
+            {"maxMs", section.maxNs / 1e6}
+        };
+    }
+    result["sections"] = sections;
+
+    // 只列出信号最多的节点（信号风暴通常集中在少数容器上）
+    QVector<QPair<QString, quint64>> nodes;
+    nodes.reserve(s.nodeSignals.size());
+    for (auto it = s.nodeSignals.cbegin(); it != s.nodeSignals.cend(); ++it) {
+        nodes.append({it.key(), it.value()});
+    }
+    const int top = qMin(int(nodes.size()), TopNodeCount);
+    std::partial_sort(nodes.begin(), nodes.begin() + top, nodes.end(),
+                      [](const auto& a, const auto& b) { return a.second > b.second; });
+    QVariantMap nodeSignals;
+    for (int i = 0; i < top; ++i) {
+        nodeSignals[nodes[i].first] = nodes[i].second;
+    }
+    result["nodeSignals"] = nodeSignals;
+
+    result["traceEvents"] = int(s.trace.size());
+    result["droppedTraceEvents"] = s.droppedTraceEvents;
+    return result;
+}
+
+void SplitProfiler::reset()
+{
+    ProfilerState& s = state();
+    for (auto& counter : s.counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+
+    QMutexLocker locker(&s.mutex);
+    s.sections.fill(SectionStats());
+    s.nodeSignals.clear();
+    s.trace.clear();
+    s.droppedTraceEvents = 0;
+    s.epochNs = nowNs();
+}
+
+// ============================================================================
+// Chrome trace 导出
+// ============================================================================
+
+QByteArray SplitProfiler::traceJson()
+{
+    ProfilerState& s = state();
+    QMutexLocker locker(&s.mutex);
+
+    QJsonArray events;
+    for (const TraceEvent& event : std::as_const(s.trace)) {
+        events.append(QJsonObject{
+            {"name", sectionName(event.section)},
+            {"cat", "SplitPanel"},
+            {"ph", "X"},
+            {"ts", (event.startNs - s.epochNs) / 1000.0},
+            {"dur", event.durationNs / 1000.0},
+            {"pid", 1},
+            {"tid", event.thread}
+        });
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+    root["otherData"] = QJsonObject{{"droppedEvents", qint64(s.droppedTraceEvents)}};
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool SplitProfiler::writeTrace(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const QByteArray data = traceJson();
+    return file.write(data) == data.size();
+}
@@ -0,0 +1,182 @@
+#ifndef SPLIT_PROFILER_HPP
+#define SPLIT_PROFILER_HPP
+
+#include <QByteArray>
+#include <QString>
+#include <QVariantMap>
+#include <atomic>
+
+/**
+ * 编译期开关：由 CMake 选项 SPLITPANEL_ENABLE_PROFILING 设置（0 = 关闭）
+ * 关闭时 SPLITPANEL_PROFILE_* 宏展开为空语句，热路径中不留任何代码
+ */
+#ifndef SPLITPANEL_PROFILING
+#define SPLITPANEL_PROFILING 1
+#endif
+
+/**
+ * ============================================================================
+ * SplitProfiler - 热路径计时与计数（进程级，线程安全）
+ * ============================================================================
+ *
+ * 作用：
+ *   区分变慢的来源：C++ 树修改（各区段耗时）、信号风暴（每个容器发出的信号数）、
+ *   QML 重建（委托创建/销毁数）
+ *
+ * 用法：
+ *   SPLITPANEL_PROFILE_SCOPE(InsertPanel);                  // 区段计时（作用域结束时记录）
+ *   SPLITPANEL_PROFILE_COUNT(DelegateCreated);              // 计数
+ *   SPLITPANEL_PROFILE_NODE_SIGNALS(nodeId(), 2);           // 按节点统计信号数
+ *
+ *   SplitProfiler::setEnabled(true);                        // 开始统计
+ *   SplitProfiler::setTraceEnabled(true);                   // 同时记录 Chrome trace 事件
+ *   SplitProfiler::stats();                                 // 汇总（QVariantMap）
+ *   SplitProfiler::writeTrace(path);                        // chrome://tracing / Perfetto 可直接打开
+ *
+ * 开销：
+ *   - 编译期关闭：零开销
+ *   - 运行时关闭（默认）：每个宏一次 relaxed 原子读取和一次分支，不取时间、不加锁
+ *   - 开启：区段结束时加锁累加；trace 事件数超过 MaxTraceEvents 后只计数不再记录
+ */
+class SplitProfiler {
+public:
+    /**
+     * 计时区段
+     */
+    enum Section {
+        InsertPanel,            // SplitManager::insertPanelAt
+        RemovePanel,            // SplitManager::removePanel
+        LoadLayout,             // SplitManager::loadLayout
+        ApplyLayout,            // SplitManager::applyLayout
+        SaveLayoutToFile,       // SplitManager::saveLayoutToFile
+        SaveLayoutWrite,        // saveLayoutAsync 工作线程中的编码和写文件
+        FrameSlice,             // SplitFrameScheduler 的一片（不超过 frameBudget）
+        SolveLayout,            // SplitManager::updateGeometry / setViewportSize（SplitLayoutSolver）
+        CompactLoadedTree,      // SplitManager::compactLoadedTree（加载时的压缩和校验）
+        SectionCount
+    };
+
+    /**
+     * 计数器
+     */
+    enum Counter {
+        NodeSignals,            // 节点发出的信号总数
+        DelegateCreated,        // 节点委托创建（SplitNodeRenderer、SplitContainerView 的子节点 Loader）
+        DelegateDestroyed,      // 节点委托销毁
+        DelegateLoaded,         // 节点委托加载了新的视图组件（面板宿主/容器视图）
+        CounterCount
+    };
+
+    /**
+     * trace 事件数上限（约 40 字节/事件）
+     */
+    static constexpr int MaxTraceEvents = 200000;
+
+    static bool isEnabled() {
+#if SPLITPANEL_PROFILING
+        return s_enabled.load(std::memory_order_relaxed);
+#else
+        return false;
+#endif
+    }
+    static void setEnabled(bool enabled);
+
+    static bool isTraceEnabled() { return isEnabled() && s_traceEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * 开启 trace 时同时开启统计
+     */
+    static void setTraceEnabled(bool enabled);
+
+    /**
+     * 记录一次区段耗时（纳秒，startNs 为 nowNs() 的返回值）
+     */
+    static void addSample(Section section, qint64 startNs, qint64 durationNs);
+
+    static void count(Counter counter, quint64 n = 1);
+    static void countNodeSignals(const QString& nodeId, int n);
+
+    /**
+     * 单调时钟（纳秒）
+     */
+    static qint64 nowNs();
+
+    /**
+     * 汇总：
+     *   enabled / traceEnabled
+     *   sections    - { 区段名: { calls, totalMs, avgMs, maxMs } }（只含调用过的区段）
+     *   counters    - { 计数器名: 值 }，另有 delegatesAlive = created - destroyed
+     *   nodeSignals - { 节点 ID: 信号数 }，按信号数统计的前 TopNodeCount 个
+     *   traceEvents / droppedTraceEvents
+     */
+    static QVariantMap stats();
+
+    /**
+     * 清空统计和 trace 事件（开关状态不变）
+     */
+    static void reset();
+
+    /**
+     * Chrome trace（JSON trace event 格式，"X" 完整事件，时间单位微秒）
+     */
+    static QByteArray traceJson();
+    static bool writeTrace(const QString& filePath);
+
+    static const char* sectionName(Section section);
+    static const char* counterName(Counter counter);
+
+    /**
+     * 每个节点的信号统计在 stats() 中最多列出的数量
+     */
+    static constexpr int TopNodeCount = 32;
+
+    /**
+     * 区段计时器：构造时未开启统计则什么都不做
+     */
+    class Scope {
+    public:
+        explicit Scope(Section section)
+            : m_section(section), m_start(SplitProfiler::isEnabled() ? SplitProfiler::nowNs() : -1) {}
+        ~Scope() {
+            if (m_start >= 0) {
+                SplitProfiler::addSample(m_section, m_start, SplitProfiler::nowNs() - m_start);
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Section m_section;
+        qint64 m_start;
+    };
+
+private:
+    static inline std::atomic<bool> s_enabled{false};
+    static inline std::atomic<bool> s_traceEnabled{false};
+};
+
+#define SPLITPANEL_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SPLITPANEL_PROFILE_CONCAT(a, b) SPLITPANEL_PROFILE_CONCAT_IMPL(a, b)
+
+#if SPLITPANEL_PROFILING
+#define SPLITPANEL_PROFILE_SCOPE(section) \
+    SplitProfiler::Scope SPLITPANEL_PROFILE_CONCAT(splitProfileScope_, __LINE__)(SplitProfiler::section)
+#define SPLITPANEL_PROFILE_COUNT(counter)                                   \
+    do {                                                                    \
+        if (SplitProfiler::isEnabled()) {                                   \
+            SplitProfiler::count(SplitProfiler::counter);                   \
+        }                                                                   \
+    } while (false)
+#define SPLITPANEL_PROFILE_NODE_SIGNALS(nodeId, n)                          \
+    do {                                                                    \
+        if (SplitProfiler::isEnabled()) {                                   \
+            SplitProfiler::countNodeSignals(nodeId, n);                     \
+        }                                                                   \
+    } while (false)
+#else
+#define SPLITPANEL_PROFILE_SCOPE(section) do {} while (false)
+#define SPLITPANEL_PROFILE_COUNT(counter) do {} while (false)
+#define SPLITPANEL_PROFILE_NODE_SIGNALS(nodeId, n) do {} while (false)
+#endif
+
+#endif // SPLIT_PROFILER_HPP
@@ -0,0 +1,151 @@
+/**
+ * @file SplitPanelTests.cpp
+ * @brief 布局引擎回归测试（Qt Test）
+ *
+ * 覆盖：
+ *   - SplitLayoutStore 缩略图的排列方向（与 SplitLayoutSolver 一致）
+ *   - 加载时压缩：只剩空容器的布局得到空树，之后可以正常添加面板
+ *   - moveNode 插入失败时子树放回原位置（节点仍在索引和树中）
+ *   - 撤销分离窗口中的删除：面板回到原来的窗口，主窗口不受影响
+ *
+ * 运行：
+ *   cmake -DSPLITPANEL_BUILD_TESTS=ON ..
+ *   cmake --build . --target SplitPanelTests
+ *   ctest --output-on-failure
+ */
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include "SplitLayoutStore.hpp"
+#include "SplitManager.hpp"
+
+class SplitPanelTests : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // 预设库
+    void layoutStoreThumbnailSideBySide();
+
+    // 加载
+    void loadEmptyRootContainer();
+
+    // 多窗口
+    void moveNodeFailureRestoresSubtree();
+    void undoRemoveInDetachedWindow();
+
+private:
+    QTemporaryDir m_tempDir;
+};
+
+void SplitPanelTests::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+}
+
+// ============================================================================
+// 预设库
+// ============================================================================
+
+void SplitPanelTests::layoutStoreThumbnailSideBySide()
+{
+    // 向右插入得到 Vertical 容器：两个面板左右排列
+    SplitManager manager;
+    QVERIFY(manager.addPanel("left", "Left"));
+    QVERIFY(manager.addPanelAt("right", "Right", QString(), "left", SplitManager::Right));
+    const auto* container = qobject_cast<ContainerNode*>(manager.rootNode());
+    QVERIFY(container);
+    QCOMPARE(container->orientation(), ContainerNode::Vertical);
+
+    SplitLayoutStore store;
+    store.open(m_tempDir.filePath("thumbnail.splstore"));
+    QVERIFY(store.save("split", &manager));
+
+    const QVariantList thumbnail = store.preset("split").value("thumbnail").toList();
+    QCOMPARE(thumbnail.size(), 2);
+    const QVariantMap first = thumbnail[0].toMap();
+    const QVariantMap second = thumbnail[1].toMap();
+    QCOMPARE(first.value("y").toDouble(), second.value("y").toDouble());
+    QVERIFY(first.value("x").toDouble() < second.value("x").toDouble());
+    QCOMPARE(first.value("height").toDouble(), 1.0);
+}
+
+// ============================================================================
+// 加载
+// ============================================================================
+
+void SplitPanelTests::loadEmptyRootContainer()
+{
+    SplitManager manager;
+    const QVariantMap layout{
+        {"version", SplitLayoutSerializer::LayoutVersion},
+        {"root", QVariantMap{
+            {"type", "container"},
+            {"id", "empty"},
+            {"children", QVariantList()}
+        }}
+    };
+    QVERIFY(manager.loadLayout(layout));
+    QVERIFY(!manager.rootNode());
+    QCOMPARE(manager.lastLoadReport().value("removedContainers").toInt(), 1);
+
+    // 空树走 addPanel 的根节点分支
+    QVERIFY(manager.addPanel("first", "First"));
+    QCOMPARE(manager.panelCount(), 1);
+    QVERIFY(manager.findPanel("first"));
+}
+
+// ============================================================================
+// 多窗口
+// ============================================================================
+
+void SplitPanelTests::moveNodeFailureRestoresSubtree()
+{
+    // 两个面板的容器：取下 left 后容器被 right 替换，放回时要按原 ID 重建
+    SplitManager manager;
+    QVERIFY(manager.addPanel("left", "Left"));
+    QVERIFY(manager.addPanelAt("right", "Right", QString(), "left", SplitManager::Right));
+    QVERIFY(manager.updateSizes(manager.rootNode()->nodeId(), {0.3, 0.7}));
+    const QVariantMap before = manager.saveLayout();
+
+    // 无效方向：insertPanelAt 失败
+    QVERIFY(!manager.moveNode("left", "right", 99));
+
+    QCOMPARE(manager.saveLayout(), before);
+    QCOMPARE(manager.panelCount(), 2);
+    PanelNode* left = manager.findPanel("left");
+    QVERIFY(left);
+    QCOMPARE(static_cast<SplitPanelNode*>(left->parentContainer()), manager.rootNode());
+    QCOMPARE(manager.windowOf("left"), QString());
+}
+
+void SplitPanelTests::undoRemoveInDetachedWindow()
+{
+    SplitManager manager;
+    QVERIFY(manager.addPanel("main", "Main"));
+    QVERIFY(manager.addPanelAt("b", "B", QString(), "main", SplitManager::Right));
+    const QString windowId = manager.detachNode("b");
+    QVERIFY(!windowId.isEmpty());
+    SplitPanelNode* mainRoot = manager.rootNode();
+
+    // 父容器是窗口的根：删除后兄弟节点成为窗口的根，撤销时在同一个窗口重建父容器
+    QVERIFY(manager.addPanelAt("c", "C", QString(), "b", SplitManager::Right));
+    QVERIFY(manager.removePanel("c"));
+    QVERIFY(manager.undo());
+    QCOMPARE(manager.windowOf("c"), windowId);
+    QCOMPARE(manager.rootNode(), mainRoot);
+
+    // 面板是窗口的根：删除时窗口关闭，撤销时以原 ID 重新打开
+    QVERIFY(manager.removePanel("c"));
+    QVERIFY(manager.removePanel("b"));
+    QVERIFY(manager.windowIds().isEmpty());
+    QVERIFY(manager.undo());
+    QCOMPARE(manager.windowOf("b"), windowId);
+    QCOMPARE(manager.rootNode(), mainRoot);
+    QCOMPARE(manager.panelCount(), 2);
+}
+
+QTEST_GUILESS_MAIN(SplitPanelTests)
+#include "SplitPanelTests.moc"